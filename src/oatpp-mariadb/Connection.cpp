@@ -1,7 +1,47 @@
 #include "Connection.hpp"
 
+#include <mysql/errmsg.h>
+
+#include <string>
+
 namespace oatpp { namespace mariadb {
 
+namespace {
+
+// The reset brings session variables back to server defaults - restore the connection character set and re-run
+// MYSQL_INIT_COMMANDs the client library only sends on connect. One multi-statement round trip.
+bool restoreSession(MYSQL* handle) {
+
+  std::string sql = std::string("SET NAMES ") + mysql_character_set_name(handle);
+
+  char** commands = nullptr;
+  unsigned int count = 0;
+  if (mysql_get_optionv(handle, MYSQL_INIT_COMMAND, &commands, &count) == 0 && commands) {
+    for (unsigned int i = 0; i < count; i++) {
+      sql += ";\n";
+      sql += commands[i];
+    }
+  }
+
+  if (mysql_real_query(handle, sql.data(), sql.size())) {
+    return false;
+  }
+
+  int status;
+  do {
+    MYSQL_RES* result = mysql_store_result(handle);
+    if (result) {
+      mysql_free_result(result);
+    }
+    status = mysql_next_result(handle);
+  } while (status == 0);
+
+  return status == -1;
+
+}
+
+}
+
 void Connection::setInvalidator(const std::shared_ptr<provider::Invalidator<Connection>>& invalidator) {
   m_invalidator = invalidator;
 }
@@ -10,11 +50,112 @@ std::shared_ptr<provider::Invalidator<Connection>> Connection::getInvalidator()
   return m_invalidator;
 }
 
-ConnectionImpl::ConnectionImpl(MYSQL* mysql)
+bool Connection::isInTransaction() {
+  MYSQL* handle = getHandle();
+  if (!handle) {
+    return false;
+  }
+  unsigned int serverStatus = 0;
+  if (mariadb_get_infov(handle, MARIADB_CONNECTION_SERVER_STATUS, &serverStatus)) {
+    return false;
+  }
+  return (serverStatus & SERVER_STATUS_IN_TRANS) != 0;
+}
+
+bool Connection::supportsBulkOperations() {
+  MYSQL* handle = getHandle();
+  if (!handle) {
+    return false;
+  }
+  // extended (MariaDB-specific) capabilities are reported without the 32-bit shift
+  unsigned long capabilities = 0;
+  if (mariadb_get_infov(handle, MARIADB_CONNECTION_EXTENDED_SERVER_CAPABILITIES, &capabilities)) {
+    return false;
+  }
+  return (capabilities & (MARIADB_CLIENT_STMT_BULK_OPERATIONS >> 32)) != 0;
+}
+
+v_uint64 Connection::getMaxAllowedPacket() {
+  MYSQL* handle = getHandle();
+  if (!handle) {
+    return 0;
+  }
+  unsigned long maxAllowedPacket = 0;
+  if (mysql_get_optionv(handle, MYSQL_OPT_MAX_ALLOWED_PACKET, &maxAllowedPacket)) {
+    return 0;
+  }
+  return maxAllowedPacket;
+}
+
+bool Connection::enableNonBlocking() {
+  MYSQL* handle = getHandle();
+  if (!handle) {
+    return false;
+  }
+  // setting the option again would replace the context - not allowed while a call is suspended on it
+  my_bool enabled = 0;
+  if (mysql_get_optionv(handle, MYSQL_OPT_NONBLOCK, &enabled) == 0 && enabled) {
+    return true;
+  }
+  return mysql_options(handle, MYSQL_OPT_NONBLOCK, 0) == 0;
+}
+
+bool Connection::needsSessionReset() {
+  return isSessionDirty() || isInTransaction();
+}
+
+bool Connection::resetSessionIfDirty() {
+  MYSQL* handle = getHandle();
+  if (!handle || !isHealthy() || isBusy()) {
+    return false;
+  }
+  if (!needsSessionReset()) {
+    return true;
+  }
+  // reset deallocates server-side statements - close cached ones while their ids are still valid
+  getStatementCache().clear();
+  if (mysql_reset_connection(handle) || !restoreSession(handle)) {
+    OATPP_LOGW("Connection", "Can't reset session: %s", mysql_error(handle));
+    reportError(mysql_errno(handle));
+    return false;
+  }
+  setSessionDirty(false);
+  return true;
+}
+
+bool Connection::reportError(unsigned int errorCode) {
+  switch (errorCode) {
+    case CR_SERVER_GONE_ERROR:
+    case CR_SERVER_LOST:
+    case CR_SERVER_LOST_EXTENDED:
+    case CR_CONNECTION_ERROR:
+    case CR_CONN_HOST_ERROR:
+      if (getHealth() == Health::HEALTHY) {
+        OATPP_LOGD("Connection", "Connection is broken. Error code: %u", errorCode);
+        setHealth(Health::BROKEN);
+      }
+      break;
+    default:
+      break;
+  }
+  return getHealth() != Health::HEALTHY;
+}
+
+bool Connection::isHealthy() {
+  return getHealth() == Health::HEALTHY;
+}
+
+ConnectionImpl::ConnectionImpl(MYSQL* mysql, v_uint32 statementCacheSize)
   : m_connection(mysql)
+  , m_statementCache(statementCacheSize)
+  , m_health(mysql ? Health::HEALTHY : Health::CLOSED)
+  , m_busy(false)
+  , m_sessionDirty(false)
 {}
 
 ConnectionImpl::~ConnectionImpl() {
+  // statements must be closed while the handle is still alive
+  m_statementCache.clear();
   if (m_connection) {
     mysql_close(m_connection);
     m_connection = nullptr;
@@ -25,4 +166,42 @@ MYSQL* ConnectionImpl::getHandle() {
   return m_connection;
 }
 
+void ConnectionImpl::setHandle(MYSQL* handle) {
+  if (handle != m_connection) {
+    m_statementCache.clear();
+  }
+  m_connection = handle;
+  m_health = handle ? Health::HEALTHY : Health::CLOSED;
+  m_busy = false;
+  m_sessionDirty = false;
+}
+
+StatementCache& ConnectionImpl::getStatementCache() {
+  return m_statementCache;
+}
+
+Connection::Health ConnectionImpl::getHealth() {
+  return m_health;
+}
+
+void ConnectionImpl::setHealth(Health health) {
+  m_health = health;
+}
+
+bool ConnectionImpl::isBusy() {
+  return m_busy;
+}
+
+void ConnectionImpl::setBusy(bool busy) {
+  m_busy = busy;
+}
+
+bool ConnectionImpl::isSessionDirty() {
+  return m_sessionDirty;
+}
+
+void ConnectionImpl::setSessionDirty(bool dirty) {
+  m_sessionDirty = dirty;
+}
+
 }}
\ No newline at end of file
@@ -1,6 +1,8 @@
 #ifndef oatpp_mariadb_Connection_hpp
 #define oatpp_mariadb_Connection_hpp
 
+#include "StatementCache.hpp"
+
 #include "oatpp/orm/Connection.hpp"
 #include "oatpp/core/provider/Pool.hpp"
 #include "oatpp/core/Types.hpp"
@@ -10,6 +12,32 @@
 namespace oatpp { namespace mariadb {
 
 class Connection : public oatpp::orm::Connection {
+public:
+
+  /**
+   * Connection health state. <br>
+   * `HEALTHY` -> `BROKEN` when the client library reports that the server is gone,
+   * `HEALTHY`/`BROKEN` -> `CLOSED` when the native handle is closed.
+   */
+  enum class Health : v_int32 {
+
+    /**
+     * Connection is usable.
+     */
+    HEALTHY = 0,
+
+    /**
+     * Connection to the server was lost. It must not be returned to the pool.
+     */
+    BROKEN = 1,
+
+    /**
+     * Native handle is closed.
+     */
+    CLOSED = 2
+
+  };
+
 private:
   std::shared_ptr<provider::Invalidator<Connection>> m_invalidator;
 public:
@@ -21,6 +49,110 @@ public:
   virtual MYSQL* getHandle() = 0;
   virtual void setHandle(MYSQL* handle) = 0;
 
+  /**
+   * Get cache of prepared statements bound to this connection.
+   * @return - &id:oatpp::mariadb::StatementCache;.
+   */
+  virtual StatementCache& getStatementCache() = 0;
+
+  /**
+   * Check if a transaction is active on this connection.
+   * Uses the server status flags received with the last server response, so no round trip is made.
+   * @return - `true` if the server reported `SERVER_STATUS_IN_TRANS`.
+   */
+  bool isInTransaction();
+
+  /**
+   * Check if the server supports MariaDB bulk operations (array binding with `STMT_ATTR_ARRAY_SIZE`).
+   * Uses capabilities received during the handshake, so no round trip is made.
+   * @return - `true` if the server announced `MARIADB_CLIENT_STMT_BULK_OPERATIONS`.
+   */
+  bool supportsBulkOperations();
+
+  /**
+   * Get client-side `max_allowed_packet` of this connection.
+   * @return - maximum packet size in bytes. `0` if the connection is closed.
+   */
+  v_uint64 getMaxAllowedPacket();
+
+  /**
+   * Enable the Connector/C non-blocking API (`MYSQL_OPT_NONBLOCK`) on this connection if it's not enabled yet.
+   * Allocates the context `_start/_cont` calls run on, so it's done on first async use only -
+   * connections used by blocking calls alone don't pay for it. Blocking calls keep working afterwards.
+   * @return - `false` if the connection is closed or the option can't be set.
+   */
+  bool enableNonBlocking();
+
+  /**
+   * Get connection health state.
+   * @return - &l:Connection::Health;.
+   */
+  virtual Health getHealth() = 0;
+
+  /**
+   * Set connection health state.
+   * @param health - &l:Connection::Health;.
+   */
+  virtual void setHealth(Health health) = 0;
+
+  /**
+   * Check if a result is still being read on this connection - rows of an unbuffered (streaming) result or results
+   * of the remaining statements of a multi-statement query.
+   * No other command can be sent until they are drained or discarded.
+   * @return
+   */
+  virtual bool isBusy() = 0;
+
+  /**
+   * Mark the connection busy with an unbuffered result or pending results of a multi-statement query.
+   * @param busy
+   */
+  virtual void setBusy(bool busy) = 0;
+
+  /**
+   * Check if a statement executed on this connection may have left session state behind -
+   * user variables, temporary tables, session variables, table or named locks.
+   * @return
+   */
+  virtual bool isSessionDirty() = 0;
+
+  /**
+   * Mark session state changed. Set by &id:oatpp::mariadb::Executor; for statements detected by
+   * &id:oatpp::mariadb::ql_template::Parser::changesSession;.
+   * @param dirty
+   */
+  virtual void setSessionDirty(bool dirty) = 0;
+
+  /**
+   * Check if the session must be reset before the connection is reused - it's dirty or a transaction was left open.
+   * Purely local, no round trip is made.
+   * @return
+   */
+  bool needsSessionReset();
+
+  /**
+   * Prepare the connection for its next user. If the session is dirty or a transaction was left open,
+   * runs `mysql_reset_connection` (`COM_RESET_CONNECTION`) instead of a reconnect, then restores the character set and
+   * `MYSQL_INIT_COMMAND`s of &id:oatpp::mariadb::ConnectionOptions; in one more round trip. The server drops
+   * prepared statements on reset, so the statement cache is cleared first. A clean session is left as is.
+   * @return - `false` if the connection is not healthy or the reset failed - the connection must not be reused.
+   */
+  bool resetSessionIfDirty();
+
+  /**
+   * Update health state from a client error code seen during prepare, execute or fetch.
+   * `CR_SERVER_GONE_ERROR`, `CR_SERVER_LOST` and other connection-level errors mark the connection `BROKEN`.
+   * @param errorCode - `mysql_errno` / `mysql_stmt_errno` value.
+   * @return - `true` if the connection is broken.
+   */
+  bool reportError(unsigned int errorCode);
+
+  /**
+   * Check if the connection is `HEALTHY`. Purely local, no round trip is made.
+   * @return
+   */
+  bool isHealthy();
+
   void setInvalidator(const std::shared_ptr<provider::Invalidator<Connection>>& invalidator);
   std::shared_ptr<provider::Invalidator<Connection>> getInvalidator();
 
@@ -29,17 +161,33 @@ public:
 class ConnectionImpl : public Connection {
 private:
   MYSQL* m_connection;
+  StatementCache m_statementCache;
+  Health m_health;
+  bool m_busy;
+  bool m_sessionDirty;
 
 public:
 
-  ConnectionImpl(MYSQL* connection);
+  ConnectionImpl(MYSQL* connection, v_uint32 statementCacheSize = StatementCache::DEFAULT_CAPACITY);
   ~ConnectionImpl();
 
   MYSQL* getHandle() override;
-  
-  void setHandle(MYSQL* handle) override {
-    m_connection = handle;
-  }
+
+  void setHandle(MYSQL* handle) override;
+
+  StatementCache& getStatementCache() override;
+
+  Health getHealth() override;
+
+  void setHealth(Health health) override;
+
+  bool isBusy() override;
+
+  void setBusy(bool busy) override;
+
+  bool isSessionDirty() override;
+
+  void setSessionDirty(bool dirty) override;
 
 };
 
@@ -49,6 +197,15 @@ struct ConnectionAcquisitionProxy : public provider::AcquisitionProxy<Connection
     : provider::AcquisitionProxy<Connection, ConnectionAcquisitionProxy>(resource, pool)
   {}
 
+  ~ConnectionAcquisitionProxy() {
+    // oatpp::provider::Pool takes the connection back right here and may hand it out on this thread - no room for a
+    // reset off the caller's thread. A dirty session is dropped instead of reset: closing doesn't wait for the server.
+    auto& object = this->_handle.object;
+    if (!object->isHealthy() || object->isBusy() || object->needsSessionReset()) {
+      this->__pool__invalidate();
+    }
+  }
+
   MYSQL* getHandle() override {
     return this->_handle.object->getHandle();
   }
@@ -56,6 +213,34 @@ struct ConnectionAcquisitionProxy : public provider::AcquisitionProxy<Connection
   void setHandle(MYSQL* handle) override {
     this->_handle.object->setHandle(handle);
   }
+
+  StatementCache& getStatementCache() override {
+    return this->_handle.object->getStatementCache();
+  }
+
+  Health getHealth() override {
+    return this->_handle.object->getHealth();
+  }
+
+  void setHealth(Health health) override {
+    this->_handle.object->setHealth(health);
+  }
+
+  bool isBusy() override {
+    return this->_handle.object->isBusy();
+  }
+
+  void setBusy(bool busy) override {
+    this->_handle.object->setBusy(busy);
+  }
+
+  bool isSessionDirty() override {
+    return this->_handle.object->isSessionDirty();
+  }
+
+  void setSessionDirty(bool dirty) override {
+    this->_handle.object->setSessionDirty(dirty);
+  }
 };
 
 }}
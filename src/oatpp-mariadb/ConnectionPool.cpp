@@ -0,0 +1,664 @@
+#include "ConnectionPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace oatpp { namespace mariadb {
+
+/*
+ * Connection handed out by the pool - returns the pooled connection when the last handle to it is released.
+ */
+class ConnectionPool::PooledConnection : public Connection {
+private:
+  std::shared_ptr<ConnectionPool> m_pool;
+  PoolConnection m_connection;
+  std::atomic<bool> m_valid;
+public:
+
+  PooledConnection(const std::shared_ptr<ConnectionPool>& pool, PoolConnection&& connection)
+    : m_pool(pool)
+    , m_connection(std::move(connection))
+    , m_valid(true)
+  {}
+
+  ~PooledConnection() override {
+    auto& object = m_connection.handle.object;
+    // a dirty session is reset by the maintainer - see ConnectionPool::release()
+    bool reusable = m_valid && object->isHealthy() && !object->isBusy();
+    m_pool->m_inUse.fetch_sub(1, std::memory_order_relaxed);
+    m_pool->release(std::move(m_connection), reusable);
+  }
+
+  void invalidate() {
+    m_valid = false;
+  }
+
+  MYSQL* getHandle() override {
+    return m_connection.handle.object->getHandle();
+  }
+
+  void setHandle(MYSQL* handle) override {
+    m_connection.handle.object->setHandle(handle);
+  }
+
+  StatementCache& getStatementCache() override {
+    return m_connection.handle.object->getStatementCache();
+  }
+
+  Health getHealth() override {
+    return m_connection.handle.object->getHealth();
+  }
+
+  void setHealth(Health health) override {
+    m_connection.handle.object->setHealth(health);
+  }
+
+  bool isBusy() override {
+    return m_connection.handle.object->isBusy();
+  }
+
+  void setBusy(bool busy) override {
+    m_connection.handle.object->setBusy(busy);
+  }
+
+  bool isSessionDirty() override {
+    return m_connection.handle.object->isSessionDirty();
+  }
+
+  void setSessionDirty(bool dirty) override {
+    m_connection.handle.object->setSessionDirty(dirty);
+  }
+
+};
+
+void ConnectionPool::PoolInvalidator::invalidate(const std::shared_ptr<Connection>& connection) {
+  // closed by the pool once the last handle is released
+  std::static_pointer_cast<PooledConnection>(connection)->invalidate();
+}
+
+ConnectionPool::ConnectionPool(const std::shared_ptr<provider::Provider<Connection>>& provider, const Config& config)
+  : m_provider(provider)
+  , m_config(config)
+  , m_invalidator(std::make_shared<PoolInvalidator>())
+  , m_size(0)
+  , m_running(true)
+  , m_random(std::random_device()())
+  , m_inUse(0)
+  , m_waiting(0)
+  , m_acquisitions(0)
+  , m_timeouts(0)
+  , m_creations(0)
+  , m_creationFailures(0)
+  , m_evictions(0)
+  , m_expirations(0)
+  , m_discards(0)
+{
+  if (m_config.maxConnections == 0) {
+    throw std::runtime_error("[oatpp::mariadb::ConnectionPool::ConnectionPool()]: Error. maxConnections must be greater than 0.");
+  }
+  m_config.minIdle = std::min(m_config.minIdle, m_config.maxConnections);
+  m_waitList.setListener(this);
+}
+
+ConnectionPool::~ConnectionPool() {
+  stop();
+}
+
+std::shared_ptr<ConnectionPool> ConnectionPool::createShared(const std::shared_ptr<provider::Provider<Connection>>& provider,
+                                                             const Config& config) {
+  auto pool = std::make_shared<ConnectionPool>(provider, config);
+  pool->fill(pool->m_config.connectParallelism);
+  // the thread doesn't own the pool - the destructor stops it
+  pool->m_maintainer = std::thread(&ConnectionPool::runMaintainer, pool.get());
+  return pool;
+}
+
+std::shared_ptr<ConnectionPool> ConnectionPool::createShared(const std::shared_ptr<provider::Provider<Connection>>& provider,
+                                                             v_uint32 maxConnections,
+                                                             const std::chrono::duration<v_int64, std::micro>& idleTimeout,
+                                                             const std::chrono::duration<v_int64, std::micro>& acquireTimeout) {
+  Config config;
+  config.maxConnections = maxConnections;
+  config.idleTimeout = std::chrono::duration_cast<std::chrono::milliseconds>(idleTimeout);
+  config.acquireTimeout = std::chrono::duration_cast<std::chrono::milliseconds>(acquireTimeout);
+  return createShared(provider, config);
+}
+
+// e.g. maxLifetime = 30min, lifetimeJitter = 0.1 -> expires 27..30 min after it was opened
+std::chrono::steady_clock::time_point ConnectionPool::getExpiresAt(std::chrono::steady_clock::time_point createdAt) {
+  if (m_config.maxLifetime.count() <= 0) {
+    return std::chrono::steady_clock::time_point::max();
+  }
+  auto lifetime = m_config.maxLifetime;
+  auto maxJitter = static_cast<std::chrono::milliseconds::rep>(lifetime.count() * std::max(0.0, std::min(m_config.lifetimeJitter, 1.0)));
+  if (maxJitter > 0) {
+    lifetime -= std::chrono::milliseconds(std::uniform_int_distribution<std::chrono::milliseconds::rep>(0, maxJitter)(m_random));
+  }
+  return createdAt + lifetime;
+}
+
+// an idle connection found expired or broken
+void ConnectionPool::retire(const PoolConnection& connection, std::chrono::steady_clock::time_point now,
+                            std::vector<provider::ResourceHandle<Connection>>& retired) {
+  if (connection.expiresAt <= now) {
+    m_expirations.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    m_discards.fetch_add(1, std::memory_order_relaxed);
+  }
+  retired.push_back(connection.handle);
+}
+
+// must be called with m_mutex locked
+bool ConnectionPool::takeIdle(PoolConnection& connection, std::vector<provider::ResourceHandle<Connection>>& retired) {
+  auto now = std::chrono::steady_clock::now();
+  while (!m_idle.empty()) {
+    PoolConnection candidate = std::move(m_idle.back());
+    m_idle.pop_back();
+    if (candidate.expiresAt <= now || !candidate.handle.object->isHealthy()) {
+      retire(candidate, now, retired);
+      m_size--;
+      continue;
+    }
+    connection = std::move(candidate);
+    return true;
+  }
+  return false;
+}
+
+// must be called with m_mutex locked. Takes an idle connection or a slot to open a new one.
+bool ConnectionPool::reserve(PoolConnection& connection, std::vector<provider::ResourceHandle<Connection>>& retired) {
+  if (takeIdle(connection, retired)) {
+    if (m_idle.size() < m_config.minIdle) {
+      m_maintainerCondition.notify_one();
+    }
+    return true;
+  }
+  if (m_size < m_config.maxConnections) {
+    m_size++;
+    if (m_config.minIdle > 0) {
+      m_maintainerCondition.notify_one();
+    }
+    return true;
+  }
+  return false;
+}
+
+void ConnectionPool::notifyWaiters(bool all) {
+  if (all) {
+    m_condition.notify_all();
+    m_waitList.notifyAll();
+  } else {
+    m_condition.notify_one();
+    m_waitList.notifyFirst();
+  }
+}
+
+// a coroutine was added to the wait list - a connection returned after it last checked must not be missed
+void ConnectionPool::onNewItem(async::CoroutineWaitList& list) {
+  bool available;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    available = !m_running || !m_idle.empty() || m_size < m_config.maxConnections;
+  }
+  if (available) {
+    list.notifyFirst();
+  }
+}
+
+ConnectionPool::PoolConnection ConnectionPool::add(const provider::ResourceHandle<Connection>& handle) {
+  auto now = std::chrono::steady_clock::now();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return {handle, getExpiresAt(now), now};
+}
+
+// opens a connection in a slot taken by reserve()
+ConnectionPool::PoolConnection ConnectionPool::open() {
+  auto start = std::chrono::steady_clock::now();
+  provider::ResourceHandle<Connection> handle;
+  try {
+    handle = m_provider->get();
+  } catch (...) {
+    m_creationFailures.fetch_add(1, std::memory_order_relaxed);
+    releaseSlot();
+    throw;
+  }
+  if (!handle) {
+    m_creationFailures.fetch_add(1, std::memory_order_relaxed);
+    releaseSlot();
+    throw std::runtime_error("[oatpp::mariadb::ConnectionPool::open()]: Error. Can't connect.");
+  }
+  m_creations.fetch_add(1, std::memory_order_relaxed);
+  m_creationLatency.recordSince(start);
+  return add(handle);
+}
+
+void ConnectionPool::releaseSlot() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_size--;
+  }
+  notifyWaiters(false);
+}
+
+provider::ResourceHandle<Connection> ConnectionPool::wrap(PoolConnection&& connection,
+                                                          std::chrono::steady_clock::time_point requestedAt) {
+  m_acquisitions.fetch_add(1, std::memory_order_relaxed);
+  m_inUse.fetch_add(1, std::memory_order_relaxed);
+  m_acquireWait.recordSince(requestedAt);
+  return provider::ResourceHandle<Connection>(
+    std::make_shared<PooledConnection>(shared_from_this(), std::move(connection)),
+    m_invalidator
+  );
+}
+
+void ConnectionPool::release(PoolConnection&& connection, bool reusable) {
+
+  auto handle = connection.handle;
+  bool dirty = reusable && handle.object->needsSessionReset();
+  bool keep;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto now = std::chrono::steady_clock::now();
+    keep = reusable && m_running && connection.expiresAt > now;
+    if (!reusable) {
+      m_discards.fetch_add(1, std::memory_order_relaxed);
+    } else if (m_running && !keep) {
+      m_expirations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (keep && dirty) {
+      m_dirty.push_back(std::move(connection));
+      m_maintainerCondition.notify_one();
+    } else if (keep) {
+      connection.idleSince = now;
+      m_idle.push_back(std::move(connection));
+    } else {
+      m_size--;
+      if (m_running && m_config.minIdle > 0) {
+        m_maintainerCondition.notify_one();
+      }
+    }
+  }
+  notifyWaiters(false);
+
+  if (!keep) {
+    close(handle);
+  }
+
+}
+
+void ConnectionPool::close(const provider::ResourceHandle<Connection>& handle) {
+  if (handle.invalidator) {
+    handle.invalidator->invalidate(handle.object);
+  }
+}
+
+provider::ResourceHandle<Connection> ConnectionPool::get() {
+
+  std::vector<provider::ResourceHandle<Connection>> retired;
+  PoolConnection connection;
+  bool reserved = false;
+  bool running;
+  auto start = std::chrono::steady_clock::now();
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto deadline = start + m_config.acquireTimeout;
+    bool waiting = false;
+    while (m_running) {
+      reserved = reserve(connection, retired);
+      if (reserved) {
+        break;
+      }
+      if (!waiting) {
+        waiting = true;
+        m_waiting.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (m_config.acquireTimeout.count() <= 0) {
+        m_condition.wait(lock);
+      } else if (m_condition.wait_until(lock, deadline) == std::cv_status::timeout) {
+        reserved = reserve(connection, retired);
+        break;
+      }
+    }
+    if (waiting) {
+      m_waiting.fetch_sub(1, std::memory_order_relaxed);
+    }
+    running = m_running;
+  }
+
+  for (auto& handle : retired) {
+    close(handle);
+  }
+
+  if (!reserved) {
+    if (running) {
+      m_timeouts.fetch_add(1, std::memory_order_relaxed);
+    }
+    OATPP_LOGW("ConnectionPool", "No connection available. Pool size: %u", m_config.maxConnections);
+    return nullptr;
+  }
+  if (connection.handle) {
+    return wrap(std::move(connection), start);
+  }
+  // connection setup on the request path - minIdle is too low for the load
+  return wrap(open(), start);
+
+}
+
+async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&> ConnectionPool::getAsync() {
+
+  class AcquireCoroutine : public async::CoroutineWithResult<AcquireCoroutine, const provider::ResourceHandle<Connection>&> {
+  private:
+    std::shared_ptr<ConnectionPool> m_pool;
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::time_point m_deadline;
+    std::chrono::steady_clock::time_point m_openStart;
+    bool m_opening;
+    bool m_waiting;
+    provider::ResourceHandle<Connection> m_result;
+  private:
+
+    void stopWaiting() {
+      if (m_waiting) {
+        m_waiting = false;
+        m_pool->m_waiting.fetch_sub(1, std::memory_order_relaxed);
+      }
+    }
+
+  public:
+
+    AcquireCoroutine(const std::shared_ptr<ConnectionPool>& pool)
+      : m_pool(pool)
+      , m_start(std::chrono::steady_clock::now())
+      , m_deadline(m_start + pool->m_config.acquireTimeout)
+      , m_opening(false)
+      , m_waiting(false)
+    {}
+
+    ~AcquireCoroutine() {
+      stopWaiting();
+    }
+
+    Action act() override {
+
+      std::vector<provider::ResourceHandle<Connection>> retired;
+      PoolConnection connection;
+      bool reserved = false;
+      bool running;
+      {
+        std::lock_guard<std::mutex> lock(m_pool->m_mutex);
+        running = m_pool->m_running;
+        if (running) {
+          reserved = m_pool->reserve(connection, retired);
+        }
+      }
+
+      for (auto& handle : retired) {
+        ConnectionPool::close(handle);
+      }
+
+      if (reserved) {
+        stopWaiting();
+      }
+      if (reserved && connection.handle) {
+        m_result = m_pool->wrap(std::move(connection), m_start);
+        return _return(m_result);
+      }
+      if (reserved) {
+        m_opening = true;
+        m_openStart = std::chrono::steady_clock::now();
+        return m_pool->m_provider->getAsync().callbackTo(&AcquireCoroutine::onConnected);
+      }
+      if (!running || (m_pool->m_config.acquireTimeout.count() > 0 && std::chrono::steady_clock::now() >= m_deadline)) {
+        stopWaiting();
+        if (running) {
+          m_pool->m_timeouts.fetch_add(1, std::memory_order_relaxed);
+        }
+        OATPP_LOGW("ConnectionPool", "No connection available. Pool size: %u", m_pool->m_config.maxConnections);
+        return _return(m_result);
+      }
+      if (!m_waiting) {
+        m_waiting = true;
+        m_pool->m_waiting.fetch_add(1, std::memory_order_relaxed);
+      }
+      // woken up by release() - or at the deadline, then act() reports the timeout
+      if (m_pool->m_config.acquireTimeout.count() <= 0) {
+        return Action::createWaitListAction(&m_pool->m_waitList);
+      }
+      return Action::createWaitListActionWithTimeout(&m_pool->m_waitList, m_deadline);
+
+    }
+
+    Action onConnected(const provider::ResourceHandle<Connection>& handle) {
+      m_opening = false;
+      if (!handle) {
+        m_pool->m_creationFailures.fetch_add(1, std::memory_order_relaxed);
+        m_pool->releaseSlot();
+        return error<async::Error>("[oatpp::mariadb::ConnectionPool::getAsync()]: Error. Can't connect.");
+      }
+      m_pool->m_creations.fetch_add(1, std::memory_order_relaxed);
+      m_pool->m_creationLatency.recordSince(m_openStart);
+      m_result = m_pool->wrap(m_pool->add(handle), m_start);
+      return _return(m_result);
+    }
+
+    Action handleError(async::Error* error) override {
+      if (m_opening) {
+        m_opening = false;
+        m_pool->m_creationFailures.fetch_add(1, std::memory_order_relaxed);
+        m_pool->releaseSlot();
+      }
+      return async::AbstractCoroutine::handleError(error);
+    }
+
+  };
+
+  return AcquireCoroutine::startForResult(shared_from_this());
+
+}
+
+// resets sessions of connections returned dirty and returns them to the idle list - or closes them if the reset failed
+void ConnectionPool::resetSessions() {
+  std::deque<PoolConnection> dirty;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    dirty = std::move(m_dirty);
+    m_dirty.clear();
+  }
+  for (auto& connection : dirty) {
+    bool reusable = connection.handle.object->resetSessionIfDirty();
+    release(std::move(connection), reusable);
+  }
+}
+
+// opens connections until minIdle connections are idle - on up to `parallelism` threads, including the calling one
+void ConnectionPool::fill(v_uint32 parallelism) {
+
+  v_uint32 count;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running || m_idle.size() >= m_config.minIdle) {
+      return;
+    }
+    count = std::min<v_uint32>(m_config.minIdle - static_cast<v_uint32>(m_idle.size()), m_config.maxConnections - m_size);
+    m_size += count;
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  // slots are taken up front - each worker opens connections until they are used up or connecting fails
+  std::atomic<v_int32> remaining(static_cast<v_int32>(count));
+  auto worker = [this, &remaining]() {
+    while (remaining.fetch_sub(1) > 0) {
+      PoolConnection connection;
+      try {
+        connection = open();
+      } catch (const std::exception& e) {
+        OATPP_LOGE("ConnectionPool", "Can't open connection: %s", e.what());
+        return;
+      }
+      release(std::move(connection), true);
+    }
+  };
+
+  v_uint32 threadCount = std::max<v_uint32>(1, std::min(count, parallelism));
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount - 1);
+  for (v_uint32 i = 1; i < threadCount; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // slots left over by failed workers
+  for (v_int32 i = remaining.load(); i > 0; i--) {
+    releaseSlot();
+  }
+
+}
+
+void ConnectionPool::maintain() {
+
+  std::vector<provider::ResourceHandle<Connection>> retired;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto now = std::chrono::steady_clock::now();
+
+    std::deque<PoolConnection> idle;
+    for (auto& connection : m_idle) {
+      if (connection.expiresAt <= now || !connection.handle.object->isHealthy()) {
+        retire(connection, now, retired);
+      } else {
+        idle.push_back(std::move(connection));
+      }
+    }
+    m_idle = std::move(idle);
+
+    // the least recently returned are at the front
+    if (m_config.idleTimeout.count() > 0) {
+      while (m_idle.size() > m_config.minIdle && now - m_idle.front().idleSince >= m_config.idleTimeout) {
+        retired.push_back(m_idle.front().handle);
+        m_idle.pop_front();
+        m_evictions.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    m_size -= static_cast<v_uint32>(retired.size());
+  }
+
+  if (!retired.empty()) {
+    OATPP_LOGD("ConnectionPool", "Closing %u expired or idle connections", static_cast<v_uint32>(retired.size()));
+    notifyWaiters(true);
+    for (auto& handle : retired) {
+      close(handle);
+    }
+  }
+
+  // serially - no threads are started on every tick
+  fill(1);
+
+}
+
+void ConnectionPool::runMaintainer() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (m_running) {
+    // a reset requested while the maintainer was busy isn't waited for
+    if (m_dirty.empty()) {
+      m_maintainerCondition.wait_for(lock, m_config.maintenanceInterval);
+    }
+    if (!m_running) {
+      break;
+    }
+    lock.unlock();
+    resetSessions();
+    maintain();
+    lock.lock();
+  }
+}
+
+void ConnectionPool::stop() {
+
+  std::deque<PoolConnection> idle;
+  std::deque<PoolConnection> dirty;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running) {
+      return;
+    }
+    m_running = false;
+    idle = std::move(m_idle);
+    m_idle.clear();
+    dirty = std::move(m_dirty);
+    m_dirty.clear();
+    m_size -= static_cast<v_uint32>(idle.size() + dirty.size());
+  }
+  m_maintainerCondition.notify_all();
+  notifyWaiters(true);
+
+  if (m_maintainer.joinable()) {
+    m_maintainer.join();
+  }
+
+  for (auto& connection : idle) {
+    close(connection.handle);
+  }
+  for (auto& connection : dirty) {
+    close(connection.handle);
+  }
+
+  m_provider->stop();
+
+}
+
+const ConnectionPool::Config& ConnectionPool::getConfig() const {
+  return m_config;
+}
+
+v_uint32 ConnectionPool::getSize() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_size;
+}
+
+v_uint32 ConnectionPool::getIdleCount() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return static_cast<v_uint32>(m_idle.size());
+}
+
+ConnectionPool::Stats ConnectionPool::getStats() {
+  Stats stats;
+  stats.maxConnections = m_config.maxConnections;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    stats.size = m_size;
+    stats.idle = static_cast<v_uint32>(m_idle.size());
+  }
+  stats.inUse = static_cast<v_uint32>(std::max<v_int64>(0, m_inUse.load(std::memory_order_relaxed)));
+  stats.waiting = static_cast<v_uint32>(std::max<v_int64>(0, m_waiting.load(std::memory_order_relaxed)));
+  stats.acquisitions = m_acquisitions.load(std::memory_order_relaxed);
+  stats.timeouts = m_timeouts.load(std::memory_order_relaxed);
+  stats.creations = m_creations.load(std::memory_order_relaxed);
+  stats.creationFailures = m_creationFailures.load(std::memory_order_relaxed);
+  stats.evictions = m_evictions.load(std::memory_order_relaxed);
+  stats.expirations = m_expirations.load(std::memory_order_relaxed);
+  stats.discards = m_discards.load(std::memory_order_relaxed);
+  stats.acquireWait = m_acquireWait.getSnapshot();
+  stats.creationLatency = m_creationLatency.getSnapshot();
+  return stats;
+}
+
+void ConnectionPool::resetStats() {
+  m_acquisitions.store(0, std::memory_order_relaxed);
+  m_timeouts.store(0, std::memory_order_relaxed);
+  m_creations.store(0, std::memory_order_relaxed);
+  m_creationFailures.store(0, std::memory_order_relaxed);
+  m_evictions.store(0, std::memory_order_relaxed);
+  m_expirations.store(0, std::memory_order_relaxed);
+  m_discards.store(0, std::memory_order_relaxed);
+  m_acquireWait.reset();
+  m_creationLatency.reset();
+}
+
+}}
@@ -2,18 +2,311 @@
 #define oatpp_mariadb_ConnectionPool_hpp
 
 #include "ConnectionProvider.hpp"
+#include "metrics/Histogram.hpp"
+
+#include "oatpp/core/async/CoroutineWaitList.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <random>
+#include <thread>
 
 namespace oatpp { namespace mariadb {
 
 /**
- * Convenience typedef for ConnectionPool.
- * Uses the pool implementation from ConnectionProvider.hpp.
+ * Pool of MariaDB connections. <br>
+ * Keeps connection setup (TCP connect, authentication, session setup) off the request path:
+ * <ul>
+ *   <li>`minIdle` connections are opened in parallel when the pool is created and topped up one at a time by the
+ *   maintainer thread.</li>
+ *   <li>Connections are closed after `maxLifetime`, shortened by a random jitter so connections opened together
+ *   don't all expire together. Expired connections are closed when returned or found idle.</li>
+ *   <li>Connections idle longer than `idleTimeout` are closed down to `minIdle`.</li>
+ *   <li>Broken connections (&id:oatpp::mariadb::Connection::isHealthy;) and invalidated ones are closed on return.</li>
+ *   <li>Connections returned with a dirty session or an open transaction are reset with `mysql_reset_connection`
+ *   instead of being reopened - see &id:oatpp::mariadb::Connection::resetSessionIfDirty;. The reset is done by the
+ *   maintainer thread before the connection becomes idle again, so returning a connection never blocks.</li>
+ * </ul>
+ * Lifetime, idle eviction, session resets and prefill are handled by a maintainer thread, stopped by &l:ConnectionPool::stop ();.
+ * Idle connections are reused most recently returned first, so surplus connections become idle and are evicted.
  */
-using ConnectionPool = oatpp::provider::Pool<
-  provider::Provider<Connection>,
-  Connection,
-  ConnectionAcquisitionProxy
->;
+class ConnectionPool : public provider::Provider<Connection>,
+                       public std::enable_shared_from_this<ConnectionPool>,
+                       private async::CoroutineWaitList::Listener {
+public:
+
+  /**
+   * Pool configuration.
+   */
+  struct Config {
+
+    /**
+     * Maximum number of open connections - idle, in use, being reset and being opened.
+     */
+    v_uint32 maxConnections = 10;
+
+    /**
+     * Number of idle connections kept open. Opened when the pool is created and re-opened in the background.
+     */
+    v_uint32 minIdle = 0;
+
+    /**
+     * Maximum number of connections opened at once when the pool is created and filled up to `minIdle`.
+     * Later top-ups are done one at a time by the maintainer thread.
+     */
+    v_uint32 connectParallelism = 4;
+
+    /**
+     * Maximum time to wait for a connection when all `maxConnections` are in use. `0` - wait forever.
+     */
+    std::chrono::milliseconds acquireTimeout = std::chrono::milliseconds(0);
+
+    /**
+     * Maximum lifetime of a connection. `0` - unlimited.
+     */
+    std::chrono::milliseconds maxLifetime = std::chrono::minutes(30);
+
+    /**
+     * Up to this fraction of `maxLifetime` is randomly taken off the lifetime of each connection.
+     */
+    v_float64 lifetimeJitter = 0.1;
+
+    /**
+     * Idle connections above `minIdle` are closed after this time. `0` - never.
+     */
+    std::chrono::milliseconds idleTimeout = std::chrono::minutes(10);
+
+    /**
+     * How often the maintainer thread evicts idle/expired connections and tops the pool up.
+     */
+    std::chrono::milliseconds maintenanceInterval = std::chrono::seconds(1);
+
+  };
+
+  /**
+   * Pool metrics - see &l:ConnectionPool::getStats ();. Latencies are in microseconds.
+   */
+  struct Stats {
+
+    /**
+     * `Config::maxConnections`.
+     */
+    v_uint32 maxConnections = 0;
+
+    /**
+     * Open connections - idle, in use, being reset and being opened.
+     */
+    v_uint32 size = 0;
+
+    /**
+     * Connections handed out and not yet returned.
+     */
+    v_uint32 inUse = 0;
+
+    /**
+     * Idle connections.
+     */
+    v_uint32 idle = 0;
+
+    /**
+     * Callers currently waiting for a connection because all `maxConnections` are in use.
+     */
+    v_uint32 waiting = 0;
+
+    /**
+     * Connections handed out.
+     */
+    v_uint64 acquisitions = 0;
+
+    /**
+     * Acquisitions which gave up after `acquireTimeout`.
+     */
+    v_uint64 timeouts = 0;
+
+    /**
+     * Connections opened.
+     */
+    v_uint64 creations = 0;
+
+    /**
+     * Failed attempts to open a connection.
+     */
+    v_uint64 creationFailures = 0;
+
+    /**
+     * Idle connections closed after `idleTimeout`.
+     */
+    v_uint64 evictions = 0;
+
+    /**
+     * Connections closed after `maxLifetime`.
+     */
+    v_uint64 expirations = 0;
+
+    /**
+     * Connections closed because they were broken, invalidated or their session couldn't be reset.
+     */
+    v_uint64 discards = 0;
+
+    /**
+     * Time from asking for a connection to getting it - including opening one if there was no idle connection.
+     */
+    metrics::Histogram::Snapshot acquireWait;
+
+    /**
+     * Time to open a connection.
+     */
+    metrics::Histogram::Snapshot creationLatency;
+
+  };
+
+private:
+
+  struct PoolConnection {
+    provider::ResourceHandle<Connection> handle;
+    std::chrono::steady_clock::time_point expiresAt;
+    std::chrono::steady_clock::time_point idleSince;
+  };
+
+  class PooledConnection;
+
+  class PoolInvalidator : public provider::Invalidator<Connection> {
+  public:
+    void invalidate(const std::shared_ptr<Connection>& connection) override;
+  };
+
+private:
+  std::shared_ptr<provider::Provider<Connection>> m_provider;
+  Config m_config;
+  std::shared_ptr<PoolInvalidator> m_invalidator;
+  std::deque<PoolConnection> m_idle; // most recently returned last
+  std::deque<PoolConnection> m_dirty; // returned with a dirty session, waiting for the maintainer to reset it
+  v_uint32 m_size;
+  bool m_running;
+  std::mt19937_64 m_random;
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  async::CoroutineWaitList m_waitList; // coroutines waiting in getAsync() - notified together with m_condition
+  std::condition_variable m_maintainerCondition;
+  std::thread m_maintainer;
+private:
+  std::atomic<v_int64> m_inUse;
+  std::atomic<v_int64> m_waiting;
+  std::atomic<v_uint64> m_acquisitions;
+  std::atomic<v_uint64> m_timeouts;
+  std::atomic<v_uint64> m_creations;
+  std::atomic<v_uint64> m_creationFailures;
+  std::atomic<v_uint64> m_evictions;
+  std::atomic<v_uint64> m_expirations;
+  std::atomic<v_uint64> m_discards;
+  metrics::Histogram m_acquireWait;
+  metrics::Histogram m_creationLatency;
+private:
+  void retire(const PoolConnection& connection, std::chrono::steady_clock::time_point now,
+              std::vector<provider::ResourceHandle<Connection>>& retired);
+  std::chrono::steady_clock::time_point getExpiresAt(std::chrono::steady_clock::time_point createdAt);
+  bool takeIdle(PoolConnection& connection, std::vector<provider::ResourceHandle<Connection>>& retired);
+  bool reserve(PoolConnection& connection, std::vector<provider::ResourceHandle<Connection>>& retired);
+  void notifyWaiters(bool all);
+  void onNewItem(async::CoroutineWaitList& list) override;
+  PoolConnection add(const provider::ResourceHandle<Connection>& handle);
+  PoolConnection open();
+  void releaseSlot();
+  provider::ResourceHandle<Connection> wrap(PoolConnection&& connection, std::chrono::steady_clock::time_point requestedAt);
+  void release(PoolConnection&& connection, bool reusable);
+  static void close(const provider::ResourceHandle<Connection>& handle);
+  void resetSessions();
+  void fill(v_uint32 parallelism);
+  void maintain();
+  void runMaintainer();
+public:
+
+  /**
+   * Constructor. Use &l:ConnectionPool::createShared ();.
+   * @param provider - provider opening the connections, usually &id:oatpp::mariadb::ConnectionProvider;.
+   * @param config - &l:ConnectionPool::Config;.
+   */
+  ConnectionPool(const std::shared_ptr<provider::Provider<Connection>>& provider, const Config& config);
+
+  /**
+   * Destructor. Calls &l:ConnectionPool::stop ();.
+   */
+  ~ConnectionPool() override;
+
+  /**
+   * Create the pool, open `minIdle` connections and start the maintainer thread.
+   * @param provider - provider opening the connections, usually &id:oatpp::mariadb::ConnectionProvider;.
+   * @param config - &l:ConnectionPool::Config;.
+   * @return
+   */
+  static std::shared_ptr<ConnectionPool> createShared(const std::shared_ptr<provider::Provider<Connection>>& provider,
+                                                      const Config& config);
+
+  /**
+   * Create the pool with the arguments of `oatpp::provider::Pool::createShared`.
+   * @param provider - provider opening the connections, usually &id:oatpp::mariadb::ConnectionProvider;.
+   * @param maxConnections - maximum number of open connections.
+   * @param idleTimeout - idle connections are closed after this time.
+   * @param acquireTimeout - maximum time to wait for a connection. `0` - wait forever.
+   * @return
+   */
+  static std::shared_ptr<ConnectionPool> createShared(const std::shared_ptr<provider::Provider<Connection>>& provider,
+                                                      v_uint32 maxConnections,
+                                                      const std::chrono::duration<v_int64, std::micro>& idleTimeout,
+                                                      const std::chrono::duration<v_int64, std::micro>& acquireTimeout = std::chrono::microseconds::zero());
+
+  /**
+   * Get connection. Opens a new one if there is no idle connection and fewer than `maxConnections` are open,
+   * otherwise waits up to `acquireTimeout`.
+   * @return - resource handle to the connection. `nullptr` on timeout or if the pool is stopped.
+   */
+  provider::ResourceHandle<Connection> get() override;
+
+  /**
+   * Get connection asynchronously. See &l:ConnectionPool::get ();.
+   * @return - coroutine handle to the connection.
+   */
+  async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&> getAsync() override;
+
+  /**
+   * Stop the maintainer thread, close idle connections and stop the underlying provider.
+   * Connections in use are closed when returned.
+   */
+  void stop() override;
+
+  /**
+   * Get configuration.
+   * @return - &l:ConnectionPool::Config;.
+   */
+  const Config& getConfig() const;
+
+  /**
+   * Get number of open connections - idle, in use, being reset and being opened.
+   * @return
+   */
+  v_uint32 getSize();
+
+  /**
+   * Get number of idle connections.
+   * @return
+   */
+  v_uint32 getIdleCount();
+
+  /**
+   * Get pool metrics. Counters are updated without locking; sizes are read under the pool lock.
+   * @return - &l:ConnectionPool::Stats;.
+   */
+  Stats getStats();
+
+  /**
+   * Reset counters and histograms. Sizes are not affected.
+   */
+  void resetStats();
+
+};
 
 }}
 
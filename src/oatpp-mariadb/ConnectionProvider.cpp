@@ -1,10 +1,17 @@
 #include "ConnectionProvider.hpp"
+#include "NonBlockingCall.hpp"
 
 namespace oatpp { namespace mariadb {
 
 void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr<Connection>& connection) {
-  (void) connection; // unused
-  // TODO: implement connection invalidation
+  // May be called more than once for the same connection (by the pool and by the owner of the handle)
+  MYSQL* handle = connection->getHandle();
+  if (handle) {
+    OATPP_LOGD("ConnectionProvider", "Invalidating connection. Thread id: %lu", mysql_thread_id(handle));
+    connection->getStatementCache().clear();
+    mysql_close(handle);
+    connection->setHandle(nullptr); // -> Health::CLOSED
+  }
 }
 
 ConnectionProvider::ConnectionProvider(const ConnectionOptions& options)
@@ -12,44 +19,168 @@ ConnectionProvider::ConnectionProvider(const ConnectionOptions& options)
   , m_invalidator(std::make_shared<ConnectionInvalidator>())
 {}
 
+bool ConnectionProvider::setOptions(MYSQL* handle, const ConnectionOptions& options) {
+
+  // Default max_allowed_packet is 16MB to handle large text fields
+  unsigned long maxAllowedPacket = static_cast<unsigned long>(options.maxAllowedPacket);
+  if (mysql_options(handle, MYSQL_OPT_MAX_ALLOWED_PACKET, &maxAllowedPacket)) {
+    return false;
+  }
+
+  // negotiated in the handshake - no SET NAMES after connect
+  if (options.charset && mysql_options(handle, MYSQL_SET_CHARSET_NAME, options.charset->c_str())) {
+    return false;
+  }
+
+  if (options.unixSocket) {
+    unsigned int protocol = MYSQL_PROTOCOL_SOCKET;
+    if (mysql_options(handle, MYSQL_OPT_PROTOCOL, &protocol)) {
+      return false;
+    }
+  }
+
+  if (options.compress && mysql_options(handle, MYSQL_OPT_COMPRESS, nullptr)) {
+    return false;
+  }
+
+  const std::pair<mysql_option, std::chrono::seconds> timeouts[] = {
+    {MYSQL_OPT_CONNECT_TIMEOUT, options.connectTimeout},
+    {MYSQL_OPT_READ_TIMEOUT, options.readTimeout},
+    {MYSQL_OPT_WRITE_TIMEOUT, options.writeTimeout}
+  };
+  for (auto& timeout : timeouts) {
+    if (timeout.second.count() > 0) {
+      unsigned int seconds = static_cast<unsigned int>(timeout.second.count());
+      if (mysql_options(handle, timeout.first, &seconds)) {
+        return false;
+      }
+    }
+  }
+
+  // sent by the client library right after authentication, as part of connect
+  for (auto& command : options.initCommands) {
+    if (command && mysql_options(handle, MYSQL_INIT_COMMAND, command->c_str())) {
+      return false;
+    }
+  }
+
+  return true;
+
+}
+
+const char* ConnectionProvider::getHost(const ConnectionOptions& options) {
+  if (options.unixSocket || !options.host) {
+    return nullptr;
+  }
+  return options.host->c_str();
+}
+
 provider::ResourceHandle<Connection> ConnectionProvider::get() {
   MYSQL* handle = mysql_init(nullptr);
   if (handle == nullptr) {
-      throw std::runtime_error("[oatpp::mariadb::ConnectionProvider::get()]: " 
-        "Failed to initialize MySQL connection. Error: " + std::string(mysql_error(handle)));
+      throw std::runtime_error("[oatpp::mariadb::ConnectionProvider::get()]: "
+        "Failed to initialize MySQL connection.");
   }
-    
-  // Set max_allowed_packet to 16MB to handle large text fields
-  unsigned long max_allowed_packet = 16 * 1024 * 1024;
-  if (mysql_options(handle, MYSQL_OPT_MAX_ALLOWED_PACKET, &max_allowed_packet)) {
-    throw std::runtime_error("[oatpp::mariadb::ConnectionProvider::get()]: " 
-      "Failed to set max_allowed_packet. Error: " + std::string(mysql_error(handle)));
+
+  if (!setOptions(handle, m_options)) {
+    std::string error = mysql_error(handle);
+    mysql_close(handle);
+    throw std::runtime_error("[oatpp::mariadb::ConnectionProvider::get()]: "
+      "Failed to set connection options. Error: " + error);
   }
 
-  MYSQL* result = mysql_real_connect(handle, 
-    m_options.host->c_str(), 
-    m_options.username->c_str(), 
-    m_options.password->c_str(), 
-    m_options.database->c_str(), 
-    m_options.port, 
-    nullptr, 
+  MYSQL* result = mysql_real_connect(handle,
+    getHost(m_options),
+    m_options.username->c_str(),
+    m_options.password->c_str(),
+    m_options.database->c_str(),
+    m_options.port,
+    m_options.unixSocket ? m_options.unixSocket->c_str() : nullptr,
     CLIENT_FOUND_ROWS | CLIENT_MULTI_STATEMENTS);  // Enable RETURNING support and multi-statement support
 
   if (result == nullptr) {
-    throw std::runtime_error("[oatpp::mariadb::ConnectionProvider::get()]: " 
-      "Failed to connect to MySQL server. Error: " + std::string(mysql_error(handle)));
+    std::string error = mysql_error(handle);
+    mysql_close(handle);
+    throw std::runtime_error("[oatpp::mariadb::ConnectionProvider::get()]: "
+      "Failed to connect to MySQL server. Error: " + error);
   }
 
-  if (mysql_set_character_set(handle, "utf8") != 0) {
-    throw std::runtime_error("[oatpp::mariadb::ConnectionProvider::get()]: " 
-      "Failed to set character set to utf8. Error: " + std::string(mysql_error(handle)));
-  }
-
-  return provider::ResourceHandle<Connection>(std::make_shared<ConnectionImpl>(handle), m_invalidator);
+  return provider::ResourceHandle<Connection>(std::make_shared<ConnectionImpl>(handle, m_options.statementCacheSize), m_invalidator);
 }
 
 async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&> ConnectionProvider::getAsync() {
-  throw std::runtime_error("[oatpp::mariadb::ConnectionProvider::getAsync()]: Not implemented!");
+
+  class ConnectCoroutine : public async::CoroutineWithResult<ConnectCoroutine, const provider::ResourceHandle<Connection>&> {
+  private:
+    ConnectionOptions m_options;
+    std::shared_ptr<ConnectionInvalidator> m_invalidator;
+    MYSQL* m_handle;
+    MYSQL* m_result;
+  public:
+
+    ConnectCoroutine(const ConnectionOptions& options, const std::shared_ptr<ConnectionInvalidator>& invalidator)
+      : m_options(options)
+      , m_invalidator(invalidator)
+      , m_handle(nullptr)
+      , m_result(nullptr)
+    {}
+
+    ~ConnectCoroutine() {
+      // connect failed or the coroutine was dropped
+      if (m_handle) {
+        mysql_close(m_handle);
+      }
+    }
+
+    Action act() override {
+
+      m_handle = mysql_init(nullptr);
+      if (m_handle == nullptr) {
+        return error<async::Error>("[oatpp::mariadb::ConnectionProvider::getAsync()]: "
+                                   "Failed to initialize MySQL connection.");
+      }
+
+      // the non-blocking connect needs it - connections from get() get it on first async use
+      if (!setOptions(m_handle, m_options) || mysql_options(m_handle, MYSQL_OPT_NONBLOCK, 0)) {
+        return error<async::Error>("[oatpp::mariadb::ConnectionProvider::getAsync()]: "
+                                   "Failed to set connection options. Error: " + std::string(mysql_error(m_handle)));
+      }
+
+      return NonBlockingCall::start(m_handle,
+        [this]() {
+          return mysql_real_connect_start(&m_result, m_handle,
+                                          getHost(m_options),
+                                          m_options.username->c_str(),
+                                          m_options.password->c_str(),
+                                          m_options.database->c_str(),
+                                          m_options.port,
+                                          m_options.unixSocket ? m_options.unixSocket->c_str() : nullptr,
+                                          CLIENT_FOUND_ROWS | CLIENT_MULTI_STATEMENTS);
+        },
+        [this](int status) {
+          return mysql_real_connect_cont(&m_result, m_handle, status);
+        })
+        .next(yieldTo(&ConnectCoroutine::onConnected));
+
+    }
+
+    Action onConnected() {
+
+      if (m_result == nullptr) {
+        return error<async::Error>("[oatpp::mariadb::ConnectionProvider::getAsync()]: "
+                                   "Failed to connect to MySQL server. Error: " + std::string(mysql_error(m_handle)));
+      }
+
+      MYSQL* handle = m_handle;
+      m_handle = nullptr;
+      return _return(provider::ResourceHandle<Connection>(std::make_shared<ConnectionImpl>(handle, m_options.statementCacheSize), m_invalidator));
+
+    }
+
+  };
+
+  return ConnectCoroutine::startForResult(m_options, m_invalidator);
+
 }
 
 void ConnectionProvider::stop() {
@@ -6,6 +6,9 @@
 #include "oatpp/core/provider/Pool.hpp"
 #include "oatpp/core/Types.hpp"
 
+#include <chrono>
+#include <vector>
+
 namespace oatpp { namespace mariadb {
 
 struct ConnectionOptions {
@@ -14,6 +17,55 @@ struct ConnectionOptions {
   oatpp::String database;
   oatpp::String username;
   oatpp::String password;
+
+  /**
+   * Maximum number of prepared statements cached per connection. `0` disables the cache.
+   */
+  v_uint32 statementCacheSize = StatementCache::DEFAULT_CAPACITY;
+
+  /**
+   * Client-side `max_allowed_packet`. Also bounds the size of multi-row inserts built by &id:oatpp::mariadb::Executor::executeBatch;.
+   */
+  v_uint64 maxAllowedPacket = 16 * 1024 * 1024;
+
+  /**
+   * Path of the server's unix socket. If set, connections go through the socket and `host`/`port` are ignored -
+   * cheaper to open and to use than TCP when the server runs on the same machine.
+   */
+  oatpp::String unixSocket;
+
+  /**
+   * Compress the client/server protocol (`MYSQL_OPT_COMPRESS`). Trades CPU for bandwidth - for servers behind slow links.
+   */
+  bool compress = false;
+
+  /**
+   * Timeout of connecting to the server (`MYSQL_OPT_CONNECT_TIMEOUT`). `0` - client library default.
+   */
+  std::chrono::seconds connectTimeout = std::chrono::seconds(0);
+
+  /**
+   * Timeout of each read from the server (`MYSQL_OPT_READ_TIMEOUT`). `0` - no timeout.
+   * Honoured by &id:oatpp::mariadb::Executor::executeAsync; too - while a read with a timeout is pending the socket is
+   * polled instead of waited on, see &id:oatpp::mariadb::NonBlockingCall;.
+   */
+  std::chrono::seconds readTimeout = std::chrono::seconds(0);
+
+  /**
+   * Timeout of each write to the server (`MYSQL_OPT_WRITE_TIMEOUT`). `0` - no timeout.
+   */
+  std::chrono::seconds writeTimeout = std::chrono::seconds(0);
+
+  /**
+   * Connection character set. Negotiated during the handshake (`MYSQL_SET_CHARSET_NAME`), so no `SET NAMES` round trip is made.
+   */
+  oatpp::String charset = "utf8";
+
+  /**
+   * Statements executed by the server right after authentication (`MYSQL_INIT_COMMAND`), e.g. `SET time_zone = '+00:00'`.
+   * Run again after the session is reset - see &id:oatpp::mariadb::Connection::resetSessionIfDirty;.
+   */
+  std::vector<oatpp::String> initCommands;
 };
 
 class ConnectionProvider : public provider::Provider<Connection> {
@@ -24,6 +76,16 @@ private:
     void invalidate(const std::shared_ptr<Connection>& connection) override;
   };
 
+private:
+
+  /*
+   * Apply connection options to a handle before connect.
+   * @return - `false` on error - see `mysql_error`.
+   */
+  static bool setOptions(MYSQL* handle, const ConnectionOptions& options);
+
+  static const char* getHost(const ConnectionOptions& options);
+
 private:
   std::shared_ptr<ConnectionInvalidator> m_invalidator;
   ConnectionOptions m_options;
@@ -60,15 +122,6 @@ public:
 
 };
 
-/**
- * Connection pool.
- */
-typedef oatpp::provider::Pool<
-  provider::Provider<Connection>,
-  Connection,
-  ConnectionAcquisitionProxy
-> ConnectionPool;
-
 }}
 
 #endif /* oatpp_mariadb_ConnectionProvider_hpp */
\ No newline at end of file
@@ -3,12 +3,15 @@
 #include "dto/CountResult.hpp"
 
 #include "QueryResult.hpp"
+#include "NonBlockingCall.hpp"
 #include "mapping/ResultMapper.hpp"
 #include "oatpp/core/base/Environment.hpp"
 #include "oatpp/core/data/stream/Stream.hpp"
 #include "oatpp/core/utils/ConversionUtils.hpp"
 #include "oatpp/core/data/mapping/type/Type.hpp"
 #include "oatpp/core/Types.hpp"
+#include <algorithm>
+#include <cctype>
 
 namespace oatpp { namespace mariadb {
 
@@ -47,19 +50,65 @@ Executor::Executor(const std::shared_ptr<provider::Provider<Connection>>& connec
   : m_connectionProvider(connectionProvider)
   , m_connectionInvalidator(std::make_shared<ConnectionInvalidator>())
   , m_serializer(std::make_shared<mapping::Serializer>())
+  , m_batchSerializer(std::make_shared<mapping::BatchSerializer>())
   , m_resultMapper(std::make_shared<mapping::ResultMapper>())
+  , m_textResultMapper(std::make_shared<mapping::TextResultMapper>())
   , m_defaultTypeResolver(createTypeResolver())
+  , m_connectionAcquisitions(0)
+  , m_connectionFailures(0)
 {
 
 }
 
 std::shared_ptr<data::mapping::TypeResolver> Executor::createTypeResolver() {
   auto resolver = std::make_shared<data::mapping::TypeResolver>();
+  resolver->addKnownClasses({types::__class::LongData::CLASS_ID});
   return resolver;
 }
 
 provider::ResourceHandle<orm::Connection> Executor::getConnection() {
-  auto connection = m_connectionProvider->get();
+  return wrapConnection(measureAcquisition([this]() {
+    return m_connectionProvider->get();
+  }));
+}
+
+provider::ResourceHandle<Connection> Executor::measureAcquisition(const std::function<provider::ResourceHandle<Connection>()>& acquire) {
+  auto start = std::chrono::steady_clock::now();
+  provider::ResourceHandle<Connection> connection;
+  try {
+    connection = acquire();
+  } catch (...) {
+    recordAcquisition(start, false);
+    throw;
+  }
+  recordAcquisition(start, connection.object != nullptr);
+  return connection;
+}
+
+void Executor::recordAcquisition(std::chrono::steady_clock::time_point start, bool success) {
+  if (success) {
+    m_connectionAcquisitions.fetch_add(1, std::memory_order_relaxed);
+    m_connectionAcquireWait.recordSince(start);
+  } else {
+    m_connectionFailures.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+Executor::ConnectionStats Executor::getConnectionStats() const {
+  ConnectionStats stats;
+  stats.acquisitions = m_connectionAcquisitions.load(std::memory_order_relaxed);
+  stats.failures = m_connectionFailures.load(std::memory_order_relaxed);
+  stats.acquireWait = m_connectionAcquireWait.getSnapshot();
+  return stats;
+}
+
+void Executor::resetConnectionStats() {
+  m_connectionAcquisitions.store(0, std::memory_order_relaxed);
+  m_connectionFailures.store(0, std::memory_order_relaxed);
+  m_connectionAcquireWait.reset();
+}
+
+provider::ResourceHandle<orm::Connection> Executor::wrapConnection(const provider::ResourceHandle<Connection>& connection) {
   if (connection) {
     connection.object->setInvalidator(connection.invalidator);
     return provider::ResourceHandle<orm::Connection>(
@@ -70,6 +119,64 @@ provider::ResourceHandle<orm::Connection> Executor::getConnection() {
   throw std::runtime_error("[oatpp::mariadb::Executor::getConnection()]: Error. Can't connect.");
 }
 
+provider::ResourceHandle<Connection> Executor::acquireConnection(const ql_template::Parser::TemplateExtra& extra) {
+  (void) extra;
+  return m_connectionProvider->get();
+}
+
+async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&>
+Executor::acquireConnectionAsync(const ql_template::Parser::TemplateExtra& extra) {
+  (void) extra;
+  return m_connectionProvider->getAsync();
+}
+
+void Executor::setTemplateCursor(const oatpp::String& templateName, v_uint32 prefetchRows) {
+  std::lock_guard<std::mutex> lock(m_templateCursorsMutex);
+  m_templateCursors[templateName] = prefetchRows;
+}
+
+std::shared_ptr<ResultCache> Executor::enableResultCache(const ResultCache::Config& config) {
+  m_resultCache = std::make_shared<ResultCache>(config);
+  return m_resultCache;
+}
+
+std::shared_ptr<ResultCache> Executor::getResultCache() const {
+  return m_resultCache;
+}
+
+std::shared_ptr<metrics::QueryMetrics> Executor::enableQueryMetrics(const metrics::QueryMetrics::Config& config) {
+  m_queryMetrics = std::make_shared<metrics::QueryMetrics>(config);
+  return m_queryMetrics;
+}
+
+std::shared_ptr<metrics::QueryMetrics> Executor::getQueryMetrics() const {
+  return m_queryMetrics;
+}
+
+void Executor::setTemplateResultCache(const oatpp::String& templateName, std::chrono::milliseconds ttl) {
+  std::lock_guard<std::mutex> lock(m_templateResultCacheMutex);
+  m_templateResultCacheTtls[templateName] = ttl;
+}
+
+void Executor::invalidateResultCache(const std::vector<std::string>& tables, const provider::ResourceHandle<orm::Connection>& connection) {
+  if (!m_resultCache) {
+    return;
+  }
+  auto mysqlConnection = std::static_pointer_cast<mariadb::Connection>(connection.object);
+  const bool inTransaction = mysqlConnection && mysqlConnection->isInTransaction();
+  m_resultCache->invalidate(tables, inTransaction ? connection.object.get() : nullptr);
+}
+
+void Executor::invalidateResultCache(const oatpp::String& query, const provider::ResourceHandle<orm::Connection>& connection) {
+  if (!m_resultCache) {
+    return;
+  }
+  std::vector<std::string> tables;
+  if (ql_template::Parser::findTables(query, tables)) {
+    invalidateResultCache(tables, connection);
+  }
+}
+
 data::share::StringTemplate Executor::parseQueryTemplate(const oatpp::String& name,
                                                          const oatpp::String& text,
                                                          const ParamsTypeMap& paramsTypeMap,
@@ -84,122 +191,268 @@ data::share::StringTemplate Executor::parseQueryTemplate(const oatpp::String& na
   extra->prepare = prepare;
   extra->templateName = name;
 
+  {
+    std::lock_guard<std::mutex> lock(m_templateCursorsMutex);
+    auto it = m_templateCursors.find(name);
+    if (it != m_templateCursors.end()) {
+      extra->cursorPrefetchRows = it->second;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_templateResultCacheMutex);
+    auto it = m_templateResultCacheTtls.find(name);
+    if (it != m_templateResultCacheTtls.end()) {
+      extra->resultCache = true;
+      extra->resultCacheTtl = it->second;
+    }
+  }
+
   ql_template::TemplateValueProvider valueProvider;
   extra->preparedTemplate = t.format(&valueProvider);
 
-  return t;
-}
+  ql_template::Parser::findInsertValues(extra->preparedTemplate, extra->valuesStart, extra->valuesEnd);
+  extra->isWrite = ql_template::Parser::findTables(extra->preparedTemplate, extra->tables);
+  extra->isReadOnly = ql_template::Parser::isReadOnly(extra->preparedTemplate);
+  extra->changesSession = ql_template::Parser::changesSession(extra->preparedTemplate);
 
-// e.g. "user.name.first" -> QueryParameter{name="user", propertyPath={"name", "first"}}
-Executor::QueryParameter Executor::parseQueryParameter(const oatpp::String& paramName) {
+  if (m_queryMetrics) {
+    extra->metrics = m_queryMetrics->getTemplate(name);
+  }
 
-  parser::Caret caret(paramName);
-  auto nameLabel = caret.putLabel();
-  if(caret.findChar('.') && caret.getPosition() < caret.getDataSize() - 1) {
+  extra->parameters.reserve(t.getTemplateVariables().size());
+  for (auto& var : t.getTemplateVariables()) {
+    auto parameter = ql_template::Parser::parseParameter(var.name);
+    if (parameter.name->empty()) {
+      throw std::runtime_error(std::string("[oatpp::mariadb::Executor::parseQueryTemplate()]: Error. Can't parse query parameter name. Parameter name: ") +
+                               var.name->c_str());
+    }
+    extra->parameters.push_back(std::move(parameter));
+  }
 
-    QueryParameter result;
-    result.name = nameLabel.toString();
+  return t;
+}
 
-    do {
+oatpp::Void Executor::resolveParam(ql_template::Parser::TemplateExtra::Parameter& parameter,
+                                   const oatpp::Void& value,
+                                   const data::mapping::TypeResolver& typeResolver) {
 
-      caret.inc();
-      auto label = caret.putLabel();
-      caret.findChar('.');
-      result.propertyPath.push_back(label.std_str());
+  if (parameter.propertyPath.empty()) {
+    if (typeResolver.isKnownType(value.getValueType())) {
+      return value;
+    }
+  } else if (value && value.getValueType()->classId.id == data::mapping::type::__class::AbstractObject::CLASS_ID.id) {
 
-    } while (caret.getPosition() < caret.getDataSize());
+    auto chain = std::atomic_load(&parameter.propertyChain);
+    if (!chain || chain->objectType != value.getValueType()) {
+      chain = ql_template::Parser::resolvePropertyChain(value.getValueType(), parameter.propertyPath);
+      std::atomic_store(&parameter.propertyChain, chain);
+    }
 
-    return result;
+    auto& properties = chain->properties;
+    if (!properties.empty()) {
+      oatpp::Void current = value;
+      size_t i = 0;
+      for (; i < properties.size() && current; i++) {
+        current = properties[i]->get(static_cast<data::mapping::type::BaseObject*>(current.get()));
+      }
+      if (i == properties.size() && typeResolver.isKnownType(current.getValueType())) {
+        return current;
+      }
+    }
 
   }
 
-  return {nameLabel.toString(), {}};
+  // null objects in the middle of the path, maps, Any and interpretations
+  data::mapping::TypeResolver::Cache cache;
+  return typeResolver.resolveObjectPropertyValue(value, parameter.propertyPath, cache);
 
 }
 
-// mysql bind params
-void Executor::bindParams(MYSQL_STMT* stmt,
-                          const StringTemplate& queryTemplate,
-                          const std::unordered_map<oatpp::String, oatpp::Void>& params, 
-                          const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver) {
-  data::mapping::TypeResolver::Cache cache;
+void Executor::serializeParams(mapping::Serializer::BindContext& context,
+                               const StringTemplate& queryTemplate,
+                               const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                               const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver) {
 
   auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
 
-  size_t count = queryTemplate.getTemplateVariables().size();
-  for (size_t i = 0; i < count; ++i) {
-    auto& var = queryTemplate.getTemplateVariables()[i];
-    
-    auto queryParam = parseQueryParameter(var.name);  // e.g. "user.name.first" -> QueryParameter{name="user", propertyPath={"name", "first"}}
-
-    if (queryParam.name->empty()) {
-      throw std::runtime_error(std::string("[oatpp::mariadb::Executor::bindParams()]: Error. Can't parse query parameter name. Parameter name: ") + 
-                             var.name->c_str());
-    }
+  auto& variables = queryTemplate.getTemplateVariables();
+  for (size_t i = 0; i < extra->parameters.size(); ++i) {
+    auto& parameter = extra->parameters[i];
 
-    // resolve parameter type
-    auto it = params.find(queryParam.name);
+    auto it = params.find(parameter.name);
     if (it != params.end()) {
-      auto value = typeResolver->resolveObjectPropertyValue(it->second, queryParam.propertyPath, cache);
+      auto value = resolveParam(parameter, it->second, *typeResolver);
       if (value.getValueType()->classId.id == oatpp::Void::Class::CLASS_ID.id) {
         throw std::runtime_error(std::string("[oatpp::mariadb::Executor::bindParams()]: Error. Can't resolve parameter type because property dose not found or its type is unknown. Parameter name: ") + 
-                               queryParam.name->c_str() + ", var.name: " + var.name->c_str());
+                               parameter.name->c_str() + ", var.name: " + variables[i].name->c_str());
       }
 
       // [serialize] bind parameter according to the resolved type
-      m_serializer->serialize(stmt, i, value);
+      m_serializer->serialize(context, i, value);
     }
   }
 
-  // Bind all parameters at once after serialization is complete
-  m_serializer->bindParameters(stmt);
+}
+
+// mysql bind params
+void Executor::bindParams(MYSQL_STMT* stmt,
+                          mapping::Serializer::BindContext& context,
+                          const StringTemplate& queryTemplate,
+                          const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                          const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver) {
+
+  serializeParams(context, queryTemplate, params, typeResolver);
+
+  // Bind all parameters at once after serialization is complete.
+  // Missing parameters stay NULL, so no binds of a previous execution are left on a cached statement
+  context.bind(stmt);
 }
 
 std::shared_ptr<orm::QueryResult> Executor::execute(const StringTemplate& queryTemplate,
                                                     const std::unordered_map<oatpp::String, oatpp::Void>& params,
                                                     const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                                     const provider::ResourceHandle<orm::Connection>& connection) {
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  return executePrepared(queryTemplate, params, typeResolver, connection, extra->cursorPrefetchRows, false);
+}
 
-  auto connectionHandle = connection;
-  if (!connectionHandle) {
-    connectionHandle = getConnection();
+std::shared_ptr<orm::QueryResult> Executor::executeWithCursor(const StringTemplate& queryTemplate,
+                                                              const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                              v_uint32 prefetchRows,
+                                                              const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                              const provider::ResourceHandle<orm::Connection>& connection) {
+  if (prefetchRows == 0) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeWithCursor()]: Error. prefetchRows must be greater than 0.");
   }
+  return executePrepared(queryTemplate, params, typeResolver, connection, prefetchRows, false);
+}
+
+std::shared_ptr<orm::QueryResult> Executor::executeStreaming(const StringTemplate& queryTemplate,
+                                                             const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                             const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                             const provider::ResourceHandle<orm::Connection>& connection) {
+  return executePrepared(queryTemplate, params, typeResolver, connection, 0, true);
+}
+
+std::shared_ptr<orm::QueryResult> Executor::executePrepared(const StringTemplate& queryTemplate,
+                                                            const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                            const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                            const provider::ResourceHandle<orm::Connection>& connection,
+                                                            v_uint32 cursorPrefetchRows,
+                                                            bool streaming) {
 
   std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
   if(!tr) {
     tr = m_defaultTypeResolver;
   }
 
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  auto& templateMetrics = extra->metrics;
+  std::chrono::steady_clock::duration bindTime(0);
+
+  // Parameters are serialized before a connection is taken - the cache key is built from the bound values
+  std::shared_ptr<mapping::Serializer::BindContext> bindContext;
+  if (!extra->parameters.empty()) {
+    auto start = std::chrono::steady_clock::now();
+    bindContext = std::make_shared<mapping::Serializer::BindContext>(static_cast<v_uint32>(extra->parameters.size()));
+    serializeParams(*bindContext, queryTemplate, params, tr);
+    bindTime = std::chrono::steady_clock::now() - start;
+  }
+
+  // Reads inside a transaction may see its uncommitted writes - they are neither served from nor put to the cache
+  bool cacheResult = m_resultCache && extra->resultCache &&
+                     (!connection || !std::static_pointer_cast<mariadb::Connection>(connection.object)->isInTransaction());
+
+  ResultCache::Recording recording;
+  if (cacheResult && ResultCache::makeKey(extra->templateName, bindContext.get(), recording.key)) {
+    auto snapshot = m_resultCache->get(recording.key);
+    if (snapshot) {
+      OATPP_LOGD("Executor", "Result served from cache. Template: %s", extra->templateName->c_str());
+      return std::make_shared<QueryResult>(snapshot, connection, m_resultMapper, tr);
+    }
+    recording.tables = extra->tables;
+    recording.ttl = extra->resultCacheTtl;
+    // taken before the statement is executed - a write committed in between makes the recorded rows stale
+    recording.epoch = m_resultCache->getEpoch();
+  } else {
+    cacheResult = false;
+  }
+
+  auto connectionHandle = connection;
+  if (!connectionHandle) {
+    auto start = std::chrono::steady_clock::now();
+    connectionHandle = wrapConnection(measureAcquisition([this, &extra]() {
+      return acquireConnection(*extra);
+    }));
+    if (templateMetrics) {
+      templateMetrics->recordSince(metrics::TemplateMetrics::Phase::ACQUIRE, start);
+    }
+  }
+
   auto mysqlConnection = std::static_pointer_cast<mariadb::Connection>(connectionHandle.object);
+  auto conn = mysqlConnection->getHandle();
 
-  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
-  auto conn = std::static_pointer_cast<mariadb::Connection>(connectionHandle.object)->getHandle();
+  // an invalidated connection has its handle closed and set to null - check before touching it
+  if (!conn || !mysqlConnection->isHealthy()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::execute()]: Error. Connection is broken or closed.");
+  }
+  if (mysqlConnection->isBusy()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::execute()]: Error. Connection is busy reading a previous result.");
+  }
 
   OATPP_LOGD("Executor", "Preparing to execute query. Connection thread id: %lu", mysql_thread_id(conn));
   OATPP_LOGD("Executor", "Query template: %s", extra->preparedTemplate->c_str());
 
-  MYSQL_STMT* stmt = mysql_stmt_init(conn);
-  if (!stmt) {
-    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::execute()]: Error. Unable to initialize statement."));
+  auto& statementCache = mysqlConnection->getStatementCache();
+  MYSQL_STMT* stmt;
+  auto prepareStart = std::chrono::steady_clock::now();
+  try {
+    stmt = statementCache.acquire(conn, extra->preparedTemplate);
+  } catch (...) {
+    if (mysqlConnection->reportError(mysql_errno(conn)) && connectionHandle.invalidator) {
+      connectionHandle.invalidator->invalidate(connectionHandle.object);
+    }
+    throw;
   }
-
-  OATPP_LOGD("Executor", "Statement initialized. Address: %p", (void*)stmt);
-
-  if (mysql_stmt_prepare(stmt, extra->preparedTemplate->c_str(), extra->preparedTemplate->size())) {
-    std::string error = mysql_stmt_error(stmt);
-    mysql_stmt_close(stmt);
-    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::execute()]: Error. Unable to prepare statement: ") + error);
+  if (templateMetrics) {
+    templateMetrics->recordSince(metrics::TemplateMetrics::Phase::PREPARE, prepareStart);
   }
 
-  OATPP_LOGD("Executor", "Statement prepared successfully");
+  OATPP_LOGD("Executor", "Statement prepared successfully. Address: %p", (void*)stmt);
 
-  if (!params.empty()) {
+  if (bindContext) {
     OATPP_LOGD("Executor", "Binding parameters...");
-    bindParams(stmt, queryTemplate, params, typeResolver);
+    auto start = std::chrono::steady_clock::now();
+    try {
+      bindContext->bind(stmt);
+    } catch (...) {
+      statementCache.release(conn, extra->preparedTemplate, stmt, true);
+      throw;
+    }
+    bindTime += std::chrono::steady_clock::now() - start;
     OATPP_LOGD("Executor", "Parameters bound successfully");
   }
+  if (templateMetrics) {
+    templateMetrics->record(metrics::TemplateMetrics::Phase::BIND, bindTime);
+  }
+
+  // marked before execution - a failed statement may still have changed the session
+  if (extra->changesSession) {
+    mysqlConnection->setSessionDirty(true);
+  }
 
-  return std::make_shared<QueryResult>(stmt, connectionHandle, m_resultMapper, tr);
+  auto result = std::make_shared<QueryResult>(stmt, connectionHandle, m_resultMapper, tr, extra->preparedTemplate, bindContext,
+                                              cursorPrefetchRows, streaming, true, templateMetrics);
+
+  if (cacheResult) {
+    result->recordResult(m_resultCache, recording);
+  }
+  if (extra->isWrite) {
+    invalidateResultCache(extra->tables, connectionHandle);
+  }
+
+  return result;
 }
 
 std::shared_ptr<orm::QueryResult> Executor::execute(const StringTemplate& queryTemplate,
@@ -207,6 +460,520 @@ std::shared_ptr<orm::QueryResult> Executor::execute(const StringTemplate& queryT
   return execute(queryTemplate, {}, m_defaultTypeResolver, connection);
 }
 
+async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+Executor::executeAsync(const StringTemplate& queryTemplate,
+                       const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                       const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                       const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+  class ExecuteCoroutine : public async::CoroutineWithResult<ExecuteCoroutine, const std::shared_ptr<orm::QueryResult>&> {
+  private:
+    Executor* m_executor;
+    StringTemplate m_queryTemplate;
+    std::unordered_map<oatpp::String, oatpp::Void> m_params;
+    std::shared_ptr<const data::mapping::TypeResolver> m_typeResolver;
+    provider::ResourceHandle<orm::Connection> m_connection;
+    std::shared_ptr<ql_template::Parser::TemplateExtra> m_extra;
+    MYSQL* m_mysql;
+    MYSQL_STMT* m_stmt;
+    my_bool m_resetResult;
+    int m_prepareResult;
+    std::shared_ptr<mapping::Serializer::BindContext> m_bindContext;
+    std::shared_ptr<QueryResult> m_result;
+    std::chrono::steady_clock::time_point m_acquireStart;
+    std::chrono::steady_clock::time_point m_prepareStart;
+    bool m_acquiring;
+  private:
+
+    void record(metrics::TemplateMetrics::Phase phase, std::chrono::steady_clock::time_point start) {
+      if (m_extra->metrics) {
+        m_extra->metrics->recordSince(phase, start);
+      }
+    }
+
+    std::shared_ptr<Connection> getMysqlConnection() {
+      return std::static_pointer_cast<Connection>(m_connection.object);
+    }
+
+    Action failPrepare(const std::string& message) {
+      if (getMysqlConnection()->reportError(mysql_errno(m_mysql)) && m_connection.invalidator) {
+        m_connection.invalidator->invalidate(m_connection.object);
+      }
+      return error<async::Error>("[oatpp::mariadb::Executor::executeAsync()]: Error. " + message);
+    }
+
+  public:
+
+    ExecuteCoroutine(Executor* executor,
+                     const StringTemplate& queryTemplate,
+                     const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                     const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                     const provider::ResourceHandle<orm::Connection>& connection)
+      : m_executor(executor)
+      , m_queryTemplate(queryTemplate)
+      , m_params(params)
+      , m_typeResolver(typeResolver ? typeResolver : executor->m_defaultTypeResolver)
+      , m_connection(connection)
+      , m_extra(std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData()))
+      , m_mysql(nullptr)
+      , m_stmt(nullptr)
+      , m_resetResult(0)
+      , m_prepareResult(0)
+      , m_acquiring(false)
+    {}
+
+    Action act() override {
+      if (!m_connection) {
+        m_acquireStart = std::chrono::steady_clock::now();
+        m_acquiring = true;
+        return m_executor->acquireConnectionAsync(*m_extra).callbackTo(&ExecuteCoroutine::onConnection);
+      }
+      return yieldTo(&ExecuteCoroutine::acquireStatement);
+    }
+
+    Action onConnection(const provider::ResourceHandle<Connection>& connection) {
+      m_acquiring = false;
+      m_executor->recordAcquisition(m_acquireStart, connection.object != nullptr);
+      if (!connection) {
+        return error<async::Error>("[oatpp::mariadb::Executor::executeAsync()]: Error. Can't connect.");
+      }
+      record(metrics::TemplateMetrics::Phase::ACQUIRE, m_acquireStart);
+      connection.object->setInvalidator(connection.invalidator);
+      m_connection = provider::ResourceHandle<orm::Connection>(connection.object, m_executor->m_connectionInvalidator);
+      return yieldTo(&ExecuteCoroutine::acquireStatement);
+    }
+
+    Action acquireStatement() {
+
+      auto mysqlConnection = getMysqlConnection();
+      m_mysql = mysqlConnection->getHandle();
+      if (!m_mysql || !mysqlConnection->isHealthy()) {
+        return error<async::Error>("[oatpp::mariadb::Executor::executeAsync()]: Error. Connection is broken or closed.");
+      }
+      if (mysqlConnection->isBusy()) {
+        return error<async::Error>("[oatpp::mariadb::Executor::executeAsync()]: Error. Connection is busy reading a previous result.");
+      }
+      if (!mysqlConnection->enableNonBlocking()) {
+        return error<async::Error>("[oatpp::mariadb::Executor::executeAsync()]: Error. Can't enable non-blocking API. "
+                                   + std::string(mysql_error(m_mysql)));
+      }
+
+      m_prepareStart = std::chrono::steady_clock::now();
+      bool needsReset;
+      m_stmt = mysqlConnection->getStatementCache().take(m_mysql, m_extra->preparedTemplate, needsReset);
+      if (!m_stmt) {
+        return yieldTo(&ExecuteCoroutine::prepareStatement);
+      }
+      if (!needsReset) {
+        return yieldTo(&ExecuteCoroutine::bindParams);
+      }
+
+      MYSQL_STMT* stmt = m_stmt;
+      return NonBlockingCall::start(m_mysql,
+                                    [this, stmt]() { return mysql_stmt_reset_start(&m_resetResult, stmt); },
+                                    [this, stmt](int status) { return mysql_stmt_reset_cont(&m_resetResult, stmt, status); })
+        .next(yieldTo(&ExecuteCoroutine::onReset));
+
+    }
+
+    Action onReset() {
+      if (m_resetResult == 0) {
+        return yieldTo(&ExecuteCoroutine::bindParams);
+      }
+      OATPP_LOGD("Executor", "Failed to reset cached statement: %s", mysql_stmt_error(m_stmt));
+      mysql_stmt_close(m_stmt);
+      m_stmt = nullptr;
+      return yieldTo(&ExecuteCoroutine::prepareStatement);
+    }
+
+    Action prepareStatement() {
+
+      m_stmt = mysql_stmt_init(m_mysql);
+      if (!m_stmt) {
+        return failPrepare(std::string("Unable to initialize statement: ") + mysql_error(m_mysql));
+      }
+
+      MYSQL_STMT* stmt = m_stmt;
+      const oatpp::String& query = m_extra->preparedTemplate;
+      return NonBlockingCall::start(m_mysql,
+                                    [this, stmt, query]() { return mysql_stmt_prepare_start(&m_prepareResult, stmt, query->c_str(), query->size()); },
+                                    [this, stmt](int status) { return mysql_stmt_prepare_cont(&m_prepareResult, stmt, status); })
+        .next(yieldTo(&ExecuteCoroutine::onPrepared));
+
+    }
+
+    Action onPrepared() {
+      if (m_prepareResult) {
+        std::string message = std::string("Unable to prepare statement: ") + mysql_stmt_error(m_stmt);
+        mysql_stmt_close(m_stmt);
+        m_stmt = nullptr;
+        return failPrepare(message);
+      }
+      return yieldTo(&ExecuteCoroutine::bindParams);
+    }
+
+    Action bindParams() {
+
+      record(metrics::TemplateMetrics::Phase::PREPARE, m_prepareStart);
+
+      auto bindStart = std::chrono::steady_clock::now();
+      if (!m_extra->parameters.empty()) {
+        try {
+          m_bindContext = std::make_shared<mapping::Serializer::BindContext>(static_cast<v_uint32>(m_extra->parameters.size()));
+          m_executor->serializeParams(*m_bindContext, m_queryTemplate, m_params, m_typeResolver);
+          if (!m_bindContext->hasLongData()) {
+            m_bindContext->bind(m_stmt);
+          }
+        } catch (const std::exception& e) {
+          getMysqlConnection()->getStatementCache().release(m_mysql, m_extra->preparedTemplate, m_stmt, true);
+          m_stmt = nullptr;
+          return error<async::Error>(e.what());
+        }
+        // mysql_stmt_send_long_data has no non-blocking variant - checked before anything is sent
+        if (m_bindContext->hasLongData()) {
+          getMysqlConnection()->getStatementCache().release(m_mysql, m_extra->preparedTemplate, m_stmt);
+          m_stmt = nullptr;
+          return error<async::Error>("[oatpp::mariadb::Executor::executeAsync()]: Error. "
+                                     "LongData parameters are not supported - use execute().");
+        }
+      }
+
+      record(metrics::TemplateMetrics::Phase::BIND, bindStart);
+
+      if (m_extra->changesSession) {
+        getMysqlConnection()->setSessionDirty(true);
+      }
+
+      m_result = std::make_shared<QueryResult>(m_stmt, m_connection, m_executor->m_resultMapper, m_typeResolver,
+                                               m_extra->preparedTemplate, m_bindContext, 0, false, false,
+                                               m_extra->metrics);
+      m_stmt = nullptr; // owned by the result now
+      return m_result->executeAsync().next(yieldTo(&ExecuteCoroutine::onExecuted));
+
+    }
+
+    Action onExecuted() {
+      if (m_extra->isWrite) {
+        m_executor->invalidateResultCache(m_extra->tables, m_connection);
+      }
+      return _return(m_result);
+    }
+
+    Action handleError(async::Error* error) override {
+      if (m_acquiring) {
+        m_acquiring = false;
+        m_executor->recordAcquisition(m_acquireStart, false);
+      }
+      if (m_stmt) {
+        // Interrupted during the reset/prepare call - the connection is in the middle of a command and can't be
+        // used any more. Its handle is closed first, so closing the statement only frees client-side memory.
+        auto mysqlConnection = getMysqlConnection();
+        MYSQL* handle = mysqlConnection->getHandle();
+        if (handle) {
+          mysql_close(handle);
+          mysqlConnection->setHandle(nullptr); // -> Health::CLOSED, cached statements are freed
+        }
+        if (m_connection.invalidator) {
+          m_connection.invalidator->invalidate(m_connection.object);
+        }
+        mysql_stmt_close(m_stmt);
+        m_stmt = nullptr;
+      }
+      return async::AbstractCoroutine::handleError(error);
+    }
+
+  };
+
+  return ExecuteCoroutine::startForResult(this, queryTemplate, params, typeResolver, connection);
+
+}
+
+oatpp::Void Executor::resolveBatchParam(const StringTemplate& queryTemplate,
+                                        ql_template::Parser::TemplateExtra& extra,
+                                        v_uint32 paramIndex,
+                                        const std::unordered_map<oatpp::String, oatpp::Void>& params) {
+  auto& parameter = extra.parameters[paramIndex];
+  auto it = params.find(parameter.name);
+  if (it == params.end()) {
+    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::executeBatch()]: Error. Parameter is missing in a batch row. Parameter name: ") +
+                             queryTemplate.getTemplateVariables()[paramIndex].name->c_str());
+  }
+  auto value = resolveParam(parameter, it->second, *m_defaultTypeResolver);
+  if (value.getValueType()->classId.id == oatpp::Void::Class::CLASS_ID.id) {
+    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::executeBatch()]: Error. Can't resolve parameter type. Parameter name: ") +
+                             queryTemplate.getTemplateVariables()[paramIndex].name->c_str());
+  }
+  return value;
+}
+
+void Executor::executeBatchStatement(MYSQL_STMT* stmt, const std::shared_ptr<Connection>& connection, BatchResult& result) {
+  if (mysql_stmt_execute(stmt)) {
+    std::string error = mysql_stmt_error(stmt);
+    connection->reportError(mysql_stmt_errno(stmt));
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeBatch()]: Error. Batch execution failed: " + error);
+  }
+  auto affected = static_cast<v_int64>(mysql_stmt_affected_rows(stmt));
+  result.affectedRows += affected;
+  result.batchAffectedRows.push_back(affected);
+}
+
+void Executor::executeArrayBound(const std::shared_ptr<Connection>& connection,
+                                 const StringTemplate& queryTemplate,
+                                 const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& paramsList,
+                                 v_uint32 batchSize,
+                                 BatchResult& result) {
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  auto conn = connection->getHandle();
+  auto& statementCache = connection->getStatementCache();
+  MYSQL_STMT* stmt = statementCache.acquire(conn, extra->preparedTemplate);
+
+  try {
+
+    auto paramCount = static_cast<v_uint32>(extra->parameters.size());
+
+    for (size_t offset = 0; offset < paramsList.size(); offset += batchSize) {
+
+      auto rowCount = static_cast<v_uint32>(std::min<size_t>(batchSize, paramsList.size() - offset));
+      mapping::BatchSerializer::Batch batch(paramCount, rowCount);
+
+      for (v_uint32 row = 0; row < rowCount; row++) {
+        auto& params = paramsList[offset + row];
+        for (v_uint32 i = 0; i < paramCount; i++) {
+          m_batchSerializer->serialize(batch, i, row, resolveBatchParam(queryTemplate, *extra, i, params));
+        }
+      }
+
+      batch.bind(stmt);
+      executeBatchStatement(stmt, connection, result);
+
+    }
+
+  } catch (...) {
+    mapping::BatchSerializer::resetArraySize(stmt);
+    statementCache.release(connection->isHealthy() ? conn : nullptr, extra->preparedTemplate, stmt, true);
+    throw;
+  }
+
+  mapping::BatchSerializer::resetArraySize(stmt);
+  statementCache.release(conn, extra->preparedTemplate, stmt);
+
+}
+
+oatpp::String Executor::getExpandedTemplate(ql_template::Parser::TemplateExtra& extra, v_uint32 rowCount) {
+  std::lock_guard<std::mutex> lock(extra.expandedTemplatesMutex);
+  auto& expanded = extra.expandedTemplates[rowCount];
+  if (!expanded) {
+    expanded = ql_template::Parser::expandInsertValues(extra.preparedTemplate, extra.valuesStart, extra.valuesEnd, rowCount);
+  }
+  return expanded;
+}
+
+void Executor::executeMultiRowValues(const std::shared_ptr<Connection>& connection,
+                                     const StringTemplate& queryTemplate,
+                                     const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& paramsList,
+                                     v_uint32 batchSize,
+                                     BatchResult& result) {
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  auto conn = connection->getHandle();
+  auto& statementCache = connection->getStatementCache();
+  auto paramCount = static_cast<v_uint32>(extra->parameters.size());
+
+  // Leave room for packet headers and the statement id
+  v_uint64 maxPacket = connection->getMaxAllowedPacket();
+  if (maxPacket == 0) {
+    maxPacket = ConnectionOptions().maxAllowedPacket;
+  }
+  const v_uint64 packetLimit = maxPacket - std::min<v_uint64>(maxPacket / 8, 64 * 1024);
+
+  const v_uint64 baseSize = extra->preparedTemplate->size() - (extra->valuesEnd - extra->valuesStart);
+  const v_uint64 rowTextSize = extra->valuesEnd - extra->valuesStart + 1;
+
+  // server limit of placeholders per prepared statement
+  v_uint32 maxRows = std::min<v_uint32>(batchSize, 65535 / std::max<v_uint32>(paramCount, 1));
+  maxRows = std::max<v_uint32>(maxRows, 1);
+
+  std::vector<oatpp::Void> values;
+  size_t offset = 0;
+
+  while (offset < paramsList.size()) {
+
+    // resolve rows until the statement text or the parameters packet would exceed max_allowed_packet
+    values.clear();
+    v_uint32 rowCount = 0;
+    v_uint64 textSize = baseSize;
+    v_uint64 paramsSize = 0;
+
+    while (offset + rowCount < paramsList.size() && rowCount < maxRows) {
+
+      auto& params = paramsList[offset + rowCount];
+      v_uint64 rowParamsSize = 0;
+      auto rowBegin = values.size();
+      for (v_uint32 i = 0; i < paramCount; i++) {
+        auto value = resolveBatchParam(queryTemplate, *extra, i, params);
+        if (value && value.getValueType()->classId.id == oatpp::String::Class::CLASS_ID.id) {
+          rowParamsSize += value.cast<oatpp::String>()->size();
+        }
+        rowParamsSize += 11; // type, length prefix and fixed-size value
+        values.push_back(value);
+      }
+
+      if (rowCount > 0 && (textSize + rowTextSize > packetLimit || paramsSize + rowParamsSize > packetLimit)) {
+        values.resize(rowBegin);
+        break;
+      }
+
+      textSize += rowTextSize;
+      paramsSize += rowParamsSize;
+      rowCount++;
+
+    }
+
+    // round down to a power of two so only log2(maxRows) distinct statements are ever prepared
+    v_uint32 bucket = 1;
+    while (bucket * 2 <= rowCount) {
+      bucket *= 2;
+    }
+
+    auto query = getExpandedTemplate(*extra, bucket);
+    MYSQL_STMT* stmt = statementCache.acquire(conn, query);
+
+    bool longData = false;
+    try {
+      mapping::Serializer::BindContext context(bucket * paramCount);
+      for (v_uint32 i = 0; i < bucket * paramCount; i++) {
+        if (values[i]) {
+          m_serializer->serialize(context, i, values[i]);
+        }
+      }
+      longData = context.hasLongData();
+      context.bind(stmt);
+      executeBatchStatement(stmt, connection, result);
+    } catch (...) {
+      statementCache.release(connection->isHealthy() ? conn : nullptr, query, stmt, true);
+      throw;
+    }
+
+    statementCache.release(conn, query, stmt, longData);
+    offset += bucket;
+
+  }
+
+}
+
+void Executor::executeRowByRow(const std::shared_ptr<Connection>& connection,
+                               const StringTemplate& queryTemplate,
+                               const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& paramsList,
+                               BatchResult& result) {
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  auto conn = connection->getHandle();
+  auto& statementCache = connection->getStatementCache();
+  MYSQL_STMT* stmt = statementCache.acquire(conn, extra->preparedTemplate);
+
+  bool longData = false;
+  try {
+    for (auto& params : paramsList) {
+      mapping::Serializer::BindContext context(static_cast<v_uint32>(extra->parameters.size()));
+      bindParams(stmt, context, queryTemplate, params, m_defaultTypeResolver);
+      longData = longData || context.hasLongData();
+      executeBatchStatement(stmt, connection, result);
+    }
+  } catch (...) {
+    statementCache.release(connection->isHealthy() ? conn : nullptr, extra->preparedTemplate, stmt, true);
+    throw;
+  }
+
+  statementCache.release(conn, extra->preparedTemplate, stmt, longData);
+
+}
+
+Executor::BatchResult Executor::executeBatch(const StringTemplate& queryTemplate,
+                                            const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& paramsList,
+                                            const provider::ResourceHandle<orm::Connection>& connection,
+                                            v_uint32 batchSize,
+                                            BatchMode mode) {
+
+  BatchResult result;
+  if (paramsList.empty()) {
+    return result;
+  }
+
+  if (batchSize == 0) {
+    batchSize = DEFAULT_BATCH_SIZE;
+  }
+
+  auto connectionHandle = connection;
+  if (!connectionHandle) {
+    connectionHandle = getConnection();
+  }
+
+  auto mysqlConnection = std::static_pointer_cast<mariadb::Connection>(connectionHandle.object);
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  auto conn = mysqlConnection->getHandle();
+
+  if (!conn || !mysqlConnection->isHealthy()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeBatch()]: Error. Connection is broken or closed.");
+  }
+  if (mysqlConnection->isBusy()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeBatch()]: Error. Connection is busy reading a previous result.");
+  }
+
+  const bool expandable = extra->valuesStart >= 0 && !queryTemplate.getTemplateVariables().empty();
+
+  if (mode == BatchMode::AUTO) {
+    if (mysqlConnection->supportsBulkOperations()) {
+      mode = BatchMode::ARRAY_BINDING;
+    } else if (expandable) {
+      mode = BatchMode::MULTI_ROW_VALUES;
+    } else {
+      mode = BatchMode::ROW_BY_ROW;
+    }
+  } else if (mode == BatchMode::ARRAY_BINDING && !mysqlConnection->supportsBulkOperations()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeBatch()]: Error. Server doesn't support bulk operations.");
+  } else if (mode == BatchMode::MULTI_ROW_VALUES && !expandable) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeBatch()]: Error. "
+                             "Query template is not a single-row 'INSERT ... VALUES (...)' statement. Template: " +
+                             std::string(extra->templateName ? extra->templateName->c_str() : ""));
+  }
+
+  if (extra->changesSession) {
+    mysqlConnection->setSessionDirty(true);
+  }
+
+  try {
+    switch (mode) {
+      case BatchMode::ARRAY_BINDING:
+        executeArrayBound(mysqlConnection, queryTemplate, paramsList, batchSize, result);
+        break;
+      case BatchMode::MULTI_ROW_VALUES:
+        executeMultiRowValues(mysqlConnection, queryTemplate, paramsList, batchSize, result);
+        break;
+      default:
+        executeRowByRow(mysqlConnection, queryTemplate, paramsList, result);
+    }
+  } catch (...) {
+    mysqlConnection->reportError(mysql_errno(conn)); // prepare errors are reported on the connection handle
+    if (!mysqlConnection->isHealthy() && connectionHandle.invalidator) {
+      connectionHandle.invalidator->invalidate(connectionHandle.object);
+    }
+    // batches executed before the failure stay applied unless the caller's transaction is rolled back
+    if (extra->isWrite) {
+      invalidateResultCache(extra->tables, connectionHandle);
+    }
+    throw;
+  }
+
+  if (extra->isWrite) {
+    invalidateResultCache(extra->tables, connectionHandle);
+  }
+
+  return result;
+
+}
+
 std::shared_ptr<orm::QueryResult> Executor::execute(const oatpp::String& query,
                                              const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                              const provider::ResourceHandle<orm::Connection>& connection) {
@@ -220,20 +987,73 @@ std::shared_ptr<orm::QueryResult> Executor::execute(const oatpp::String& query,
   if (!mysql) {
     throw std::runtime_error(std::string("[oatpp::mariadb::Executor::execute]: MySQL connection handle is null"));
   }
+  if (mysqlConnection->isBusy()) {
+    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::execute]: Connection is busy reading a previous result."));
+  }
 
-  MYSQL_STMT* stmt = mysql_stmt_init(mysql);
-  if (!stmt) {
-    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::execute]: Failed to initialize statement"));
+  if (ql_template::Parser::changesSession(query)) {
+    mysqlConnection->setSessionDirty(true);
   }
 
-  if (mysql_stmt_prepare(stmt, query->c_str(), query->size())) {
-    auto error = std::string(mysql_stmt_error(stmt));
-    mysql_stmt_close(stmt);
-    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::execute]: Statement prepare error: ") + error);
+  // No parameters - one mysql_real_query round trip instead of prepare + execute
+  return std::make_shared<TextQueryResult>(query, connection, m_textResultMapper,
+                                           typeResolver ? typeResolver : m_defaultTypeResolver);
+}
+
+std::shared_ptr<TextQueryResult> Executor::executeMulti(const std::vector<oatpp::String>& queries,
+                                                       const provider::ResourceHandle<orm::Connection>& connection) {
+
+  auto connectionHandle = connection;
+  if (!connectionHandle) {
+    connectionHandle = getConnection();
+  }
+
+  auto mysqlConnection = std::static_pointer_cast<mariadb::Connection>(connectionHandle.object);
+  if (!mysqlConnection->getHandle() || !mysqlConnection->isHealthy()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeMulti()]: Error. Connection is broken or closed.");
+  }
+  if (mysqlConnection->isBusy()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeMulti()]: Error. Connection is busy reading a previous result.");
   }
 
-  auto resultMapper = std::make_shared<mapping::ResultMapper>();
-  return std::make_shared<QueryResult>(stmt, connection, resultMapper, typeResolver);
+  // e.g. {"SELECT 1;", "SELECT 2"} -> "SELECT 1;\nSELECT 2"
+  std::string sql;
+  for (auto& query : queries) {
+    if (!query) {
+      continue;
+    }
+    std::string statement = *query;
+    while (!statement.empty() && (statement.back() == ';' || std::isspace(static_cast<unsigned char>(statement.back())))) {
+      statement.pop_back();
+    }
+    if (statement.empty()) {
+      continue;
+    }
+    if (!sql.empty()) {
+      sql += ";\n";
+    }
+    sql += statement;
+  }
+
+  if (sql.empty()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeMulti()]: Error. No statements to execute.");
+  }
+
+  for (auto& query : queries) {
+    if (ql_template::Parser::changesSession(query)) {
+      mysqlConnection->setSessionDirty(true);
+      break;
+    }
+  }
+
+  auto result = std::make_shared<TextQueryResult>(sql, connectionHandle, m_textResultMapper, m_defaultTypeResolver);
+
+  for (auto& query : queries) {
+    invalidateResultCache(query, connectionHandle);
+  }
+
+  return result;
+
 }
 
 std::shared_ptr<orm::QueryResult> Executor::executeRaw(const oatpp::String& query,
@@ -244,24 +1064,31 @@ std::shared_ptr<orm::QueryResult> Executor::executeRaw(const oatpp::String& quer
   }
 
   auto mysqlConnection = std::static_pointer_cast<mariadb::Connection>(connectionHandle.object);
-  
-  MYSQL_STMT* stmt = mysql_stmt_init(mysqlConnection->getHandle());
-  if (!stmt) {
-    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::executeRaw()]: Error. Can't create MYSQL_STMT. Error: ") + 
-                           mysql_error(mysqlConnection->getHandle()));
+  if (!mysqlConnection->getHandle() || !mysqlConnection->isHealthy()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeRaw()]: Error. Connection is broken or closed.");
+  }
+  if (mysqlConnection->isBusy()) {
+    throw std::runtime_error("[oatpp::mariadb::Executor::executeRaw()]: Error. Connection is busy reading a previous result.");
   }
 
-  if (mysql_stmt_prepare(stmt, query->c_str(), query->size())) {
-    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::executeRaw()]: Error. Can't prepare MYSQL_STMT. Query: ") + 
-                           query->c_str() + " Error: " + mysql_stmt_error(stmt));
+  if (ql_template::Parser::changesSession(query)) {
+    mysqlConnection->setSessionDirty(true);
   }
 
-  if (mysql_stmt_execute(stmt)) {
-    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::executeRaw()]: Error. Can't execute MYSQL_STMT. Query: ") + 
-                           query->c_str() + " Error: " + mysql_stmt_error(stmt));
+  auto result = std::make_shared<TextQueryResult>(query, connectionHandle, m_textResultMapper, m_defaultTypeResolver);
+  invalidateResultCache(query, connectionHandle);
+
+  // the server stops at the first failing statement of a script - its error comes with that statement's result
+  while (result->isSuccess() && result->hasMoreResultSets()) {
+    result->nextResultSet();
+  }
+  if (!result->isSuccess()) {
+    throw std::runtime_error(std::string("[oatpp::mariadb::Executor::executeRaw()]: Error. Can't execute query. Query: ") +
+                             query->c_str() + " Statement index: " + std::to_string(result->getResultSetIndex()) +
+                             " Error: " + result->getErrorMessage()->c_str());
   }
 
-  return std::make_shared<mariadb::QueryResult>(stmt, connectionHandle, m_resultMapper, nullptr);
+  return result;
 }
 
 std::shared_ptr<orm::QueryResult> Executor::begin(const provider::ResourceHandle<orm::Connection>& connection) {
@@ -269,11 +1096,19 @@ std::shared_ptr<orm::QueryResult> Executor::begin(const provider::ResourceHandle
 }
 
 std::shared_ptr<orm::QueryResult> Executor::commit(const provider::ResourceHandle<orm::Connection>& connection) {
-  return execute("COMMIT;", nullptr, connection);
+  auto result = execute("COMMIT;", nullptr, connection);
+  if (m_resultCache) {
+    m_resultCache->commit(connection.object.get());
+  }
+  return result;
 }
 
 std::shared_ptr<orm::QueryResult> Executor::rollback(const provider::ResourceHandle<orm::Connection>& connection) {
-  return execute("ROLLBACK;", nullptr, connection);
+  auto result = execute("ROLLBACK;", nullptr, connection);
+  if (m_resultCache) {
+    m_resultCache->rollback(connection.object.get());
+  }
+  return result;
 }
 
 void Executor::rollbackToSavepoint(const provider::ResourceHandle<orm::Connection>& connection, const String& savepointName) {
@@ -446,9 +1281,14 @@ void Executor::migrateSchema(const oatpp::String& script,
 
     // Execute migration script
     OATPP_LOGD("migrateSchema", "Executing migration script for version %lld", newVersion);
-    auto scriptResult = executeRaw(script, connection);
-    if (!scriptResult->isSuccess()) {
-      auto errorMsg = scriptResult->getErrorMessage();
+    // executeRaw reads the results of all statements of the script and throws on the first failing one
+    oatpp::String errorMsg;
+    try {
+      executeRaw(script, connection);
+    } catch (const std::exception& e) {
+      errorMsg = e.what();
+    }
+    if (errorMsg) {
       OATPP_LOGE("migrateSchema", "Migration script failed: %s", errorMsg->c_str());
       
       // Log failure
@@ -5,16 +5,106 @@
 #include "ConnectionProvider.hpp"
 #include "Connection.hpp"
 #include "QueryResult.hpp"
+#include "ResultCache.hpp"
+#include "TextQueryResult.hpp"
+#include "metrics/Histogram.hpp"
+#include "metrics/QueryMetrics.hpp"
 #include "mapping/Serializer.hpp"
+#include "mapping/BatchSerializer.hpp"
+#include "types/LongData.hpp"
 #include "ql_template/Parser.hpp"
 #include "ql_template/TemplateValueProvider.hpp"
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <mutex>
+#include <unordered_map>
 
 #include "oatpp/orm/Executor.hpp"
 
 namespace oatpp { namespace mariadb {
 
 class Executor : public orm::Executor {
+public:
+
+  /**
+   * Default maximum number of parameter rows sent in one array-bound execution.
+   */
+  static constexpr v_uint32 DEFAULT_BATCH_SIZE = 1000;
+
+  /**
+   * Default number of rows fetched from the server at once when reading through a cursor.
+   */
+  static constexpr v_uint32 DEFAULT_CURSOR_PREFETCH_ROWS = 1000;
+
+  /**
+   * How &l:Executor::executeBatch (); sends parameter rows to the server.
+   */
+  enum class BatchMode : v_int32 {
+
+    /**
+     * `ARRAY_BINDING` if the server supports bulk operations, otherwise `MULTI_ROW_VALUES` if the template
+     * is a single-row `INSERT ... VALUES (...)`, otherwise `ROW_BY_ROW`.
+     */
+    AUTO = 0,
+
+    /**
+     * MariaDB array binding (`STMT_ATTR_ARRAY_SIZE`). One execution per batch.
+     */
+    ARRAY_BINDING = 1,
+
+    /**
+     * `INSERT ... VALUES (...)` expanded to `VALUES (...),(...),...`. One execution per chunk.
+     * Chunks are bounded by `max_allowed_packet` and rounded down to a power of two rows.
+     */
+    MULTI_ROW_VALUES = 2,
+
+    /**
+     * One execution per row.
+     */
+    ROW_BY_ROW = 3
+
+  };
+
+  /**
+   * Result of &l:Executor::executeBatch ();.
+   */
+  struct BatchResult {
+
+    /**
+     * Total number of affected rows.
+     */
+    v_int64 affectedRows = 0;
+
+    /**
+     * Number of affected rows of each executed batch.
+     */
+    std::vector<v_int64> batchAffectedRows;
+
+  };
+
+  /**
+   * Connections taken by the executor - see &l:Executor::getConnectionStats ();. Latencies are in microseconds.
+   */
+  struct ConnectionStats {
+
+    /**
+     * Connections taken from the provider.
+     */
+    v_uint64 acquisitions = 0;
+
+    /**
+     * Attempts which got no connection - the provider threw, returned nothing or timed out.
+     */
+    v_uint64 failures = 0;
+
+    /**
+     * Time spent waiting for the provider, successful acquisitions only.
+     */
+    metrics::Histogram::Snapshot acquireWait;
+
+  };
+
 private:
   /*
    * We need this invalidator to correlate abstract orm::Connection to its correct invalidator.
@@ -28,23 +118,94 @@ private:
   std::shared_ptr<ConnectionInvalidator> m_connectionInvalidator;
   std::shared_ptr<provider::Provider<Connection>> m_connectionProvider;
   std::shared_ptr<mapping::Serializer> m_serializer;
+  std::shared_ptr<mapping::BatchSerializer> m_batchSerializer;
   std::shared_ptr<mapping::ResultMapper> m_resultMapper;
+  std::shared_ptr<mapping::TextResultMapper> m_textResultMapper;
   std::shared_ptr<data::mapping::TypeResolver> m_defaultTypeResolver;
+  std::unordered_map<oatpp::String, v_uint32> m_templateCursors;
+  std::mutex m_templateCursorsMutex;
+  std::shared_ptr<ResultCache> m_resultCache;
+  std::unordered_map<oatpp::String, std::chrono::milliseconds> m_templateResultCacheTtls;
+  std::mutex m_templateResultCacheMutex;
+  std::atomic<v_uint64> m_connectionAcquisitions;
+  std::atomic<v_uint64> m_connectionFailures;
+  metrics::Histogram m_connectionAcquireWait;
+  std::shared_ptr<metrics::QueryMetrics> m_queryMetrics;
 
 private:
-  struct QueryParameter {
-    oatpp::String name;
-    std::vector<std::string> propertyPath;
-  };
 
-  QueryParameter parseQueryParameter(const oatpp::String& paramName);
+  /**
+   * Resolve the value of a template parameter. DTO property paths are followed through the property chain
+   * cached in the parameter, other values go through the type resolver.
+   * @param parameter - precompiled parameter of the template.
+   * @param value - value of the parameter from the params map.
+   * @param typeResolver - type resolver.
+   * @return - resolved value.
+   */
+  static oatpp::Void resolveParam(ql_template::Parser::TemplateExtra::Parameter& parameter,
+                                  const oatpp::Void& value,
+                                  const data::mapping::TypeResolver& typeResolver);
+
+  std::shared_ptr<orm::QueryResult> executePrepared(const StringTemplate& queryTemplate,
+                                                    const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                    const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                    const provider::ResourceHandle<orm::Connection>& connection,
+                                                    v_uint32 cursorPrefetchRows,
+                                                    bool streaming);
+
+  void serializeParams(mapping::Serializer::BindContext& context,
+                       const StringTemplate& queryTemplate,
+                       const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                       const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver);
 
-private:
   void bindParams(MYSQL_STMT* stmt,
+                  mapping::Serializer::BindContext& context,
                   const StringTemplate& queryTemplate,
                   const std::unordered_map<oatpp::String, oatpp::Void>& params,
                   const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver);
 
+  /**
+   * Drop cached results reading the written tables. Writes made inside a transaction are invalidated once more
+   * when it's committed through this executor.
+   * @param tables - written tables. Empty - all cached results are dropped.
+   * @param connection - connection the write was executed on.
+   */
+  void invalidateResultCache(const std::vector<std::string>& tables, const provider::ResourceHandle<orm::Connection>& connection);
+
+  /**
+   * Invalidate cached results if the text protocol statement is a write - see &id:oatpp::mariadb::ql_template::Parser::findTables;.
+   * @param query - SQL statement.
+   * @param connection - connection the statement was executed on.
+   */
+  void invalidateResultCache(const oatpp::String& query, const provider::ResourceHandle<orm::Connection>& connection);
+
+private:
+  oatpp::Void resolveBatchParam(const StringTemplate& queryTemplate,
+                                ql_template::Parser::TemplateExtra& extra,
+                                v_uint32 paramIndex,
+                                const std::unordered_map<oatpp::String, oatpp::Void>& params);
+
+  void executeBatchStatement(MYSQL_STMT* stmt, const std::shared_ptr<Connection>& connection, BatchResult& result);
+
+  void executeArrayBound(const std::shared_ptr<Connection>& connection,
+                         const StringTemplate& queryTemplate,
+                         const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& paramsList,
+                         v_uint32 batchSize,
+                         BatchResult& result);
+
+  oatpp::String getExpandedTemplate(ql_template::Parser::TemplateExtra& extra, v_uint32 rowCount);
+
+  void executeMultiRowValues(const std::shared_ptr<Connection>& connection,
+                             const StringTemplate& queryTemplate,
+                             const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& paramsList,
+                             v_uint32 batchSize,
+                             BatchResult& result);
+
+  void executeRowByRow(const std::shared_ptr<Connection>& connection,
+                       const StringTemplate& queryTemplate,
+                       const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& paramsList,
+                       BatchResult& result);
+
   bool isDeadlockError(const char* error) {
     return error && (strstr(error, "Deadlock") != nullptr || 
                     strstr(error, "Lock wait timeout") != nullptr);
@@ -95,6 +256,54 @@ private:
   void validateSchemaVersion(v_int64 currentVersion, v_int64 newVersion);
 
 protected:
+
+  /**
+   * Wrap a connection taken from a provider into a handle returned to the user.
+   * Throws `std::runtime_error` if there is no connection.
+   * @param connection - connection from the provider.
+   * @return - connection handle.
+   */
+  provider::ResourceHandle<orm::Connection> wrapConnection(const provider::ResourceHandle<Connection>& connection);
+
+  /**
+   * Take a connection and record it in &l:Executor::getConnectionStats ();.
+   * @param acquire - takes the connection from a provider.
+   * @return - connection from the provider.
+   */
+  provider::ResourceHandle<Connection> measureAcquisition(const std::function<provider::ResourceHandle<Connection>()>& acquire);
+
+  /**
+   * Record a connection acquisition in &l:Executor::getConnectionStats ();.
+   * @param start - when the connection was asked for.
+   * @param success - `true` if a connection was taken.
+   */
+  void recordAcquisition(std::chrono::steady_clock::time_point start, bool success);
+
+  /**
+   * Take a connection to execute a template on when the caller didn't pass one. <br>
+   * Extension point for routing - the default implementation takes it from the connection provider of the executor.
+   * @param extra - parsed template.
+   * @return - connection from the provider.
+   */
+  virtual provider::ResourceHandle<Connection> acquireConnection(const ql_template::Parser::TemplateExtra& extra);
+
+  /**
+   * Take a connection to execute a template on asynchronously when the caller didn't pass one.
+   * See &l:Executor::acquireConnection ();.
+   * @param extra - parsed template.
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of the connection from the provider.
+   */
+  virtual async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&>
+  acquireConnectionAsync(const ql_template::Parser::TemplateExtra& extra);
+
+  /**
+   * Execute a parameterless statement (`START TRANSACTION`, `COMMIT`, `SAVEPOINT`, ...) over the text protocol.
+   * Errors are reported by the result.
+   * @param query - SQL query string.
+   * @param typeResolver - type resolver. `nullptr` - default type resolver.
+   * @param connection - database connection.
+   * @return - &id:oatpp::mariadb::TextQueryResult;.
+   */
   std::shared_ptr<orm::QueryResult> execute(const oatpp::String& query,
                                           const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                           const provider::ResourceHandle<orm::Connection>& connection);
@@ -124,6 +333,73 @@ public:
    */
   provider::ResourceHandle<orm::Connection> getConnection() override;
 
+  /**
+   * Get metrics of connections taken by the executor - by &l:Executor::getConnection (); and by templates executed
+   * without a connection. Wait time includes everything the provider does - waiting for a pooled connection or
+   * opening a new one. For pool internals see &id:oatpp::mariadb::ConnectionPool::getStats;.
+   * @return - &l:Executor::ConnectionStats;.
+   */
+  ConnectionStats getConnectionStats() const;
+
+  /**
+   * Reset connection metrics.
+   */
+  void resetConnectionStats();
+
+  /**
+   * Record per-template latency histograms of prepared template executions, split by
+   * &id:oatpp::mariadb::metrics::TemplateMetrics::Phase; - connection acquisition, statement preparation, parameter
+   * binding, execution, result storing and row mapping. Batches, raw and multi statements are not recorded. <br>
+   * Applies to templates parsed by &l:Executor::parseQueryTemplate (); after this call - enable before creating the
+   * `DbClient` that declares the queries.
+   * @param config - &id:oatpp::mariadb::metrics::QueryMetrics::Config;.
+   * @return - &id:oatpp::mariadb::metrics::QueryMetrics;.
+   */
+  std::shared_ptr<metrics::QueryMetrics> enableQueryMetrics(const metrics::QueryMetrics::Config& config = metrics::QueryMetrics::Config());
+
+  /**
+   * Get query metrics.
+   * @return - &id:oatpp::mariadb::metrics::QueryMetrics; or `nullptr` if they are not enabled.
+   */
+  std::shared_ptr<metrics::QueryMetrics> getQueryMetrics() const;
+
+  /**
+   * Read results of the named template through a server-side read-only cursor. <br>
+   * Applies to templates parsed by &l:Executor::parseQueryTemplate (); after this call - configure the executor
+   * before creating the `DbClient` that declares the query.
+   * @param templateName - template name (name of the `QUERY`).
+   * @param prefetchRows - rows fetched from the server at once. `0` - store results client-side (default).
+   */
+  void setTemplateCursor(const oatpp::String& templateName, v_uint32 prefetchRows = DEFAULT_CURSOR_PREFETCH_ROWS);
+
+  /**
+   * Enable the cross-query &id:oatpp::mariadb::ResultCache; of this executor. <br>
+   * Results of templates marked with &l:Executor::setTemplateResultCache (); are then served from the cache without
+   * a connection, and every write executed through this executor - templates, batches, raw and multi statements -
+   * drops the cached results reading the written tables. Call before queries are executed.
+   * @param config - &id:oatpp::mariadb::ResultCache::Config;.
+   * @return - &id:oatpp::mariadb::ResultCache;.
+   */
+  std::shared_ptr<ResultCache> enableResultCache(const ResultCache::Config& config = ResultCache::Config());
+
+  /**
+   * Get the result cache.
+   * @return - &id:oatpp::mariadb::ResultCache; or `nullptr` if it's not enabled.
+   */
+  std::shared_ptr<ResultCache> getResultCache() const;
+
+  /**
+   * Keep results of the named template in the &id:oatpp::mariadb::ResultCache;. For reference data read much more
+   * often than it's written. <br>
+   * Results are keyed by the bound parameter values and stored once they are fetched to the end. Executions on a
+   * connection inside a transaction and &l:Executor::executeAsync (); bypass the cache. Applies to templates parsed
+   * by &l:Executor::parseQueryTemplate (); after this call - configure the executor before creating the `DbClient`
+   * that declares the query.
+   * @param templateName - template name (name of the `QUERY`).
+   * @param ttl - time to live of the cached results. `0` - default TTL of the cache.
+   */
+  void setTemplateResultCache(const oatpp::String& templateName, std::chrono::milliseconds ttl = std::chrono::milliseconds(0));
+
   /**
    * Parse query template.
    * @param name - template name.
@@ -150,6 +426,61 @@ public:
                                             const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
                                             const provider::ResourceHandle<orm::Connection>& connection = nullptr)  override;
 
+  /**
+   * Execute database query using a query template and read its result through a server-side read-only cursor
+   * (`STMT_ATTR_CURSOR_TYPE = CURSOR_TYPE_READ_ONLY`). <br>
+   * The result set is not stored client-side - &id:oatpp::orm::QueryResult::fetch; pulls `prefetchRows` rows
+   * per server round trip, so memory stays bounded by the fetched window for results of any size.
+   * @param queryTemplate - a query template obtained in a prior call to &l:Executor::parseQueryTemplate (); method.
+   * @param params - query parameters.
+   * @param prefetchRows - rows fetched from the server at once (`STMT_ATTR_PREFETCH_ROWS`).
+   * @param typeResolver - type resolver.
+   * @param connection - database connection.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  std::shared_ptr<orm::QueryResult> executeWithCursor(const StringTemplate& queryTemplate,
+                                                      const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                      v_uint32 prefetchRows = DEFAULT_CURSOR_PREFETCH_ROWS,
+                                                      const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+                                                      const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Execute database query using a query template and read its result unbuffered. <br>
+   * `mysql_stmt_store_result` is skipped - rows are read off the wire as &id:oatpp::orm::QueryResult::fetch;
+   * maps them, so memory is bounded by the fetched rows. &id:oatpp::orm::QueryResult::hasMoreToFetch; and
+   * `fetch(type, count)` work incrementally. Until all rows are fetched or the result is destroyed the connection
+   * is busy (&id:oatpp::mariadb::Connection::isBusy;) and executing anything else on it throws.
+   * @param queryTemplate - a query template obtained in a prior call to &l:Executor::parseQueryTemplate (); method.
+   * @param params - query parameters.
+   * @param typeResolver - type resolver.
+   * @param connection - database connection.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  std::shared_ptr<orm::QueryResult> executeStreaming(const StringTemplate& queryTemplate,
+                                                     const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                     const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+                                                     const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Execute database query using a query template without blocking the coroutine processor. <br>
+   * The connection is obtained with &id:oatpp::provider::Provider::getAsync; if not given.
+   * Statement reset/prepare, execution and reading of the result set run on the Connector/C non-blocking API,
+   * the coroutine waits for the connection socket between the calls. Parameters are bound the same way as in
+   * &l:Executor::execute ();. The returned result is fully buffered - fetching from it doesn't block.
+   * Cursor settings of the template are ignored. &id:oatpp::mariadb::types::LongData; parameters are not supported -
+   * they are sent with blocking calls, so the coroutine fails with an error before anything is sent.
+   * @param queryTemplate - a query template obtained in a prior call to &l:Executor::parseQueryTemplate (); method.
+   * @param params - query parameters.
+   * @param typeResolver - type resolver.
+   * @param connection - database connection.
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of &id:oatpp::orm::QueryResult;.
+   */
+  async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+  executeAsync(const StringTemplate& queryTemplate,
+               const std::unordered_map<oatpp::String, oatpp::Void>& params,
+               const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+               const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
   /**
    * Execute database query using a query template without parameters.
    * @param queryTemplate - a query template obtained in a prior call to &l:Executor::parseQueryTemplate (); method.
@@ -160,10 +491,77 @@ public:
                                           const provider::ResourceHandle<orm::Connection>& connection = nullptr);
 
   /**
-   * Execute raw SQL query.
+   * Execute query template once for each row of parameters. <br>
+   * Rows are sent in batches of `batchSize` using MariaDB array binding (`STMT_ATTR_ARRAY_SIZE`),
+   * so each batch is a single round trip. If the server doesn't support bulk operations a single-row
+   * `INSERT ... VALUES (...)` template is expanded to multi-row `VALUES`, other templates are executed row by row.
+   * All rows must bind the same parameter types. `NULL`s are allowed anywhere.
+   * @param queryTemplate - a query template obtained in a prior call to &l:Executor::parseQueryTemplate (); method.
+   * @param paramsList - query parameters, one map per row.
+   * @param connection - database connection.
+   * @param batchSize - maximum number of rows per execution.
+   * @param mode - &l:Executor::BatchMode;.
+   * @return - &l:Executor::BatchResult;.
+   */
+  BatchResult executeBatch(const StringTemplate& queryTemplate,
+                           const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& paramsList,
+                           const provider::ResourceHandle<orm::Connection>& connection = nullptr,
+                           v_uint32 batchSize = DEFAULT_BATCH_SIZE,
+                           BatchMode mode = BatchMode::AUTO);
+
+  /**
+   * Execute query template once for each element of the vector. <br>
+   * Each element is bound as parameter `paramName`, so the template refers to its fields as `:paramName.field`.
+   * @tparam T - element type, usually `oatpp::Object<Dto>`.
+   * @param queryTemplate - a query template obtained in a prior call to &l:Executor::parseQueryTemplate (); method.
+   * @param paramName - name of the parameter each element is bound to.
+   * @param rows - elements.
+   * @param connection - database connection.
+   * @param batchSize - maximum number of rows per execution.
+   * @param mode - &l:Executor::BatchMode;.
+   * @return - &l:Executor::BatchResult;.
+   */
+  template<class T>
+  BatchResult executeBatch(const StringTemplate& queryTemplate,
+                           const oatpp::String& paramName,
+                           const oatpp::Vector<T>& rows,
+                           const provider::ResourceHandle<orm::Connection>& connection = nullptr,
+                           v_uint32 batchSize = DEFAULT_BATCH_SIZE,
+                           BatchMode mode = BatchMode::AUTO)
+  {
+    std::vector<std::unordered_map<oatpp::String, oatpp::Void>> paramsList;
+    if(rows) {
+      paramsList.reserve(rows->size());
+      for(auto& row : *rows) {
+        paramsList.push_back({{paramName, row}});
+      }
+    }
+    return executeBatch(queryTemplate, paramsList, connection, batchSize, mode);
+  }
+
+  /**
+   * Execute several independent SQL statements in one round trip. <br>
+   * Statements are joined with `;` and sent over the text protocol in a single packet.
+   * Read the result of each statement in order with &id:oatpp::mariadb::TextQueryResult::nextResultSet;.
+   * The server stops at the first failing statement. <br>
+   * No parameters are bound - values must be escaped by the caller.
+   * @param queries - SQL statements. Trailing `;` is optional.
+   * @param connection - database connection.
+   * @return - &id:oatpp::mariadb::TextQueryResult; positioned at the result of the first statement.
+   */
+  std::shared_ptr<TextQueryResult> executeMulti(const std::vector<oatpp::String>& queries,
+                                                const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Execute raw SQL query. <br>
+   * Sent with `mysql_real_query` over the text protocol - one round trip, no statement is prepared.
+   * Rows are mapped to DTOs by &id:oatpp::mariadb::mapping::TextResultMapper;. <br>
+   * The query may be a `;`-separated script - the results of all its statements are read before the call returns,
+   * so the connection is free for the next command. Use &l:Executor::executeMulti (); to read each result.
+   * Throws `std::runtime_error` if any statement fails.
    * @param query - SQL query string.
    * @param connection - database connection.
-   * @return - &id:oatpp::orm::QueryResult;.
+   * @return - &id:oatpp::mariadb::TextQueryResult; positioned at the result of the last statement.
    */
   std::shared_ptr<orm::QueryResult> executeRaw(const oatpp::String& query,
                                              const provider::ResourceHandle<orm::Connection>& connection = nullptr);
@@ -0,0 +1,135 @@
+#include "NonBlockingCall.hpp"
+
+#include "oatpp/core/base/Environment.hpp"
+
+#include <algorithm>
+
+#if defined(WIN32) || defined(_WIN32)
+  #include <winsock2.h>
+#else
+  #include <poll.h>
+#endif
+
+namespace oatpp { namespace mariadb {
+
+NonBlockingCall::NonBlockingCall(MYSQL* mysql, const StartFunction& start, const ContinueFunction& cont)
+  : m_mysql(mysql)
+  , m_start(start)
+  , m_continue(cont)
+  , m_status(0)
+  , m_started(false)
+  , m_ioWait(false)
+  , m_ioEvent(0)
+  , m_deadline(0)
+  , m_pollInterval(MIN_POLL_INTERVAL_MICROS)
+{}
+
+// Re-entered after every I/O or timer wait.
+async::Action NonBlockingCall::act() {
+
+  if (!m_started) {
+    m_started = true;
+    return onStatus(m_start());
+  }
+
+  if (m_ioWait) {
+    m_ioWait = false;
+    return onStatus(m_continue(m_ioEvent));
+  }
+
+  return pollOrWait();
+
+}
+
+async::Action NonBlockingCall::onStatus(int status) {
+
+  m_status = status;
+  if (m_status == 0) {
+    return finish();
+  }
+
+  if (!(m_status & MYSQL_WAIT_TIMEOUT)) {
+    m_ioWait = true;
+    if (m_status & (MYSQL_WAIT_READ | MYSQL_WAIT_EXCEPT)) {
+      m_ioEvent = MYSQL_WAIT_READ;
+      return async::Action::createIOWaitAction(mysql_get_socket(m_mysql), async::Action::IOEventType::IO_EVENT_READ);
+    }
+    m_ioEvent = MYSQL_WAIT_WRITE;
+    return async::Action::createIOWaitAction(mysql_get_socket(m_mysql), async::Action::IOEventType::IO_EVENT_WRITE);
+  }
+
+  m_deadline = base::Environment::getMicroTickCount() + static_cast<v_int64>(mysql_get_timeout_value_ms(m_mysql)) * 1000;
+  m_pollInterval = MIN_POLL_INTERVAL_MICROS;
+  return pollOrWait();
+
+}
+
+// The I/O worker has no wait with a timeout - poll the socket until it's ready or the deadline passes
+async::Action NonBlockingCall::pollOrWait() {
+
+  int events = pollSocket();
+  if (events != 0) {
+    return onStatus(m_continue(events));
+  }
+
+  v_int64 now = base::Environment::getMicroTickCount();
+  if (now >= m_deadline) {
+    return onStatus(m_continue(MYSQL_WAIT_TIMEOUT));
+  }
+
+  // nothing to wait for on the socket - only the client-side timeout
+  if (!(m_status & (MYSQL_WAIT_READ | MYSQL_WAIT_WRITE | MYSQL_WAIT_EXCEPT))) {
+    return async::Action::createWaitRepeatAction(m_deadline);
+  }
+
+  v_int64 wakeup = std::min(now + m_pollInterval, m_deadline);
+  m_pollInterval = std::min(m_pollInterval * 2, MAX_POLL_INTERVAL_MICROS);
+  return async::Action::createWaitRepeatAction(wakeup);
+
+}
+
+int NonBlockingCall::pollSocket() {
+
+  if (!(m_status & (MYSQL_WAIT_READ | MYSQL_WAIT_WRITE | MYSQL_WAIT_EXCEPT))) {
+    return 0;
+  }
+
+  struct pollfd pfd;
+  pfd.fd = mysql_get_socket(m_mysql);
+  pfd.events = 0;
+  pfd.revents = 0;
+  if (m_status & MYSQL_WAIT_READ) {
+    pfd.events |= POLLIN;
+  }
+  if (m_status & MYSQL_WAIT_WRITE) {
+    pfd.events |= POLLOUT;
+  }
+  if (m_status & MYSQL_WAIT_EXCEPT) {
+    pfd.events |= POLLPRI;
+  }
+
+#if defined(WIN32) || defined(_WIN32)
+  int result = WSAPoll(&pfd, 1, 0);
+#else
+  int result = poll(&pfd, 1, 0);
+#endif
+  if (result <= 0) {
+    return 0;
+  }
+
+  int events = 0;
+  // errors and hang-ups are reported as readable - the continue call reads them
+  if (pfd.revents & (POLLIN | POLLERR | POLLHUP)) {
+    events |= MYSQL_WAIT_READ;
+  }
+  if (pfd.revents & POLLOUT) {
+    events |= MYSQL_WAIT_WRITE;
+  }
+  if (pfd.revents & POLLPRI) {
+    events |= MYSQL_WAIT_EXCEPT;
+  }
+  return events;
+
+}
+
+}}
@@ -0,0 +1,76 @@
+#ifndef oatpp_mariadb_NonBlockingCall_hpp
+#define oatpp_mariadb_NonBlockingCall_hpp
+
+#include "oatpp/core/async/Coroutine.hpp"
+
+#include <mysql/mysql.h>
+
+#include <functional>
+
+namespace oatpp { namespace mariadb {
+
+/**
+ * Coroutine driving one call of the Connector/C non-blocking API (`mysql_*_start` / `mysql_*_cont`). <br>
+ * While the call is in progress the coroutine waits for the connection socket (`mysql_get_socket`)
+ * in the oatpp I/O event worker instead of blocking the processor thread.
+ * If the call has a timeout (`MYSQL_OPT_CONNECT_TIMEOUT`, `MYSQL_OPT_READ_TIMEOUT`, `MYSQL_OPT_WRITE_TIMEOUT`) the
+ * I/O worker can't wake the coroutine up when it expires - the socket is then polled on timer waits, backing off from
+ * &l:NonBlockingCall::MIN_POLL_INTERVAL_MICROS; to &l:NonBlockingCall::MAX_POLL_INTERVAL_MICROS;, and the call
+ * fails with a timeout error once the deadline passes. <br>
+ * The connection must have `MYSQL_OPT_NONBLOCK` set. Results of the call are written by the
+ * start/continue functions to the variables they capture.
+ */
+class NonBlockingCall : public oatpp::async::Coroutine<NonBlockingCall> {
+public:
+
+  /**
+   * Calls `mysql_*_start` and returns its wait status.
+   */
+  typedef std::function<int()> StartFunction;
+
+  /**
+   * Calls `mysql_*_cont` with the events that occurred and returns the new wait status.
+   */
+  typedef std::function<int(int)> ContinueFunction;
+
+  /**
+   * First interval of socket polls of a call with a timeout.
+   */
+  static constexpr v_int64 MIN_POLL_INTERVAL_MICROS = 100;
+
+  /**
+   * Maximum interval of socket polls of a call with a timeout.
+   */
+  static constexpr v_int64 MAX_POLL_INTERVAL_MICROS = 5000;
+
+private:
+  MYSQL* m_mysql;
+  StartFunction m_start;
+  ContinueFunction m_continue;
+  int m_status;
+  bool m_started;
+  bool m_ioWait;
+  int m_ioEvent;
+  v_int64 m_deadline;
+  v_int64 m_pollInterval;
+private:
+  Action onStatus(int status);
+  Action pollOrWait();
+  int pollSocket();
+public:
+
+  /**
+   * Constructor.
+   * @param mysql - connection handle.
+   * @param start - &l:NonBlockingCall::StartFunction;.
+   * @param cont - &l:NonBlockingCall::ContinueFunction;.
+   */
+  NonBlockingCall(MYSQL* mysql, const StartFunction& start, const ContinueFunction& cont);
+
+  Action act() override;
+
+};
+
+}}
+
+#endif // oatpp_mariadb_NonBlockingCall_hpp
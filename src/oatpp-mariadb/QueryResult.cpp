@@ -1,12 +1,24 @@
 #include "QueryResult.hpp"
+#include "NonBlockingCall.hpp"
 
 namespace oatpp { namespace mariadb {
 
 QueryResult::QueryResult(MYSQL_STMT* stmt,
                          const provider::ResourceHandle<orm::Connection>& connection,
                          const std::shared_ptr<mapping::ResultMapper>& resultMapper,
-                         const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver)
+                         const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                         const oatpp::String& statementKey,
+                         const std::shared_ptr<mapping::Serializer::BindContext>& bindContext,
+                         v_uint32 cursorPrefetchRows,
+                         bool streaming,
+                         bool executeNow,
+                         const std::shared_ptr<metrics::TemplateMetrics>& metrics)
   : m_stmt(stmt)
+  , m_statementKey(statementKey)
+  , m_bindContext(bindContext)
+  , m_cursorPrefetchRows(cursorPrefetchRows)
+  , m_streaming(streaming)
+  , m_streamOpen(false)
   , m_connection(connection)
   , m_resultMapper(resultMapper)
   , m_resultData(stmt, typeResolver)
@@ -15,47 +27,204 @@ QueryResult::QueryResult(MYSQL_STMT* stmt,
   , m_hasBeenFetched(false)
   , m_cachingEnabled(false)
   , m_cachedResult(nullptr)
+  , m_metrics(metrics)
 {
-  OATPP_LOGD("QueryResult", "Executing statement...");
-  
+  if (executeNow) {
+    execute();
+  }
+}
+
+QueryResult::QueryResult(const std::shared_ptr<const mapping::ResultSnapshot>& snapshot,
+                         const provider::ResourceHandle<orm::Connection>& connection,
+                         const std::shared_ptr<mapping::ResultMapper>& resultMapper,
+                         const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver)
+  : m_stmt(nullptr)
+  , m_cursorPrefetchRows(0)
+  , m_streaming(false)
+  , m_streamOpen(false)
+  , m_connection(connection)
+  , m_resultMapper(resultMapper)
+  , m_resultData(snapshot, typeResolver)
+  , m_inTransaction(false)
+  , m_lastInsertId(-1)
+  , m_hasBeenFetched(false)
+  , m_cachingEnabled(false)
+  , m_cachedResult(nullptr)
+{}
+
+MYSQL* QueryResult::getExecutableHandle() {
+
   if (!m_stmt) {
     m_errorMessage = "Statement is null";
     OATPP_LOGD("QueryResult", "Error: Statement is null");
-    return;
+    return nullptr;
   }
 
   MYSQL* mysql = std::static_pointer_cast<mariadb::Connection>(m_connection.object)->getHandle();
   if (!mysql) {
     m_errorMessage = "MySQL connection handle is null";
     OATPP_LOGD("QueryResult", "Error: MySQL connection handle is null");
+    return nullptr;
+  }
+
+  OATPP_LOGD("QueryResult", "MySQL thread id: %lu", mysql_thread_id(mysql));
+  OATPP_LOGD("QueryResult", "Statement address: %p", (void*)m_stmt);
+
+  return mysql;
+
+}
+
+void QueryResult::execute() {
+
+  OATPP_LOGD("QueryResult", "Executing statement...");
+
+  MYSQL* mysql = getExecutableHandle();
+  if (!mysql) {
     return;
   }
 
-  // Check if we're in a transaction
-  if (mysql_query(mysql, "SELECT IF(@@in_transaction, 'true', 'false') as in_transaction") == 0) {
-    MYSQL_RES* res = mysql_store_result(mysql);
-    if (res) {
-      MYSQL_ROW row = mysql_fetch_row(res);
-      if (row && row[0]) {
-        m_inTransaction = (strcmp(row[0], "true") == 0);
-      }
-      mysql_free_result(res);
+  if (m_cursorPrefetchRows > 0) {
+    // Attributes are local - they are sent with COM_STMT_EXECUTE / COM_STMT_FETCH
+    unsigned long cursorType = CURSOR_TYPE_READ_ONLY;
+    unsigned long prefetchRows = m_cursorPrefetchRows;
+    if (mysql_stmt_attr_set(m_stmt, STMT_ATTR_CURSOR_TYPE, &cursorType) ||
+        mysql_stmt_attr_set(m_stmt, STMT_ATTR_PREFETCH_ROWS, &prefetchRows))
+    {
+      m_errorMessage = "Error setting cursor attributes: " + std::string(mysql_stmt_error(m_stmt));
+      OATPP_LOGD("QueryResult", "%s", m_errorMessage->c_str());
+      return;
     }
+    m_resultData.useCursor = true;
+  } else if (m_streaming) {
+    m_resultData.unbuffered = true;
   }
 
-  OATPP_LOGD("QueryResult", "MySQL thread id: %lu", mysql_thread_id(mysql));
-  OATPP_LOGD("QueryResult", "Statement address: %p", (void*)m_stmt);
-  
+  auto start = std::chrono::steady_clock::now();
   if (mysql_stmt_execute(m_stmt)) {
-    m_errorMessage = "Error executing statement: " + std::string(mysql_stmt_error(m_stmt));
-    OATPP_LOGD("QueryResult", "Statement execution error: %s", m_errorMessage->c_str());
-    OATPP_LOGD("QueryResult", "MySQL error: %s", mysql_error(mysql));
+    onExecuteError(mysql);
     return;
   }
+  recordPhase(metrics::TemplateMetrics::Phase::EXECUTE, start);
+
+  start = std::chrono::steady_clock::now();
+  onExecuted();
+  recordPhase(metrics::TemplateMetrics::Phase::STORE, start);
+
+}
+
+void QueryResult::onExecuteError(MYSQL* mysql) {
+  m_errorMessage = "Error executing statement: " + std::string(mysql_stmt_error(m_stmt));
+  OATPP_LOGD("QueryResult", "Statement execution error: %s", m_errorMessage->c_str());
+  OATPP_LOGD("QueryResult", "MySQL error: %s", mysql_error(mysql));
+  checkConnectionError(mysql_stmt_errno(m_stmt));
+}
+
+void QueryResult::onExecuted() {
 
   OATPP_LOGD("QueryResult", "Statement executed successfully");
+
   m_resultData.init();    // initialize the information of all columns
   OATPP_LOGD("QueryResult", "Result data initialized");
+  if (!m_resultData.isSuccess) {
+    checkConnectionError(mysql_stmt_errno(m_stmt));
+  }
+
+  // Rows of an unbuffered result occupy the connection until they're read
+  if (m_resultData.unbuffered && m_resultData.hasMore) {
+    m_streamOpen = true;
+    std::static_pointer_cast<mariadb::Connection>(m_connection.object)->setBusy(true);
+  }
+
+  // Transaction state comes with the server status flags of the OK/EOF packet - no extra round trip needed
+  m_inTransaction = std::static_pointer_cast<mariadb::Connection>(m_connection.object)->isInTransaction();
+
+}
+
+async::CoroutineStarter QueryResult::executeAsync() {
+
+  class ExecuteCoroutine : public async::Coroutine<ExecuteCoroutine> {
+  private:
+    QueryResult* m_this;
+    MYSQL* m_mysql;
+    int m_result;
+    std::chrono::steady_clock::time_point m_start;
+  public:
+
+    ExecuteCoroutine(QueryResult* _this)
+      : m_this(_this)
+      , m_mysql(nullptr)
+      , m_result(0)
+    {}
+
+    Action act() override {
+      OATPP_LOGD("QueryResult", "Executing statement (non-blocking)...");
+      m_mysql = m_this->getExecutableHandle();
+      if (!m_mysql) {
+        return finish();
+      }
+      MYSQL_STMT* stmt = m_this->m_stmt;
+      m_start = std::chrono::steady_clock::now();
+      return NonBlockingCall::start(m_mysql,
+                                    [this, stmt]() { return mysql_stmt_execute_start(&m_result, stmt); },
+                                    [this, stmt](int status) { return mysql_stmt_execute_cont(&m_result, stmt, status); })
+        .next(yieldTo(&ExecuteCoroutine::onExecuted));
+    }
+
+    Action onExecuted() {
+      if (m_result) {
+        m_this->onExecuteError(m_mysql);
+        return finish();
+      }
+      m_this->recordPhase(metrics::TemplateMetrics::Phase::EXECUTE, m_start);
+      MYSQL_STMT* stmt = m_this->m_stmt;
+      m_start = std::chrono::steady_clock::now();
+      return NonBlockingCall::start(m_mysql,
+                                    [this, stmt]() { return mysql_stmt_store_result_start(&m_result, stmt); },
+                                    [this, stmt](int status) { return mysql_stmt_store_result_cont(&m_result, stmt, status); })
+        .next(yieldTo(&ExecuteCoroutine::onStored));
+    }
+
+    Action onStored() {
+      if (m_result) {
+        OATPP_LOGE("QueryResult", "Failed to store result: %s", mysql_stmt_error(m_this->m_stmt));
+        m_this->m_resultData.hasMore = false;
+        m_this->checkConnectionError(mysql_stmt_errno(m_this->m_stmt));
+        return finish();
+      }
+      m_this->m_resultData.resultStored = true;
+      m_this->onExecuted();
+      m_this->recordPhase(metrics::TemplateMetrics::Phase::STORE, m_start);
+      return finish();
+    }
+
+  };
+
+  return ExecuteCoroutine::start(this);
+
+}
+
+void QueryResult::closeStream() {
+
+  if (!m_streamOpen) {
+    return;
+  }
+  m_streamOpen = false;
+
+  auto connection = std::static_pointer_cast<mariadb::Connection>(m_connection.object);
+  if (m_resultData.hasMore && connection->isHealthy()) {
+    OATPP_LOGD("QueryResult", "Discarding the rest of an unbuffered result");
+    int status;
+    do {
+      status = mysql_stmt_fetch(m_stmt);
+    } while (status == 0 || status == MYSQL_DATA_TRUNCATED);
+    if (status != MYSQL_NO_DATA) {
+      checkConnectionError(mysql_stmt_errno(m_stmt));
+    }
+    m_resultData.hasMore = false;
+  }
+
+  connection->setBusy(false);
+
 }
 
 bool QueryResult::cleanupStatement() {
@@ -63,37 +232,51 @@ bool QueryResult::cleanupStatement() {
     return true;
   }
 
+  closeStream();
+
   bool success = true;
 
-  // Get the MySQL connection handle
-  MYSQL* mysql = m_connection ? std::static_pointer_cast<mariadb::Connection>(m_connection.object)->getHandle() : nullptr;
-  
-  // Only try to free the result set if we have a valid connection and metadata
-  if (mysql && !mysql_ping(mysql)) {  // Check if connection is alive
-    MYSQL_RES* metadata = mysql_stmt_result_metadata(m_stmt);
-    if (metadata) {
-      mysql_free_result(metadata);
-      if (mysql_stmt_free_result(m_stmt)) {
-        OATPP_LOGD("QueryResult", "Error freeing result set: %s", mysql_stmt_error(m_stmt));
-        success = false;
-      }
-    }
+  // Cleanup is purely local - connection health is tracked from errors seen during execute/fetch
+  auto connection = m_connection ? std::static_pointer_cast<mariadb::Connection>(m_connection.object) : nullptr;
+  MYSQL* mysql = (connection && connection->isHealthy()) ? connection->getHandle() : nullptr;
 
-    // Close the statement
-    if (mysql_stmt_close(m_stmt)) {
-      OATPP_LOGD("QueryResult", "Error closing statement: %s", mysql_stmt_error(m_stmt));
-      success = false;
+  // Statements taken from the connection's cache go back to it. A null handle makes the cache close the statement
+  if (m_statementKey && connection) {
+    if (m_resultData.useCursor) {
+      unsigned long cursorType = CURSOR_TYPE_NO_CURSOR;
+      mysql_stmt_attr_set(m_stmt, STMT_ATTR_CURSOR_TYPE, &cursorType);
     }
-  } else {
-    // Connection is lost, just mark the statement as cleaned up
-    OATPP_LOGD("QueryResult", "Connection lost, skipping result set cleanup");
-    success = true;  // Consider it successful since we can't do anything about it
+    // a cursor left open is closed by the reset, a fully read one by the next execute
+    bool needsReset = !m_resultData.isSuccess || (m_bindContext && m_bindContext->hasLongData()) ||
+                      (m_resultData.useCursor && m_resultData.hasMore);
+    connection->getStatementCache().release(mysql, m_statementKey, m_stmt, needsReset);
+    m_stmt = nullptr;
+    return true;
+  }
+
+  if (mysql && mysql_stmt_free_result(m_stmt)) {
+    OATPP_LOGD("QueryResult", "Error freeing result set: %s", mysql_stmt_error(m_stmt));
+    success = false;
+  }
+
+  // For a broken or closed connection this only releases client-side memory
+  if (mysql_stmt_close(m_stmt)) {
+    OATPP_LOGD("QueryResult", "Error closing statement: %s", mysql_stmt_error(m_stmt));
+    success = false;
   }
 
   m_stmt = nullptr;
   return success;
 }
 
+void QueryResult::checkConnectionError(unsigned int errorCode) {
+  auto connection = std::static_pointer_cast<mariadb::Connection>(m_connection.object);
+  if (connection->isHealthy() && connection->reportError(errorCode) && m_connection.invalidator) {
+    // evict the connection from the pool
+    m_connection.invalidator->invalidate(m_connection.object);
+  }
+}
+
 QueryResult::~QueryResult() {
   if (cleanupStatement()) {
     OATPP_LOGD("QueryResult", "Statement cleaned up successfully");
@@ -126,6 +309,10 @@ bool QueryResult::hasMoreToFetch() const {
   return m_resultData.hasMore;
 }
 
+bool QueryResult::isInTransaction() const {
+  return m_inTransaction;
+}
+
 bool QueryResult::hasBeenFetched() const {
   return m_hasBeenFetched;
 }
@@ -141,18 +328,81 @@ bool QueryResult::isResultCachingEnabled() const {
   return m_cachingEnabled;
 }
 
-oatpp::Void QueryResult::fetch(const oatpp::Type* const type, v_int64 count) {
-  if (m_hasBeenFetched) {
+void QueryResult::recordResult(const std::shared_ptr<ResultCache>& cache, const ResultCache::Recording& recording) {
+
+  if (!m_resultData.isSuccess || m_resultData.colCount == 0 || m_hasBeenFetched) {
+    return;
+  }
+
+  // the first row is fetched by ResultData::init()
+  auto recorder = std::make_shared<mapping::ResultSnapshot>(cache->getConfig().maxBytes);
+  recorder->init(m_resultData.bindResults, m_resultData.colNames);
+  if (m_resultData.hasMore && !recorder->appendRow(m_resultData.bindResults)) {
+    return;
+  }
+
+  m_resultCache = cache;
+  m_recording = recording;
+  m_resultData.recorder = recorder;
+  storeRecording();
+
+}
+
+void QueryResult::storeRecording() {
+  if (m_resultData.recorder && !m_resultData.hasMore && m_resultData.isSuccess) {
+    m_resultCache->put(m_recording, m_resultData.recorder);
+  }
+  if (!m_resultData.recorder || !m_resultData.hasMore) {
+    m_resultData.recorder.reset();
+    m_resultCache.reset();
+  }
+}
+
+void QueryResult::recordPhase(metrics::TemplateMetrics::Phase phase, std::chrono::steady_clock::time_point start) {
+  if (m_metrics) {
+    m_metrics->recordSince(phase, start);
+  }
+}
+
+bool QueryResult::isFromCache() const {
+  return m_resultData.snapshot != nullptr;
+}
+
+bool QueryResult::beginFetch() {
+  // Rows may be read in several windows - only fetching past the end counts as fetching again
+  if (m_hasBeenFetched && !m_resultData.hasMore) {
     OATPP_LOGW("QueryResult", "Warning: Attempting to fetch results multiple times.");
+    return false;
+  }
+  m_hasBeenFetched = true;
+  return true;
+}
+
+void QueryResult::endFetch() {
+  if (!m_resultData.isSuccess && m_stmt) {
+    checkConnectionError(mysql_stmt_errno(m_stmt));
+  }
+  if (!m_resultData.hasMore) {
+    closeStream();
+  }
+  if (m_resultCache) {
+    storeRecording();
+  }
+}
+
+oatpp::Void QueryResult::fetch(const oatpp::Type* const type, v_int64 count) {
+  if (!beginFetch()) {
     if (m_cachingEnabled && m_cachedResult) {
       OATPP_LOGD("QueryResult", "Returning cached results");
       return m_cachedResult;
     }
     return nullptr;
   }
-  
-  m_hasBeenFetched = true;
+
+  auto start = std::chrono::steady_clock::now();
   auto result = m_resultMapper->readRows(&m_resultData, type, count);
+  recordPhase(metrics::TemplateMetrics::Phase::MAPPING, start);
+  endFetch();
   
   if (m_cachingEnabled) {
     OATPP_LOGD("QueryResult", "Caching query results");
@@ -162,6 +412,29 @@ oatpp::Void QueryResult::fetch(const oatpp::Type* const type, v_int64 count) {
   return result;
 }
 
+mapping::ColumnarResult QueryResult::fetchColumnar(v_int64 count) {
+  if (!beginFetch()) {
+    return mapping::ColumnarResult();
+  }
+  auto start = std::chrono::steady_clock::now();
+  auto result = m_resultMapper->readColumnar(&m_resultData, count);
+  recordPhase(metrics::TemplateMetrics::Phase::MAPPING, start);
+  endFetch();
+  return result;
+}
+
+v_int64 QueryResult::writeJson(data::stream::ConsistentOutputStream* stream, v_int64 count) {
+  if (!beginFetch()) {
+    stream->writeSimple("[]", 2);
+    return 0;
+  }
+  auto start = std::chrono::steady_clock::now();
+  auto rowCount = m_resultMapper->writeJson(&m_resultData, stream, count);
+  recordPhase(metrics::TemplateMetrics::Phase::MAPPING, start);
+  endFetch();
+  return rowCount;
+}
+
 v_int64 QueryResult::getLastInsertId() const {
   if (m_lastInsertId >= 0) {
     // Return ID from RETURNING clause if available
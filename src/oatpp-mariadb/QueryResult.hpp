@@ -7,8 +7,11 @@
 #include <mysql/mysql.h>
 
 #include "ConnectionProvider.hpp"
+#include "ResultCache.hpp"
+#include "metrics/QueryMetrics.hpp"
 #include "mapping/Deserializer.hpp"
 #include "mapping/ResultMapper.hpp"
+#include "mapping/Serializer.hpp"
 #include "oatpp/orm/QueryResult.hpp"
 
 namespace oatpp { namespace mariadb {
@@ -19,6 +22,11 @@ namespace oatpp { namespace mariadb {
 class QueryResult : public orm::QueryResult {
 private:
   MYSQL_STMT* m_stmt;
+  oatpp::String m_statementKey;
+  std::shared_ptr<mapping::Serializer::BindContext> m_bindContext;
+  v_uint32 m_cursorPrefetchRows;
+  bool m_streaming;
+  bool m_streamOpen;
   provider::ResourceHandle<orm::Connection> m_connection;
   std::shared_ptr<mapping::ResultMapper> m_resultMapper;
   mapping::ResultMapper::ResultData m_resultData;
@@ -28,6 +36,9 @@ private:
   bool m_hasBeenFetched;
   bool m_cachingEnabled;
   oatpp::Void m_cachedResult;
+  std::shared_ptr<ResultCache> m_resultCache;
+  ResultCache::Recording m_recording;
+  std::shared_ptr<metrics::TemplateMetrics> m_metrics;
 
   /**
    * Clean up statement resources safely
@@ -35,15 +46,122 @@ private:
    */
   bool cleanupStatement();
 
+  /**
+   * Update connection health from a client error code and invalidate the connection if it is broken.
+   * @param errorCode - `mysql_stmt_errno` value.
+   */
+  void checkConnectionError(unsigned int errorCode);
+
+  /**
+   * Get connection handle if the statement can be executed. Sets the error message otherwise.
+   * @return - connection handle or `nullptr`.
+   */
+  MYSQL* getExecutableHandle();
+
+  void execute();
+  void onExecuteError(MYSQL* mysql);
+  void onExecuted();
+
+  /**
+   * Read and drop the rest of an unbuffered result and clear the busy flag of the connection.
+   */
+  void closeStream();
+
+  /**
+   * Check if rows can be fetched. Marks the result as fetched.
+   * @return - `false` if the result was already read to the end.
+   */
+  bool beginFetch();
+
+  /**
+   * Check the connection after rows were read and close a fully read stream.
+   * Puts a fully read recorded result to the &id:oatpp::mariadb::ResultCache;.
+   */
+  void endFetch();
+
+  /**
+   * Put the recorded result to the cache if all its rows were read.
+   */
+  void storeRecording();
+
+  /**
+   * Record phase duration if the result has &id:oatpp::mariadb::metrics::TemplateMetrics;.
+   */
+  void recordPhase(metrics::TemplateMetrics::Phase phase, std::chrono::steady_clock::time_point start);
+
 public:
 
+  /**
+   * Constructor. Executes the statement unless `executeNow` is `false`.
+   * @param stmt - prepared statement.
+   * @param connection - connection the statement belongs to.
+   * @param resultMapper - &id:oatpp::mariadb::mapping::ResultMapper;.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param statementKey - if set, the statement was taken from the connection's &id:oatpp::mariadb::StatementCache;
+   * under this key and is returned there instead of being closed.
+   * @param bindContext - parameter binds of the statement. Kept alive as long as the result.
+   * @param cursorPrefetchRows - if not `0`, the statement is executed with a server-side read-only cursor and
+   * rows are fetched from the server in windows of this many rows instead of being stored client-side.
+   * Ignored by &l:QueryResult::executeAsync ();.
+   * @param streaming - read the result unbuffered - rows are mapped as they arrive off the wire.
+   * The connection is busy (&id:oatpp::mariadb::Connection::isBusy;) until all rows are fetched or the result
+   * is destroyed. Ignored by &l:QueryResult::executeAsync ();.
+   * @param executeNow - `false` to execute later with &l:QueryResult::executeAsync ();.
+   * @param metrics - if set, execution, storing and mapping times are recorded to these
+   * &id:oatpp::mariadb::metrics::TemplateMetrics;.
+   */
   QueryResult(MYSQL_STMT* stmt,
+              const provider::ResourceHandle<orm::Connection>& connection,
+              const std::shared_ptr<mapping::ResultMapper>& resultMapper,
+              const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+              const oatpp::String& statementKey = nullptr,
+              const std::shared_ptr<mapping::Serializer::BindContext>& bindContext = nullptr,
+              v_uint32 cursorPrefetchRows = 0,
+              bool streaming = false,
+              bool executeNow = true,
+              const std::shared_ptr<metrics::TemplateMetrics>& metrics = nullptr);
+
+  /**
+   * Constructor. Result served from a &id:oatpp::mariadb::ResultCache; - rows are replayed from the snapshot,
+   * no statement is executed. &l:QueryResult::getAffectedRows (); and &l:QueryResult::getLastInsertId (); are `0`.
+   * @param snapshot - &id:oatpp::mariadb::mapping::ResultSnapshot;.
+   * @param connection - connection given to the executor. May be `nullptr`.
+   * @param resultMapper - &id:oatpp::mariadb::mapping::ResultMapper;.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   */
+  QueryResult(const std::shared_ptr<const mapping::ResultSnapshot>& snapshot,
               const provider::ResourceHandle<orm::Connection>& connection,
               const std::shared_ptr<mapping::ResultMapper>& resultMapper,
               const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver);
 
   ~QueryResult();
 
+  /**
+   * Record the rows of this result while they are fetched and put them to the cache once the result is read
+   * to the end. Must be called right after the statement was executed, before anything is fetched.
+   * Nothing is recorded if the statement failed or returned no result set.
+   * @param cache - &id:oatpp::mariadb::ResultCache;.
+   * @param recording - &id:oatpp::mariadb::ResultCache::Recording;.
+   */
+  void recordResult(const std::shared_ptr<ResultCache>& cache, const ResultCache::Recording& recording);
+
+  /**
+   * Check if the result was served from a &id:oatpp::mariadb::ResultCache;.
+   * @return
+   */
+  bool isFromCache() const;
+
+  /**
+   * Execute the statement and store its result set with the Connector/C non-blocking API. <br>
+   * Only for results constructed with `executeNow = false`. The non-blocking API must be enabled on the connection -
+   * &id:oatpp::mariadb::Connection::enableNonBlocking;, done by &id:oatpp::mariadb::Executor::executeAsync;.
+   * Rows are read off the socket while the result is stored, so &l:QueryResult::fetch (); doesn't block afterwards.
+   * Errors are reported the same way as for blocking execution - check &l:QueryResult::isSuccess ();.
+   * The result must stay alive until the coroutine finishes.
+   * @return - &id:oatpp::async::CoroutineStarter;.
+   */
+  async::CoroutineStarter executeAsync();
+
   provider::ResourceHandle<orm::Connection> getConnection() const override;
 
   bool isSuccess() const override;
@@ -56,8 +174,49 @@ public:
 
   bool hasMoreToFetch() const override;
 
+  using orm::QueryResult::fetch;
+
   oatpp::Void fetch(const oatpp::Type* const type, v_int64 count) override;
 
+  /**
+   * Fetch `count` rows into column-major contiguous buffers - `v_int64`/`v_float64` arrays, null bitmaps and
+   * offsets + data for strings. No per-cell allocation. See &id:oatpp::mariadb::mapping::ColumnarResult;. <br>
+   * Can be called repeatedly to read the result in windows. Not cached by &l:QueryResult::enableResultCaching ();.
+   * @param count - number of rows to fetch. `-1` - all remaining rows.
+   * @return - &id:oatpp::mariadb::mapping::ColumnarResult;. No rows if the result was already read to the end.
+   */
+  mapping::ColumnarResult fetchColumnar(v_int64 count = -1);
+
+  /**
+   * Write `count` rows to the stream as a JSON array of objects, straight from the bound result buffers. <br>
+   * No DTOs are built - with a streaming result (&id:oatpp::mariadb::Executor::executeStreaming;) and a stream that
+   * doesn't buffer everything, a response body is produced with constant memory.
+   * See &id:oatpp::mariadb::mapping::JsonResultWriter; for the value format.
+   * @param stream - output stream.
+   * @param count - number of rows to write. `-1` - all remaining rows.
+   * @return - number of rows written. `[]` is written if the result was already read to the end.
+   */
+  v_int64 writeJson(data::stream::ConsistentOutputStream* stream, v_int64 count = -1);
+
+  /**
+   * Fetch `count` rows into DTOs of a type known at compile time - see
+   * &id:oatpp::mariadb::mapping::ResultMapper::readRowsAs;. Not cached by &l:QueryResult::enableResultCaching ();.
+   * @tparam DtoT - DTO class.
+   * @param count - number of rows to fetch. `-1` - all remaining rows.
+   * @return - `oatpp::Vector<oatpp::Object<DtoT>>` or `nullptr` if the result was already read to the end.
+   */
+  template<class DtoT>
+  oatpp::Vector<oatpp::Object<DtoT>> fetchAs(v_int64 count = -1) {
+    if (!beginFetch()) {
+      return nullptr;
+    }
+    auto start = std::chrono::steady_clock::now();
+    auto rows = m_resultMapper->readRowsAs<DtoT>(&m_resultData, count);
+    recordPhase(metrics::TemplateMetrics::Phase::MAPPING, start);
+    endFetch();
+    return rows;
+  }
+
   /**
    * Get the ID generated for an AUTO_INCREMENT column by the previous INSERT query.
    * This will first try to get the ID from RETURNING clause if available,
@@ -78,6 +237,13 @@ public:
    */
   void setLastInsertId(v_int64 id);
 
+  /**
+   * Check if the connection was inside a transaction right after this statement was executed.
+   * Derived from the `SERVER_STATUS_IN_TRANS` flag reported by the server with the statement result.
+   * @return true if a transaction is active
+   */
+  bool isInTransaction() const;
+
   /**
    * Check if the result set has already been fetched
    * @return true if the result has been fetched at least once
@@ -0,0 +1,221 @@
+#include "ResultCache.hpp"
+
+namespace oatpp { namespace mariadb {
+
+ResultCache::ResultCache()
+  : ResultCache(Config())
+{}
+
+ResultCache::ResultCache(const Config& config)
+  : m_config(config)
+  , m_epoch(0)
+{}
+
+// e.g. "getUser" + {Int64 42} -> "getUser\0" + [type, unsigned, null] + [length: 8 bytes] + [42: 8 bytes]
+bool ResultCache::makeKey(const oatpp::String& templateName, mapping::Serializer::BindContext* context, std::string& key) {
+
+  key.clear();
+  if (templateName) {
+    key.append(templateName->data(), templateName->size());
+  }
+  key.push_back('\0');
+
+  if (!context) {
+    return true;
+  }
+
+  for (v_uint32 i = 0; i < context->getParamCount(); i++) {
+
+    const MYSQL_BIND& bind = context->getBind(i);
+    const bool isNull = bind.is_null ? *bind.is_null != 0 : true;
+
+    // long data is streamed with mysql_stmt_send_long_data - there are no bytes to build the key from
+    if (!isNull && !bind.buffer) {
+      return false;
+    }
+
+    key.push_back(static_cast<char>(bind.buffer_type));
+    key.push_back(static_cast<char>(bind.is_unsigned ? 1 : 0));
+    key.push_back(static_cast<char>(isNull ? 1 : 0));
+
+    if (!isNull) {
+      v_uint64 length = bind.buffer_length;
+      key.append(reinterpret_cast<const char*>(&length), sizeof(length));
+      key.append(static_cast<const char*>(bind.buffer), bind.buffer_length);
+    }
+
+  }
+
+  return true;
+
+}
+
+const ResultCache::Config& ResultCache::getConfig() const {
+  return m_config;
+}
+
+void ResultCache::removeEntry(std::list<Entry>::iterator it) {
+  for (auto& table : it->tables) {
+    auto keys = m_tableKeys.find(table);
+    if (keys != m_tableKeys.end()) {
+      keys->second.erase(it->key);
+      if (keys->second.empty()) {
+        m_tableKeys.erase(keys);
+      }
+    }
+  }
+  m_stats.bytes -= it->size;
+  m_index.erase(it->key);
+  m_entries.erase(it);
+}
+
+std::shared_ptr<const mapping::ResultSnapshot> ResultCache::get(const std::string& key) {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_index.find(key);
+  if (it == m_index.end()) {
+    ++m_stats.misses;
+    return nullptr;
+  }
+
+  auto entry = it->second;
+  if (entry->expiresAt <= std::chrono::steady_clock::now()) {
+    removeEntry(entry);
+    ++m_stats.expirations;
+    ++m_stats.misses;
+    return nullptr;
+  }
+
+  m_entries.splice(m_entries.begin(), m_entries, entry);
+  ++m_stats.hits;
+  return entry->snapshot;
+
+}
+
+v_uint64 ResultCache::getEpoch() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_epoch;
+}
+
+bool ResultCache::put(const Recording& recording, const std::shared_ptr<const mapping::ResultSnapshot>& snapshot) {
+
+  const v_int64 size = snapshot->getByteSize() + static_cast<v_int64>(sizeof(Entry) + recording.key.size());
+  const auto ttl = recording.ttl.count() > 0 ? recording.ttl : m_config.defaultTtl;
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  // a table could have been written after the rows were read - the result may be stale already
+  if (recording.epoch != m_epoch || size > m_config.maxBytes) {
+    ++m_stats.rejections;
+    return false;
+  }
+
+  auto existing = m_index.find(recording.key);
+  if (existing != m_index.end()) {
+    removeEntry(existing->second);
+  }
+
+  while (!m_entries.empty() && m_stats.bytes + size > m_config.maxBytes) {
+    OATPP_LOGD("ResultCache", "Evicting cached result. Size: %lld", (long long) m_entries.back().size);
+    removeEntry(std::prev(m_entries.end()));
+    ++m_stats.evictions;
+  }
+
+  m_entries.push_front({recording.key, snapshot, recording.tables, std::chrono::steady_clock::now() + ttl, size});
+  m_index[recording.key] = m_entries.begin();
+  for (auto& table : recording.tables) {
+    m_tableKeys[table].insert(recording.key);
+  }
+  m_stats.bytes += size;
+  ++m_stats.insertions;
+
+  return true;
+
+}
+
+void ResultCache::invalidateLocked(const std::vector<std::string>& tables) {
+  ++m_epoch;
+  for (auto& table : tables) {
+    auto keys = m_tableKeys.find(table);
+    if (keys == m_tableKeys.end()) {
+      continue;
+    }
+    // removing an entry updates the key set of the table
+    auto tableKeys = keys->second;
+    for (auto& key : tableKeys) {
+      auto it = m_index.find(key);
+      if (it != m_index.end()) {
+        removeEntry(it->second);
+        ++m_stats.invalidations;
+      }
+    }
+  }
+}
+
+void ResultCache::invalidateAllLocked() {
+  ++m_epoch;
+  m_stats.invalidations += m_entries.size();
+  m_entries.clear();
+  m_index.clear();
+  m_tableKeys.clear();
+  m_stats.bytes = 0;
+}
+
+void ResultCache::invalidate(const std::vector<std::string>& tables, const void* transaction) {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  if (tables.empty()) {
+    invalidateAllLocked();
+  } else {
+    invalidateLocked(tables);
+  }
+
+  if (transaction) {
+    auto& pending = m_pendingWrites[transaction];
+    pending.allTables = pending.allTables || tables.empty();
+    pending.tables.insert(tables.begin(), tables.end());
+  }
+
+}
+
+void ResultCache::commit(const void* transaction) {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto it = m_pendingWrites.find(transaction);
+  if (it == m_pendingWrites.end()) {
+    return;
+  }
+
+  if (it->second.allTables) {
+    invalidateAllLocked();
+  } else {
+    invalidateLocked(std::vector<std::string>(it->second.tables.begin(), it->second.tables.end()));
+  }
+  m_pendingWrites.erase(it);
+
+}
+
+void ResultCache::rollback(const void* transaction) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_pendingWrites.erase(transaction);
+}
+
+void ResultCache::clear() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_entries.clear();
+  m_index.clear();
+  m_tableKeys.clear();
+  m_stats.bytes = 0;
+}
+
+ResultCache::Stats ResultCache::getStats() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  Stats stats = m_stats;
+  stats.size = m_entries.size();
+  return stats;
+}
+
+}}
@@ -0,0 +1,249 @@
+#ifndef oatpp_mariadb_ResultCache_hpp
+#define oatpp_mariadb_ResultCache_hpp
+
+#include "mapping/ResultSnapshot.hpp"
+#include "mapping/Serializer.hpp"
+
+#include "oatpp/core/Types.hpp"
+
+#include <chrono>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace oatpp { namespace mariadb {
+
+/**
+ * Cross-query cache of result sets shared by all connections of an &id:oatpp::mariadb::Executor;. <br>
+ * Results are keyed by template name and the values of the bound parameters and stored as
+ * &id:oatpp::mariadb::mapping::ResultSnapshot;, so a hit is mapped like a fresh result - into any type - without
+ * a connection or a round trip. Entries expire after their TTL, the least recently used ones are evicted when the
+ * cache grows past its size limit, and all entries reading a table are dropped when a write to that table is
+ * executed through the same executor. Writes made by other processes are only seen after the TTL. <br>
+ * Thread-safe.
+ */
+class ResultCache {
+public:
+
+  /**
+   * Default size limit - 64MB.
+   */
+  static constexpr v_int64 DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+  /**
+   * Cache configuration.
+   */
+  struct Config {
+
+    /**
+     * Maximum total size of the cached results in bytes. Results larger than this are not cached.
+     */
+    v_int64 maxBytes = DEFAULT_MAX_BYTES;
+
+    /**
+     * Time to live of entries of templates which don't set their own TTL.
+     */
+    std::chrono::milliseconds defaultTtl = std::chrono::seconds(60);
+
+  };
+
+  /**
+   * Cache statistics.
+   */
+  struct Stats {
+
+    /**
+     * Number of results served from the cache.
+     */
+    v_uint64 hits = 0;
+
+    /**
+     * Number of lookups which found no entry or an expired one.
+     */
+    v_uint64 misses = 0;
+
+    /**
+     * Number of results added to the cache.
+     */
+    v_uint64 insertions = 0;
+
+    /**
+     * Number of recorded results not added because a write happened while they were read or they were too large.
+     */
+    v_uint64 rejections = 0;
+
+    /**
+     * Number of entries dropped because the cache was full.
+     */
+    v_uint64 evictions = 0;
+
+    /**
+     * Number of entries dropped after their TTL.
+     */
+    v_uint64 expirations = 0;
+
+    /**
+     * Number of entries dropped because a table they read was written.
+     */
+    v_uint64 invalidations = 0;
+
+    /**
+     * Number of entries currently held by the cache.
+     */
+    v_uint64 size = 0;
+
+    /**
+     * Total size of the entries in bytes.
+     */
+    v_int64 bytes = 0;
+
+  };
+
+  /**
+   * Where and for how long a recorded result goes once it's read to the end.
+   */
+  struct Recording {
+
+    /**
+     * Cache key - see &l:ResultCache::makeKey ();.
+     */
+    std::string key;
+
+    /**
+     * Tables the query reads.
+     */
+    std::vector<std::string> tables;
+
+    /**
+     * Time to live. `0` - default TTL.
+     */
+    std::chrono::milliseconds ttl{0};
+
+    /**
+     * Invalidation epoch at the time the query was executed - see &l:ResultCache::getEpoch ();.
+     */
+    v_uint64 epoch = 0;
+
+  };
+
+private:
+
+  struct Entry {
+    std::string key;
+    std::shared_ptr<const mapping::ResultSnapshot> snapshot;
+    std::vector<std::string> tables;
+    std::chrono::steady_clock::time_point expiresAt;
+    v_int64 size;
+  };
+
+  /*
+   * Writes made inside a transaction - invalidated once more on commit, since readers on other connections
+   * may cache the old rows until then.
+   */
+  struct PendingWrites {
+    bool allTables = false;
+    std::unordered_set<std::string> tables;
+  };
+
+private:
+  void removeEntry(std::list<Entry>::iterator it);
+  void invalidateLocked(const std::vector<std::string>& tables);
+  void invalidateAllLocked();
+private:
+  Config m_config;
+  std::list<Entry> m_entries; // most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+  std::unordered_map<std::string, std::unordered_set<std::string>> m_tableKeys;
+  std::unordered_map<const void*, PendingWrites> m_pendingWrites;
+  v_uint64 m_epoch;
+  Stats m_stats;
+  mutable std::mutex m_mutex;
+public:
+
+  /**
+   * Constructor. Default &l:ResultCache::Config;.
+   */
+  ResultCache();
+
+  /**
+   * Constructor.
+   * @param config - &l:ResultCache::Config;.
+   */
+  explicit ResultCache(const Config& config);
+
+  /**
+   * Build the cache key of a template execution - template name and type, null flag and bytes of each bound parameter.
+   * @param templateName - template name.
+   * @param context - serialized parameters. `nullptr` if the template has no parameters.
+   * @param key - out. Cache key.
+   * @return - `false` if the result can't be cached (a parameter is sent as long data).
+   */
+  static bool makeKey(const oatpp::String& templateName, mapping::Serializer::BindContext* context, std::string& key);
+
+  /**
+   * Get configuration.
+   * @return - &l:ResultCache::Config;.
+   */
+  const Config& getConfig() const;
+
+  /**
+   * Get cached result.
+   * @param key - cache key.
+   * @return - snapshot of the result or `nullptr` if there is no entry or it has expired.
+   */
+  std::shared_ptr<const mapping::ResultSnapshot> get(const std::string& key);
+
+  /**
+   * Get invalidation epoch - a counter increased by every invalidation. A result recorded while the epoch changed
+   * may contain rows written over - &l:ResultCache::put (); rejects it.
+   * @return
+   */
+  v_uint64 getEpoch() const;
+
+  /**
+   * Add a fully read result.
+   * @param recording - &l:ResultCache::Recording;.
+   * @param snapshot - rows of the result.
+   * @return - `true` if the result was added.
+   */
+  bool put(const Recording& recording, const std::shared_ptr<const mapping::ResultSnapshot>& snapshot);
+
+  /**
+   * Drop all entries reading any of the tables.
+   * @param tables - lower-cased table names. Empty - the written tables are unknown, all entries are dropped.
+   * @param transaction - if not `nullptr`, the write belongs to a transaction on this connection and the tables are
+   * invalidated once more on &l:ResultCache::commit ();.
+   */
+  void invalidate(const std::vector<std::string>& tables, const void* transaction = nullptr);
+
+  /**
+   * Transaction on the connection was committed - invalidate the tables written in it.
+   * @param transaction - connection.
+   */
+  void commit(const void* transaction);
+
+  /**
+   * Transaction on the connection was rolled back - forget the tables written in it.
+   * @param transaction - connection.
+   */
+  void rollback(const void* transaction);
+
+  /**
+   * Drop all entries.
+   */
+  void clear();
+
+  /**
+   * Get cache statistics.
+   * @return - &l:ResultCache::Stats;.
+   */
+  Stats getStats() const;
+
+};
+
+}}
+
+#endif // oatpp_mariadb_ResultCache_hpp
@@ -0,0 +1,212 @@
+#include "RoutingExecutor.hpp"
+
+namespace oatpp { namespace mariadb {
+
+RoutingExecutor::BackendStats RoutingExecutor::Backend::getStats() const {
+  BackendStats stats;
+  stats.acquisitions = acquisitions.load(std::memory_order_relaxed);
+  stats.reads = reads.load(std::memory_order_relaxed);
+  stats.inFlight = inFlight.load(std::memory_order_relaxed);
+  stats.failures = failures.load(std::memory_order_relaxed);
+  return stats;
+}
+
+RoutingExecutor::RoutingExecutor(const std::shared_ptr<provider::Provider<Connection>>& primaryProvider,
+                                 const std::vector<std::shared_ptr<provider::Provider<Connection>>>& replicaProviders,
+                                 Balancing balancing)
+  : Executor(primaryProvider)
+  , m_primary(std::make_shared<Backend>(primaryProvider))
+  , m_balancing(balancing)
+  , m_nextReplica(0)
+{
+  m_replicas.reserve(replicaProviders.size());
+  for (auto& replicaProvider : replicaProviders) {
+    m_replicas.push_back(std::make_shared<Backend>(replicaProvider));
+  }
+}
+
+// the handle keeps the pooled connection alive - it goes back to the pool once the deleter drops it
+provider::ResourceHandle<Connection> RoutingExecutor::track(const std::shared_ptr<Backend>& backend,
+                                                            const provider::ResourceHandle<Connection>& connection) {
+  if (!connection) {
+    backend->failures.fetch_add(1, std::memory_order_relaxed);
+    return connection;
+  }
+  backend->acquisitions.fetch_add(1, std::memory_order_relaxed);
+  backend->inFlight.fetch_add(1, std::memory_order_relaxed);
+  auto object = connection.object;
+  std::shared_ptr<Connection> tracked(object.get(), [backend, object](Connection*) {
+    backend->inFlight.fetch_sub(1, std::memory_order_relaxed);
+  });
+  return provider::ResourceHandle<Connection>(tracked, connection.invalidator);
+}
+
+v_uint64 RoutingExecutor::selectReplica() {
+
+  const v_uint64 size = m_replicas.size();
+  const v_uint64 start = m_nextReplica.fetch_add(1, std::memory_order_relaxed) % size;
+  if (m_balancing == Balancing::ROUND_ROBIN) {
+    return start;
+  }
+
+  v_uint64 best = start;
+  v_int64 bestInFlight = m_replicas[start]->inFlight.load(std::memory_order_relaxed);
+  for (v_uint64 i = 1; i < size && bestInFlight > 0; i++) {
+    v_uint64 index = (start + i) % size;
+    v_int64 inFlight = m_replicas[index]->inFlight.load(std::memory_order_relaxed);
+    if (inFlight < bestInFlight) {
+      best = index;
+      bestInFlight = inFlight;
+    }
+  }
+  return best;
+
+}
+
+provider::ResourceHandle<Connection> RoutingExecutor::acquireConnection(const ql_template::Parser::TemplateExtra& extra) {
+
+  if (!extra.isReadOnly || m_replicas.empty()) {
+    return track(m_primary, m_primary->provider->get());
+  }
+
+  const v_uint64 first = selectReplica();
+  for (v_uint64 i = 0; i < m_replicas.size(); i++) {
+    auto& replica = m_replicas[(first + i) % m_replicas.size()];
+    try {
+      auto connection = track(replica, replica->provider->get());
+      if (connection) {
+        replica->reads.fetch_add(1, std::memory_order_relaxed);
+        return connection;
+      }
+    } catch (const std::exception& e) {
+      replica->failures.fetch_add(1, std::memory_order_relaxed);
+      OATPP_LOGW("RoutingExecutor", "Can't get replica connection: %s", e.what());
+    }
+  }
+
+  OATPP_LOGW("RoutingExecutor", "No replica available. Reading from primary. Template: %s", extra.templateName->c_str());
+  auto connection = track(m_primary, m_primary->provider->get());
+  if (connection) {
+    m_primary->reads.fetch_add(1, std::memory_order_relaxed);
+  }
+  return connection;
+
+}
+
+async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&>
+RoutingExecutor::acquireConnectionAsync(const ql_template::Parser::TemplateExtra& extra) {
+
+  // mirrors acquireConnection() - replicas in turn starting from the selected one, then the primary
+  class AcquireCoroutine : public async::CoroutineWithResult<AcquireCoroutine, const provider::ResourceHandle<Connection>&> {
+  private:
+    std::shared_ptr<Backend> m_primary;
+    std::vector<std::shared_ptr<Backend>> m_replicas;
+    v_uint64 m_first;
+    v_uint64 m_attempt;
+    bool m_read;
+    std::shared_ptr<Backend> m_backend;
+    provider::ResourceHandle<Connection> m_connection;
+  private:
+
+    bool onReplica() const {
+      return m_attempt < m_replicas.size();
+    }
+
+    Action next() {
+      m_attempt++;
+      if (!onReplica()) {
+        OATPP_LOGW("RoutingExecutor", "No replica available. Reading from primary.");
+      }
+      return yieldTo(&AcquireCoroutine::act);
+    }
+
+  public:
+
+    AcquireCoroutine(const std::shared_ptr<Backend>& primary,
+                     const std::vector<std::shared_ptr<Backend>>& replicas,
+                     v_uint64 first,
+                     bool read)
+      : m_primary(primary)
+      , m_replicas(replicas)
+      , m_first(first)
+      , m_attempt(0)
+      , m_read(read)
+    {}
+
+    Action act() override {
+      m_backend = onReplica() ? m_replicas[(m_first + m_attempt) % m_replicas.size()] : m_primary;
+      return m_backend->provider->getAsync().callbackTo(&AcquireCoroutine::onConnection);
+    }
+
+    Action onConnection(const provider::ResourceHandle<Connection>& connection) {
+      m_connection = track(m_backend, connection);
+      if (!m_connection && onReplica()) {
+        return next();
+      }
+      if (m_connection && m_read) {
+        m_backend->reads.fetch_add(1, std::memory_order_relaxed);
+      }
+      return _return(m_connection);
+    }
+
+    Action handleError(async::Error* error) override {
+      m_backend->failures.fetch_add(1, std::memory_order_relaxed);
+      if (onReplica()) {
+        OATPP_LOGW("RoutingExecutor", "Can't get replica connection: %s", error->what());
+        return next();
+      }
+      return async::AbstractCoroutine::handleError(error);
+    }
+
+  };
+
+  if (!extra.isReadOnly || m_replicas.empty()) {
+    return AcquireCoroutine::startForResult(m_primary, std::vector<std::shared_ptr<Backend>>(), 0, false);
+  }
+  return AcquireCoroutine::startForResult(m_primary, m_replicas, selectReplica(), true);
+
+}
+
+provider::ResourceHandle<orm::Connection> RoutingExecutor::getConnection() {
+  return wrapConnection(measureAcquisition([this]() {
+    return track(m_primary, m_primary->provider->get());
+  }));
+}
+
+void RoutingExecutor::setTemplateRoute(const oatpp::String& templateName, Route route) {
+  std::lock_guard<std::mutex> lock(m_templateRoutesMutex);
+  m_templateRoutes[templateName] = route;
+}
+
+data::share::StringTemplate RoutingExecutor::parseQueryTemplate(const oatpp::String& name,
+                                                                const oatpp::String& text,
+                                                                const ParamsTypeMap& paramsTypeMap,
+                                                                bool prepare) {
+
+  auto t = Executor::parseQueryTemplate(name, text, paramsTypeMap, prepare);
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(t.getExtraData());
+
+  std::lock_guard<std::mutex> lock(m_templateRoutesMutex);
+  auto it = m_templateRoutes.find(name);
+  if (it != m_templateRoutes.end() && it->second != Route::AUTO) {
+    extra->isReadOnly = it->second == Route::REPLICA;
+  }
+
+  return t;
+
+}
+
+RoutingExecutor::BackendStats RoutingExecutor::getPrimaryStats() const {
+  return m_primary->getStats();
+}
+
+std::vector<RoutingExecutor::BackendStats> RoutingExecutor::getReplicaStats() const {
+  std::vector<BackendStats> stats;
+  stats.reserve(m_replicas.size());
+  for (auto& replica : m_replicas) {
+    stats.push_back(replica->getStats());
+  }
+  return stats;
+}
+
+}}
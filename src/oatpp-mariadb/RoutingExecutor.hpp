@@ -0,0 +1,188 @@
+#ifndef oatpp_mariadb_RoutingExecutor_hpp
+#define oatpp_mariadb_RoutingExecutor_hpp
+
+#include "Executor.hpp"
+
+#include <atomic>
+
+namespace oatpp { namespace mariadb {
+
+/**
+ * Executor over one primary and several replica servers. <br>
+ * Read-only templates (&id:oatpp::mariadb::ql_template::Parser::isReadOnly;, or marked with
+ * &l:RoutingExecutor::setTemplateRoute ();) executed without a connection run on a replica picked by the
+ * &l:RoutingExecutor::Balancing; policy. Everything else runs on the primary - writes, raw and multi statements,
+ * batches, and every connection returned by &l:RoutingExecutor::getConnection ();, so queries executed inside
+ * `begin()`/`orm::Transaction`/&id:oatpp::mariadb::TransactionGuard; stay on the primary with their transaction. <br>
+ * A read falls over to the next replica if one can't give a connection, and to the primary if none can.
+ * Replicas lag behind the primary - read your own writes on the connection they were made on.
+ */
+class RoutingExecutor : public Executor {
+public:
+
+  /**
+   * How a replica is picked for a read.
+   */
+  enum class Balancing : v_int32 {
+
+    /**
+     * Replicas in turn.
+     */
+    ROUND_ROBIN = 0,
+
+    /**
+     * Replica with the fewest connections in use by this executor, ties in turn.
+     */
+    LEAST_IN_FLIGHT = 1
+
+  };
+
+  /**
+   * Where a template executed without a connection runs.
+   */
+  enum class Route : v_int32 {
+
+    /**
+     * On a replica if the statement is read-only, otherwise on the primary.
+     */
+    AUTO = 0,
+
+    /**
+     * Always on the primary - e.g. reads which must see the latest writes.
+     */
+    PRIMARY = 1,
+
+    /**
+     * Always on a replica - e.g. reads the parser doesn't recognize as read-only.
+     */
+    REPLICA = 2
+
+  };
+
+  /**
+   * Counters of one backend server.
+   */
+  struct BackendStats {
+
+    /**
+     * Connections taken from the backend.
+     */
+    v_uint64 acquisitions = 0;
+
+    /**
+     * Read-only templates routed to the backend.
+     */
+    v_uint64 reads = 0;
+
+    /**
+     * Connections taken from the backend and not yet released.
+     */
+    v_int64 inFlight = 0;
+
+    /**
+     * Failed attempts to take a connection.
+     */
+    v_uint64 failures = 0;
+
+  };
+
+private:
+
+  struct Backend {
+
+    std::shared_ptr<provider::Provider<Connection>> provider;
+    std::atomic<v_uint64> acquisitions{0};
+    std::atomic<v_uint64> reads{0};
+    std::atomic<v_int64> inFlight{0};
+    std::atomic<v_uint64> failures{0};
+
+    explicit Backend(const std::shared_ptr<provider::Provider<Connection>>& pProvider)
+      : provider(pProvider)
+    {}
+
+    BackendStats getStats() const;
+
+  };
+
+private:
+
+  /*
+   * Count the connection in flight until the last handle to it is released.
+   */
+  static provider::ResourceHandle<Connection> track(const std::shared_ptr<Backend>& backend,
+                                                    const provider::ResourceHandle<Connection>& connection);
+
+  v_uint64 selectReplica();
+
+private:
+  std::shared_ptr<Backend> m_primary;
+  std::vector<std::shared_ptr<Backend>> m_replicas;
+  Balancing m_balancing;
+  std::atomic<v_uint64> m_nextReplica;
+  std::unordered_map<oatpp::String, Route> m_templateRoutes;
+  std::mutex m_templateRoutesMutex;
+
+protected:
+
+  provider::ResourceHandle<Connection> acquireConnection(const ql_template::Parser::TemplateExtra& extra) override;
+
+  async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&>
+  acquireConnectionAsync(const ql_template::Parser::TemplateExtra& extra) override;
+
+public:
+
+  /**
+   * Constructor.
+   * @param primaryProvider - connection provider of the primary server.
+   * @param replicaProviders - connection providers of the replicas. Empty - everything runs on the primary.
+   * @param balancing - &l:RoutingExecutor::Balancing;.
+   */
+  RoutingExecutor(const std::shared_ptr<provider::Provider<Connection>>& primaryProvider,
+                  const std::vector<std::shared_ptr<provider::Provider<Connection>>>& replicaProviders,
+                  Balancing balancing = Balancing::ROUND_ROBIN);
+
+  /**
+   * Get connection to the primary server.
+   * @return
+   */
+  provider::ResourceHandle<orm::Connection> getConnection() override;
+
+  /**
+   * Route the named template explicitly instead of by &id:oatpp::mariadb::ql_template::Parser::isReadOnly;. <br>
+   * Applies to templates parsed by &l:RoutingExecutor::parseQueryTemplate (); after this call - configure the executor
+   * before creating the `DbClient` that declares the query.
+   * @param templateName - template name (name of the `QUERY`).
+   * @param route - &l:RoutingExecutor::Route;.
+   */
+  void setTemplateRoute(const oatpp::String& templateName, Route route);
+
+  /**
+   * Parse query template. Read-only detection is overridden by &l:RoutingExecutor::setTemplateRoute ();.
+   * @param name - template name.
+   * @param text - template text.
+   * @param paramsTypeMap - template parameter types.
+   * @param prepare - `true` if the query should use prepared statement, `false` otherwise.
+   * @return - &id:oatpp::data::share::StringTemplate;.
+   */
+  StringTemplate parseQueryTemplate(const oatpp::String& name,
+                                    const oatpp::String& text,
+                                    const ParamsTypeMap& paramsTypeMap,
+                                    bool prepare = false) override;
+
+  /**
+   * Get counters of the primary server.
+   * @return - &l:RoutingExecutor::BackendStats;.
+   */
+  BackendStats getPrimaryStats() const;
+
+  /**
+   * Get counters of the replicas.
+   * @return - &l:RoutingExecutor::BackendStats; of each replica, in the order the providers were given.
+   */
+  std::vector<BackendStats> getReplicaStats() const;
+
+};
+
+}}
+
+#endif // oatpp_mariadb_RoutingExecutor_hpp
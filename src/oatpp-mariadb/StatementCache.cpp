@@ -0,0 +1,140 @@
+#include "StatementCache.hpp"
+
+namespace oatpp { namespace mariadb {
+
+StatementCache::StatementCache(v_uint32 capacity)
+  : m_capacity(capacity)
+  , m_threadId(0)
+{}
+
+StatementCache::~StatementCache() {
+  clear();
+}
+
+void StatementCache::evictLast() {
+  auto& entry = m_entries.back();
+  OATPP_LOGD("StatementCache", "Evicting statement: %s", entry.query.c_str());
+  mysql_stmt_close(entry.stmt);
+  m_index.erase(entry.query);
+  m_entries.pop_back();
+  ++m_stats.evictions;
+}
+
+// A changed server thread id means the handle was reconnected and all server-side statements are gone.
+void StatementCache::checkConnection(MYSQL* mysql) {
+  auto threadId = mysql_thread_id(mysql);
+  if (threadId != m_threadId) {
+    if (!m_entries.empty()) {
+      OATPP_LOGD("StatementCache", "Connection thread id changed (%lu -> %lu). Dropping cached statements.", m_threadId, threadId);
+      clear();
+    }
+    m_threadId = threadId;
+  }
+}
+
+MYSQL_STMT* StatementCache::take(MYSQL* mysql, const oatpp::String& query, bool& needsReset) {
+
+  checkConnection(mysql);
+
+  auto it = m_index.find(*query);
+  if (it == m_index.end()) {
+    ++m_stats.misses;
+    needsReset = false;
+    return nullptr;
+  }
+
+  MYSQL_STMT* stmt = it->second->stmt;
+  needsReset = it->second->needsReset;
+  m_entries.erase(it->second);
+  m_index.erase(it);
+  ++m_stats.hits;
+  return stmt;
+
+}
+
+MYSQL_STMT* StatementCache::acquire(MYSQL* mysql, const oatpp::String& query) {
+
+  bool needsReset;
+  MYSQL_STMT* stmt = take(mysql, query, needsReset);
+  if (stmt) {
+    if (!needsReset) {
+      return stmt;
+    }
+    ++m_stats.resets;
+    if (mysql_stmt_reset(stmt) == 0) {
+      return stmt;
+    }
+    OATPP_LOGD("StatementCache", "Failed to reset cached statement: %s", mysql_stmt_error(stmt));
+    mysql_stmt_close(stmt);
+  }
+
+  stmt = mysql_stmt_init(mysql);
+  if (!stmt) {
+    throw std::runtime_error(std::string("[oatpp::mariadb::StatementCache::acquire()]: Error. Unable to initialize statement: ") +
+                             mysql_error(mysql));
+  }
+
+  if (mysql_stmt_prepare(stmt, query->c_str(), query->size())) {
+    std::string error = mysql_stmt_error(stmt);
+    mysql_stmt_close(stmt);
+    throw std::runtime_error("[oatpp::mariadb::StatementCache::acquire()]: Error. Unable to prepare statement: " + error);
+  }
+
+  return stmt;
+
+}
+
+void StatementCache::release(MYSQL* mysql, const oatpp::String& query, MYSQL_STMT* stmt, bool needsReset) {
+
+  if (!stmt) {
+    return;
+  }
+
+  if (!mysql || m_capacity == 0 || mysql_thread_id(mysql) != m_threadId || m_index.find(*query) != m_index.end()) {
+    mysql_stmt_close(stmt);
+    return;
+  }
+
+  // a failed execute may leave the statement half-way - e.g. with long data the server still holds
+  needsReset = needsReset || mysql_stmt_errno(stmt) != 0;
+
+  mysql_stmt_free_result(stmt);
+
+  m_entries.push_front({*query, stmt, needsReset});
+  m_index[*query] = m_entries.begin();
+
+  while (m_entries.size() > m_capacity) {
+    evictLast();
+  }
+
+}
+
+void StatementCache::clear() {
+  if (!m_entries.empty()) {
+    ++m_stats.invalidations;
+  }
+  for (auto& entry : m_entries) {
+    mysql_stmt_close(entry.stmt);
+  }
+  m_entries.clear();
+  m_index.clear();
+}
+
+void StatementCache::setCapacity(v_uint32 capacity) {
+  m_capacity = capacity;
+  while (m_entries.size() > m_capacity) {
+    evictLast();
+  }
+}
+
+v_uint32 StatementCache::getCapacity() const {
+  return m_capacity;
+}
+
+StatementCache::Stats StatementCache::getStats() const {
+  Stats stats = m_stats;
+  stats.size = m_entries.size();
+  return stats;
+}
+
+}}
@@ -0,0 +1,162 @@
+#ifndef oatpp_mariadb_StatementCache_hpp
+#define oatpp_mariadb_StatementCache_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+#include <list>
+#include <string>
+#include <unordered_map>
+
+namespace oatpp { namespace mariadb {
+
+/**
+ * LRU cache of prepared `MYSQL_STMT` handles owned by a single connection.
+ * Statements are keyed by the prepared query text. A statement is checked out of the cache
+ * for the lifetime of a &id:oatpp::mariadb::QueryResult; and put back when the result is destroyed,
+ * so the same statement is never used by two results at the same time.
+ * Not thread-safe - a connection is used by one thread at a time.
+ */
+class StatementCache {
+public:
+
+  /**
+   * Default maximum number of cached statements per connection.
+   */
+  static constexpr v_uint32 DEFAULT_CAPACITY = 64;
+
+  /**
+   * Cache statistics.
+   */
+  struct Stats {
+
+    /**
+     * Number of times a prepared statement was reused.
+     */
+    v_uint64 hits = 0;
+
+    /**
+     * Number of times a statement had to be prepared.
+     */
+    v_uint64 misses = 0;
+
+    /**
+     * Number of reused statements reset with `mysql_stmt_reset` (one round trip) because their previous use
+     * left server-side state behind.
+     */
+    v_uint64 resets = 0;
+
+    /**
+     * Number of statements closed because the cache was full.
+     */
+    v_uint64 evictions = 0;
+
+    /**
+     * Number of times the whole cache was dropped (connection closed or reconnected).
+     */
+    v_uint64 invalidations = 0;
+
+    /**
+     * Number of statements currently held by the cache.
+     */
+    v_uint64 size = 0;
+
+  };
+
+private:
+
+  struct Entry {
+    std::string query;
+    MYSQL_STMT* stmt;
+    bool needsReset;
+  };
+
+private:
+  void evictLast();
+  void checkConnection(MYSQL* mysql);
+private:
+  std::list<Entry> m_entries; // most recently used first
+  std::unordered_map<std::string, std::list<Entry>::iterator> m_index;
+  v_uint32 m_capacity;
+  unsigned long m_threadId;
+  Stats m_stats;
+public:
+
+  /**
+   * Constructor.
+   * @param capacity - maximum number of cached statements. `0` disables caching.
+   */
+  StatementCache(v_uint32 capacity = DEFAULT_CAPACITY);
+
+  /**
+   * Destructor. Closes all cached statements.
+   */
+  ~StatementCache();
+
+  StatementCache(const StatementCache&) = delete;
+  StatementCache& operator=(const StatementCache&) = delete;
+
+  /**
+   * Check out a prepared statement for the query. <br>
+   * If the statement is cached it is removed from the cache until &l:StatementCache::release ();. It's reused as is -
+   * without a round trip - unless it was released with `needsReset`, then it's reset with `mysql_stmt_reset` first.
+   * Otherwise a new statement is initialized and prepared.
+   * @param mysql - connection handle the statement belongs to.
+   * @param query - query text with `?` placeholders.
+   * @return - prepared statement. Throws `std::runtime_error` if the statement can't be prepared.
+   */
+  MYSQL_STMT* acquire(MYSQL* mysql, const oatpp::String& query);
+
+  /**
+   * Check out a cached statement for the query without resetting it. <br>
+   * Used by the non-blocking path which resets or prepares the statement itself.
+   * Return the statement with &l:StatementCache::release (); as usual.
+   * @param mysql - connection handle the statement belongs to.
+   * @param query - query text with `?` placeholders.
+   * @param needsReset - out. `true` if the statement must be reset with `mysql_stmt_reset` before it's executed.
+   * @return - cached statement or `nullptr` if the query has no cached statement.
+   */
+  MYSQL_STMT* take(MYSQL* mysql, const oatpp::String& query, bool& needsReset);
+
+  /**
+   * Return a statement previously obtained from &l:StatementCache::acquire (); back to the cache.
+   * Closes the statement if caching is disabled or a statement for the same query is already cached. <br>
+   * Its result is freed client-side (`mysql_stmt_free_result`). The next execute drops everything else, so the
+   * statement is only reset on reuse if `needsReset` is set or its last operation failed (`mysql_stmt_errno`).
+   * @param mysql - connection handle the statement belongs to. May be `nullptr` if the connection is gone.
+   * @param query - query text used to acquire the statement.
+   * @param stmt - statement.
+   * @param needsReset - the statement left server-side state behind - long data was sent, or it wasn't executed
+   * successfully after its parameters were bound.
+   */
+  void release(MYSQL* mysql, const oatpp::String& query, MYSQL_STMT* stmt, bool needsReset = false);
+
+  /**
+   * Close all cached statements.
+   */
+  void clear();
+
+  /**
+   * Set maximum number of cached statements. Evicts statements if needed.
+   * @param capacity - maximum number of cached statements. `0` disables caching.
+   */
+  void setCapacity(v_uint32 capacity);
+
+  /**
+   * Get maximum number of cached statements.
+   * @return
+   */
+  v_uint32 getCapacity() const;
+
+  /**
+   * Get cache statistics.
+   * @return - &l:StatementCache::Stats;.
+   */
+  Stats getStats() const;
+
+};
+
+}}
+
+#endif // oatpp_mariadb_StatementCache_hpp
@@ -0,0 +1,199 @@
+#include "TextQueryResult.hpp"
+
+namespace oatpp { namespace mariadb {
+
+TextQueryResult::TextQueryResult(const oatpp::String& query,
+                                 const provider::ResourceHandle<orm::Connection>& connection,
+                                 const std::shared_ptr<mapping::TextResultMapper>& resultMapper,
+                                 const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver)
+  : m_connection(connection)
+  , m_resultMapper(resultMapper)
+  , m_typeResolver(typeResolver)
+  , m_success(false)
+  , m_hasMoreResultSets(false)
+  , m_resultSetIndex(0)
+  , m_affectedRows(0)
+  , m_lastInsertId(0)
+  , m_inTransaction(false)
+{
+
+  MYSQL* mysql = getHandle();
+  if (!mysql) {
+    m_errorMessage = "MySQL connection handle is null";
+    return;
+  }
+
+  if (mysql_real_query(mysql, query->data(), query->size())) {
+    setError(mysql);
+    return;
+  }
+
+  loadResultSet(mysql);
+
+}
+
+TextQueryResult::~TextQueryResult() {
+  m_resultData.reset();
+  drain();
+}
+
+MYSQL* TextQueryResult::getHandle() const {
+  auto connection = std::static_pointer_cast<mariadb::Connection>(m_connection.object);
+  if (!connection || !connection->isHealthy()) {
+    return nullptr;
+  }
+  return connection->getHandle();
+}
+
+// The server sends the results of the remaining statements on its own - nothing else can be sent until they're read
+void TextQueryResult::setMoreResultSets(bool hasMore) {
+  if (hasMore != m_hasMoreResultSets) {
+    std::static_pointer_cast<mariadb::Connection>(m_connection.object)->setBusy(hasMore);
+  }
+  m_hasMoreResultSets = hasMore;
+}
+
+void TextQueryResult::setError(MYSQL* mysql) {
+  m_success = false;
+  setMoreResultSets(false);
+  m_errorMessage = mysql_error(mysql);
+  auto connection = std::static_pointer_cast<mariadb::Connection>(m_connection.object);
+  if (connection->isHealthy() && connection->reportError(mysql_errno(mysql)) && m_connection.invalidator) {
+    // evict the connection from the pool
+    m_connection.invalidator->invalidate(m_connection.object);
+  }
+}
+
+void TextQueryResult::loadResultSet(MYSQL* mysql) {
+
+  MYSQL_RES* result = mysql_store_result(mysql);
+  if (!result && mysql_field_count(mysql) > 0) {
+    // the statement should have returned a result set but reading it failed
+    setError(mysql);
+    return;
+  }
+
+  m_success = true;
+  m_errorMessage = nullptr;
+  m_affectedRows = static_cast<v_int64>(mysql_affected_rows(mysql));
+  m_lastInsertId = static_cast<v_int64>(mysql_insert_id(mysql));
+  setMoreResultSets(mysql_more_results(mysql));
+  m_inTransaction = std::static_pointer_cast<mariadb::Connection>(m_connection.object)->isInTransaction();
+
+  if (result) {
+    m_resultData = std::make_unique<mapping::TextResultMapper::ResultData>(result, m_typeResolver);
+  }
+
+}
+
+// All results of a multi-statement query must be read before the connection can send the next command
+void TextQueryResult::drain() {
+  while (m_hasMoreResultSets) {
+    MYSQL* mysql = getHandle();
+    if (!mysql) {
+      setMoreResultSets(false);
+      return;
+    }
+    auto status = mysql_next_result(mysql);
+    if (status != 0) {
+      if (status > 0) {
+        setError(mysql);
+      }
+      setMoreResultSets(false);
+      return;
+    }
+    MYSQL_RES* result = mysql_store_result(mysql);
+    if (result) {
+      mysql_free_result(result);
+    }
+    setMoreResultSets(mysql_more_results(mysql));
+  }
+}
+
+bool TextQueryResult::nextResultSet() {
+
+  m_resultData.reset();
+
+  if (!m_hasMoreResultSets) {
+    return false;
+  }
+
+  MYSQL* mysql = getHandle();
+  if (!mysql) {
+    setMoreResultSets(false);
+    return false;
+  }
+
+  ++m_resultSetIndex;
+  auto status = mysql_next_result(mysql);
+  if (status > 0) {
+    // the statement failed - the server doesn't execute the statements after it
+    setError(mysql);
+    return true;
+  }
+  if (status < 0) {
+    setMoreResultSets(false);
+    return false;
+  }
+
+  loadResultSet(mysql);
+  return true;
+
+}
+
+provider::ResourceHandle<orm::Connection> TextQueryResult::getConnection() const {
+  return m_connection;
+}
+
+bool TextQueryResult::isSuccess() const {
+  return m_success;
+}
+
+oatpp::String TextQueryResult::getErrorMessage() const {
+  return m_errorMessage;
+}
+
+v_int64 TextQueryResult::getPosition() const {
+  return m_resultData ? m_resultData->rowIndex : 0;
+}
+
+v_int64 TextQueryResult::getKnownCount() const {
+  return m_resultData ? static_cast<v_int64>(mysql_num_rows(m_resultData->result)) : 0;
+}
+
+bool TextQueryResult::hasMoreToFetch() const {
+  return m_resultData && m_resultData->hasMore;
+}
+
+oatpp::Void TextQueryResult::fetch(const oatpp::Type* const type, v_int64 count) {
+  if (!m_resultData) {
+    return nullptr;
+  }
+  return m_resultMapper->readRows(m_resultData.get(), type, count);
+}
+
+bool TextQueryResult::hasMoreResultSets() const {
+  return m_hasMoreResultSets;
+}
+
+v_int32 TextQueryResult::getResultSetIndex() const {
+  return m_resultSetIndex;
+}
+
+bool TextQueryResult::hasResultSet() const {
+  return m_resultData != nullptr;
+}
+
+v_int64 TextQueryResult::getAffectedRows() const {
+  return m_affectedRows;
+}
+
+v_int64 TextQueryResult::getLastInsertId() const {
+  return m_lastInsertId;
+}
+
+bool TextQueryResult::isInTransaction() const {
+  return m_inTransaction;
+}
+
+}}
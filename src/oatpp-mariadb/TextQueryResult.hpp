@@ -0,0 +1,122 @@
+#ifndef oatpp_mariadb_TextQueryResult_hpp
+#define oatpp_mariadb_TextQueryResult_hpp
+
+#include "oatpp/core/provider/Pool.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+#include "Connection.hpp"
+#include "mapping/TextResultMapper.hpp"
+#include "oatpp/orm/QueryResult.hpp"
+
+namespace oatpp { namespace mariadb {
+
+/**
+ * Result of a query sent over the text protocol (`mysql_real_query`). <br>
+ * The query may contain several `;`-separated statements (the connection is opened with `CLIENT_MULTI_STATEMENTS`).
+ * They are sent in one packet and their results are read one after another with &l:TextQueryResult::nextResultSet ();.
+ * While results of further statements are pending the connection is busy (&id:oatpp::mariadb::Connection::isBusy;) -
+ * read them or destroy the result before sending the next command. Remaining results are drained when the object
+ * is destroyed, so the connection stays usable.
+ */
+class TextQueryResult : public orm::QueryResult {
+private:
+  provider::ResourceHandle<orm::Connection> m_connection;
+  std::shared_ptr<mapping::TextResultMapper> m_resultMapper;
+  std::shared_ptr<const data::mapping::TypeResolver> m_typeResolver;
+  std::unique_ptr<mapping::TextResultMapper::ResultData> m_resultData;
+  oatpp::String m_errorMessage;
+  bool m_success;
+  bool m_hasMoreResultSets;
+  v_int32 m_resultSetIndex;
+  v_int64 m_affectedRows;
+  v_int64 m_lastInsertId;
+  bool m_inTransaction;
+private:
+  MYSQL* getHandle() const;
+  void setError(MYSQL* mysql);
+  void setMoreResultSets(bool hasMore);
+  void loadResultSet(MYSQL* mysql);
+  void drain();
+public:
+
+  /**
+   * Constructor. Sends the query and reads the first result.
+   * @param query - one or more `;`-separated SQL statements.
+   * @param connection - connection to send the query over.
+   * @param resultMapper - &id:oatpp::mariadb::mapping::TextResultMapper;.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   */
+  TextQueryResult(const oatpp::String& query,
+                  const provider::ResourceHandle<orm::Connection>& connection,
+                  const std::shared_ptr<mapping::TextResultMapper>& resultMapper,
+                  const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver);
+
+  /**
+   * Destructor. Frees the current result and drains results of remaining statements.
+   */
+  ~TextQueryResult() override;
+
+  provider::ResourceHandle<orm::Connection> getConnection() const override;
+
+  bool isSuccess() const override;
+
+  oatpp::String getErrorMessage() const override;
+
+  v_int64 getPosition() const override;
+
+  v_int64 getKnownCount() const override;
+
+  bool hasMoreToFetch() const override;
+
+  oatpp::Void fetch(const oatpp::Type* const type, v_int64 count) override;
+
+  /**
+   * Move to the result of the next statement. Unread rows of the current result are discarded.
+   * @return - `true` if the next statement's result is available (check &l:TextQueryResult::isSuccess (); for its status),
+   * `false` if there are no more statements.
+   */
+  bool nextResultSet();
+
+  /**
+   * Check if results of more statements follow the current one.
+   * @return
+   */
+  bool hasMoreResultSets() const;
+
+  /**
+   * Index of the current statement in the query, starting from `0`.
+   * @return
+   */
+  v_int32 getResultSetIndex() const;
+
+  /**
+   * Check if the current statement returned a result set (as opposed to an OK packet).
+   * @return
+   */
+  bool hasResultSet() const;
+
+  /**
+   * Number of rows affected by the current statement. For result sets - number of rows in the result.
+   * @return
+   */
+  v_int64 getAffectedRows() const;
+
+  /**
+   * AUTO_INCREMENT id generated by the current statement.
+   * @return
+   */
+  v_int64 getLastInsertId() const;
+
+  /**
+   * Check if the connection was inside a transaction right after the current statement.
+   * @return
+   */
+  bool isInTransaction() const;
+
+};
+
+}}
+
+#endif // oatpp_mariadb_TextQueryResult_hpp
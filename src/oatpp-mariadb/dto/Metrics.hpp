@@ -0,0 +1,145 @@
+#ifndef oatpp_mariadb_dto_Metrics_hpp
+#define oatpp_mariadb_dto_Metrics_hpp
+
+#include "oatpp-mariadb/ConnectionPool.hpp"
+#include "oatpp-mariadb/Executor.hpp"
+#include "oatpp-mariadb/metrics/Histogram.hpp"
+#include "oatpp-mariadb/metrics/QueryMetrics.hpp"
+
+#include "oatpp/core/macro/codegen.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace mariadb { namespace dto {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+/**
+ * Summary of a &id:oatpp::mariadb::metrics::Histogram::Snapshot;. Values in microseconds.
+ */
+class HistogramDto : public oatpp::DTO {
+
+  DTO_INIT(HistogramDto, DTO);
+
+  DTO_FIELD(UInt64, count, "count");
+  DTO_FIELD(Float64, mean, "mean");
+  DTO_FIELD(UInt64, p50, "p50");
+  DTO_FIELD(UInt64, p90, "p90");
+  DTO_FIELD(UInt64, p99, "p99");
+  DTO_FIELD(UInt64, p999, "p999");
+  DTO_FIELD(UInt64, max, "max");
+
+  static oatpp::Object<HistogramDto> fromSnapshot(const metrics::Histogram::Snapshot& snapshot) {
+    auto dto = HistogramDto::createShared();
+    dto->count = snapshot.count;
+    dto->mean = snapshot.getMean();
+    dto->p50 = snapshot.getPercentile(0.5);
+    dto->p90 = snapshot.getPercentile(0.9);
+    dto->p99 = snapshot.getPercentile(0.99);
+    dto->p999 = snapshot.getPercentile(0.999);
+    dto->max = snapshot.max;
+    return dto;
+  }
+
+};
+
+/**
+ * &id:oatpp::mariadb::ConnectionPool::Stats; for health endpoints.
+ */
+class PoolStatsDto : public oatpp::DTO {
+
+  DTO_INIT(PoolStatsDto, DTO);
+
+  DTO_FIELD(UInt32, maxConnections, "max_connections");
+  DTO_FIELD(UInt32, size, "size");
+  DTO_FIELD(UInt32, inUse, "in_use");
+  DTO_FIELD(UInt32, idle, "idle");
+  DTO_FIELD(UInt32, waiting, "waiting");
+  DTO_FIELD(UInt64, acquisitions, "acquisitions");
+  DTO_FIELD(UInt64, timeouts, "timeouts");
+  DTO_FIELD(UInt64, creations, "creations");
+  DTO_FIELD(UInt64, creationFailures, "creation_failures");
+  DTO_FIELD(UInt64, evictions, "evictions");
+  DTO_FIELD(UInt64, expirations, "expirations");
+  DTO_FIELD(UInt64, discards, "discards");
+  DTO_FIELD(Object<HistogramDto>, acquireWait, "acquire_wait_us");
+  DTO_FIELD(Object<HistogramDto>, creationLatency, "creation_latency_us");
+
+  static oatpp::Object<PoolStatsDto> fromStats(const ConnectionPool::Stats& stats) {
+    auto dto = PoolStatsDto::createShared();
+    dto->maxConnections = stats.maxConnections;
+    dto->size = stats.size;
+    dto->inUse = stats.inUse;
+    dto->idle = stats.idle;
+    dto->waiting = stats.waiting;
+    dto->acquisitions = stats.acquisitions;
+    dto->timeouts = stats.timeouts;
+    dto->creations = stats.creations;
+    dto->creationFailures = stats.creationFailures;
+    dto->evictions = stats.evictions;
+    dto->expirations = stats.expirations;
+    dto->discards = stats.discards;
+    dto->acquireWait = HistogramDto::fromSnapshot(stats.acquireWait);
+    dto->creationLatency = HistogramDto::fromSnapshot(stats.creationLatency);
+    return dto;
+  }
+
+};
+
+/**
+ * &id:oatpp::mariadb::Executor::ConnectionStats; for health endpoints.
+ */
+class ConnectionStatsDto : public oatpp::DTO {
+
+  DTO_INIT(ConnectionStatsDto, DTO);
+
+  DTO_FIELD(UInt64, acquisitions, "acquisitions");
+  DTO_FIELD(UInt64, failures, "failures");
+  DTO_FIELD(Object<HistogramDto>, acquireWait, "acquire_wait_us");
+
+  static oatpp::Object<ConnectionStatsDto> fromStats(const Executor::ConnectionStats& stats) {
+    auto dto = ConnectionStatsDto::createShared();
+    dto->acquisitions = stats.acquisitions;
+    dto->failures = stats.failures;
+    dto->acquireWait = HistogramDto::fromSnapshot(stats.acquireWait);
+    return dto;
+  }
+
+};
+
+/**
+ * &id:oatpp::mariadb::metrics::TemplateMetrics::Snapshot; for health endpoints. Phases are keyed by
+ * &id:oatpp::mariadb::metrics::TemplateMetrics::getPhaseName;.
+ */
+class TemplateMetricsDto : public oatpp::DTO {
+
+  DTO_INIT(TemplateMetricsDto, DTO);
+
+  DTO_FIELD(String, templateName, "template");
+  DTO_FIELD(Fields<Object<HistogramDto>>, phases, "phases_us");
+
+  static oatpp::Object<TemplateMetricsDto> fromSnapshot(const metrics::TemplateMetrics::Snapshot& snapshot) {
+    auto dto = TemplateMetricsDto::createShared();
+    dto->templateName = snapshot.templateName;
+    dto->phases = oatpp::Fields<oatpp::Object<HistogramDto>>({});
+    for (v_int32 i = 0; i < metrics::TemplateMetrics::PHASE_COUNT; i++) {
+      auto phase = static_cast<metrics::TemplateMetrics::Phase>(i);
+      dto->phases->push_back({metrics::TemplateMetrics::getPhaseName(phase), HistogramDto::fromSnapshot(snapshot.get(phase))});
+    }
+    return dto;
+  }
+
+  static oatpp::Vector<oatpp::Object<TemplateMetricsDto>> fromSnapshots(const std::vector<metrics::TemplateMetrics::Snapshot>& snapshots) {
+    oatpp::Vector<oatpp::Object<TemplateMetricsDto>> dtos({});
+    for (auto& snapshot : snapshots) {
+      dtos->push_back(fromSnapshot(snapshot));
+    }
+    return dtos;
+  }
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}}}
+
+#endif // oatpp_mariadb_dto_Metrics_hpp
@@ -0,0 +1,218 @@
+#include "BatchSerializer.hpp"
+
+#include <cstring>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+BatchSerializer::Batch::Batch(v_uint32 paramCount, v_uint32 rowCount)
+  : m_columns(paramCount)
+  , m_rowCount(rowCount)
+{
+  for(auto& column : m_columns) {
+    column.indicators.assign(rowCount, STMT_INDICATOR_NULL);
+  }
+}
+
+void BatchSerializer::Batch::bind(MYSQL_STMT* stmt) {
+
+  if (!stmt) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::BatchSerializer::Batch::bind()]: Error. MySQL statement is null.");
+  }
+
+  m_binds.resize(m_columns.size());
+  for(size_t i = 0; i < m_columns.size(); i++) {
+    auto& column = m_columns[i];
+    auto& bind = m_binds[i];
+    std::memset(&bind, 0, sizeof(MYSQL_BIND));
+    bind.buffer_type = column.bufferType;
+    bind.is_unsigned = column.isUnsigned;
+    bind.u.indicator = column.indicators.data();
+    if(column.elementSize > 0) {
+      bind.buffer = column.values.data();
+      bind.buffer_length = column.elementSize;
+    } else if(column.bufferType != MYSQL_TYPE_NULL) {
+      // variable-length column: buffer is an array of pointers
+      bind.buffer = column.pointers.data();
+      bind.length = column.lengths.data();
+    }
+  }
+
+  unsigned int arraySize = m_rowCount;
+  if(mysql_stmt_attr_set(stmt, STMT_ATTR_ARRAY_SIZE, &arraySize)) {
+    throw std::runtime_error(std::string("[oatpp::mariadb::mapping::BatchSerializer::Batch::bind()]: Error. Can't set array size: ") +
+                             mysql_stmt_error(stmt));
+  }
+
+  if(!m_binds.empty() && mysql_stmt_bind_param(stmt, m_binds.data())) {
+    throw std::runtime_error(std::string("[oatpp::mariadb::mapping::BatchSerializer::Batch::bind()]: Error. Can't bind parameters: ") +
+                             mysql_stmt_error(stmt));
+  }
+
+}
+
+v_uint32 BatchSerializer::Batch::getRowCount() const {
+  return m_rowCount;
+}
+
+BatchSerializer::BatchSerializer() {
+
+  m_methods.resize(data::mapping::type::ClassId::getClassCount(), nullptr);
+
+  setSerializerMethod(data::mapping::type::__class::String::CLASS_ID, &BatchSerializer::serializeString);
+  setSerializerMethod(data::mapping::type::__class::Boolean::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::Boolean, signed char, MYSQL_TYPE_TINY, false>);
+
+  setSerializerMethod(data::mapping::type::__class::Int8::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::Int8, v_int8, MYSQL_TYPE_TINY, false>);
+  setSerializerMethod(data::mapping::type::__class::UInt8::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::UInt8, v_uint8, MYSQL_TYPE_TINY, true>);
+
+  setSerializerMethod(data::mapping::type::__class::Int16::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::Int16, v_int16, MYSQL_TYPE_SHORT, false>);
+  setSerializerMethod(data::mapping::type::__class::UInt16::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::UInt16, v_uint16, MYSQL_TYPE_SHORT, true>);
+
+  setSerializerMethod(data::mapping::type::__class::Int32::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::Int32, v_int32, MYSQL_TYPE_LONG, false>);
+  setSerializerMethod(data::mapping::type::__class::UInt32::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::UInt32, v_uint32, MYSQL_TYPE_LONG, true>);
+
+  setSerializerMethod(data::mapping::type::__class::Int64::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::Int64, v_int64, MYSQL_TYPE_LONGLONG, false>);
+  setSerializerMethod(data::mapping::type::__class::UInt64::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::UInt64, v_uint64, MYSQL_TYPE_LONGLONG, true>);
+
+  setSerializerMethod(data::mapping::type::__class::Float32::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::Float32, v_float32, MYSQL_TYPE_FLOAT, false>);
+  setSerializerMethod(data::mapping::type::__class::Float64::CLASS_ID,
+                      &BatchSerializer::serializeFixed<oatpp::Float64, v_float64, MYSQL_TYPE_DOUBLE, false>);
+
+  setSerializerMethod(data::mapping::type::__class::AbstractEnum::CLASS_ID, &BatchSerializer::serializeEnum);
+
+}
+
+void BatchSerializer::setSerializerMethod(const data::mapping::type::ClassId& classId, SerializerMethod method) {
+  const v_uint32 id = classId.id;
+  if(id >= m_methods.size()) {
+    m_methods.resize(id + 1, nullptr);
+  }
+  m_methods[id] = method;
+}
+
+void BatchSerializer::serialize(Batch& batch, v_uint32 paramIndex, v_uint32 rowIndex, const oatpp::Void& polymorph) const {
+
+  if(paramIndex >= batch.m_columns.size() || rowIndex >= batch.m_rowCount) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::BatchSerializer::serialize()]: Error. Parameter index out of range.");
+  }
+
+  auto id = polymorph.getValueType()->classId.id;
+  auto method = id < m_methods.size() ? m_methods[id] : nullptr;
+
+  if(method) {
+    (*method)(batch.m_columns[paramIndex], rowIndex, polymorph);
+  } else {
+    throw std::runtime_error("[oatpp::mariadb::mapping::BatchSerializer::serialize()]: "
+                             "Error. No serialize method for type '" + std::string(polymorph.getValueType()->classId.name) +
+                             "'");
+  }
+
+}
+
+void BatchSerializer::resetArraySize(MYSQL_STMT* stmt) {
+  unsigned int arraySize = 0;
+  mysql_stmt_attr_set(stmt, STMT_ATTR_ARRAY_SIZE, &arraySize);
+}
+
+// All rows of a column are sent with one buffer type, so the first non-null value decides it.
+void BatchSerializer::initColumn(Column& column, enum_field_types bufferType, bool isUnsigned, v_buff_size elementSize) {
+
+  if(column.bufferType == MYSQL_TYPE_NULL) {
+    column.bufferType = bufferType;
+    column.isUnsigned = isUnsigned;
+    column.elementSize = elementSize;
+    auto rowCount = column.indicators.size();
+    if(elementSize > 0) {
+      column.values.assign(rowCount * elementSize, 0);
+    } else {
+      column.strings.resize(rowCount);
+      column.pointers.assign(rowCount, nullptr);
+      column.lengths.assign(rowCount, 0);
+    }
+    return;
+  }
+
+  bool isVariable = column.elementSize == 0;
+  if(isVariable && elementSize == 0) {
+    return; // STRING and BLOB rows may be mixed
+  }
+
+  if(column.bufferType != bufferType || column.isUnsigned != isUnsigned || column.elementSize != elementSize) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::BatchSerializer::initColumn()]: "
+                             "Error. Parameter type differs between rows of the batch.");
+  }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Serializer functions
+
+template<class Wrapper, typename T, enum_field_types TYPE, bool UNSIGNED>
+void BatchSerializer::serializeFixed(Column& column, v_uint32 rowIndex, const oatpp::Void& polymorph) {
+  auto value = polymorph.cast<Wrapper>();
+  if(!value) {
+    return;
+  }
+  initColumn(column, TYPE, UNSIGNED, sizeof(T));
+  T v = static_cast<T>(*value);
+  std::memcpy(column.values.data() + rowIndex * sizeof(T), &v, sizeof(T));
+  column.indicators[rowIndex] = STMT_INDICATOR_NONE;
+}
+
+void BatchSerializer::serializeString(Column& column, v_uint32 rowIndex, const oatpp::Void& polymorph) {
+
+  auto str = polymorph.cast<oatpp::String>();
+  if(!str) {
+    return;
+  }
+
+  // Same rule as Serializer::serializeString - non-printable characters make the value binary
+  bool isBinary = false;
+  for(unsigned char c : *str) {
+    if(c > 127 || (c < 32 && c != '\t' && c != '\n' && c != '\r')) {
+      isBinary = true;
+      break;
+    }
+  }
+
+  initColumn(column, MYSQL_TYPE_STRING, false, 0);
+  if(isBinary) {
+    column.bufferType = MYSQL_TYPE_BLOB;
+  }
+
+  column.strings[rowIndex] = str;
+  column.pointers[rowIndex] = str->data();
+  column.lengths[rowIndex] = str->size();
+  column.indicators[rowIndex] = STMT_INDICATOR_NONE;
+
+}
+
+void BatchSerializer::serializeEnum(Column& column, v_uint32 rowIndex, const oatpp::Void& polymorph) {
+
+  if(!polymorph) {
+    return;
+  }
+
+  auto polymorphicDispatcher = static_cast<const data::mapping::type::__class::AbstractEnum::PolymorphicDispatcher*>(
+    polymorph.getValueType()->polymorphicDispatcher
+  );
+  data::mapping::type::EnumInterpreterError e = data::mapping::type::EnumInterpreterError::OK;
+  auto interpretation = polymorphicDispatcher->toInterpretation(polymorph, e);
+  if(e != data::mapping::type::EnumInterpreterError::OK) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::BatchSerializer::serializeEnum()]: Error. Can't interpret enum value.");
+  }
+
+  serializeString(column, rowIndex, interpretation);
+
+}
+
+}}}
@@ -0,0 +1,137 @@
+#ifndef oatpp_mariadb_mapping_BatchSerializer_hpp
+#define oatpp_mariadb_mapping_BatchSerializer_hpp
+
+#include "oatpp/core/data/mapping/TypeResolver.hpp"
+#include "oatpp/core/Types.hpp"
+#include <mysql/mysql.h>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+/**
+ * Batch-aware variant of &id:oatpp::mariadb::mapping::Serializer;. <br>
+ * Serializes values of many parameter rows into column-wise arrays for MariaDB array binding
+ * (`STMT_ATTR_ARRAY_SIZE`). NULL values are passed with `STMT_INDICATOR_NULL`.
+ */
+class BatchSerializer {
+public:
+
+  /**
+   * Column-wise values of one query parameter.
+   */
+  struct Column {
+
+    /**
+     * MariaDB buffer type. `MYSQL_TYPE_NULL` until the first non-null value is serialized.
+     */
+    enum_field_types bufferType = MYSQL_TYPE_NULL;
+
+    /**
+     * Unsigned flag of integer types.
+     */
+    bool isUnsigned = false;
+
+    /**
+     * Size of one fixed-size value. `0` for variable-length types.
+     */
+    v_buff_size elementSize = 0;
+
+    /**
+     * Fixed-size values - `elementSize * rowCount` bytes.
+     */
+    std::vector<char> values;
+
+    /**
+     * Variable-length values. Keeps the data referenced by `pointers` alive.
+     */
+    std::vector<oatpp::String> strings;
+
+    /**
+     * Pointers to variable-length values.
+     */
+    std::vector<const char*> pointers;
+
+    /**
+     * Lengths of variable-length values.
+     */
+    std::vector<unsigned long> lengths;
+
+    /**
+     * `STMT_INDICATOR_NONE` or `STMT_INDICATOR_NULL` per row.
+     */
+    std::vector<char> indicators;
+
+  };
+
+  /**
+   * Parameter arrays for one execution of a statement.
+   */
+  class Batch {
+    friend BatchSerializer;
+  private:
+    std::vector<Column> m_columns;
+    std::vector<MYSQL_BIND> m_binds;
+    v_uint32 m_rowCount;
+  public:
+
+    /**
+     * Constructor. All values are NULL initially.
+     * @param paramCount - number of query parameters.
+     * @param rowCount - number of parameter rows.
+     */
+    Batch(v_uint32 paramCount, v_uint32 rowCount);
+
+    /**
+     * Set `STMT_ATTR_ARRAY_SIZE` and bind parameter arrays to the statement.
+     * @param stmt - prepared statement.
+     */
+    void bind(MYSQL_STMT* stmt);
+
+    /**
+     * Get number of parameter rows.
+     * @return
+     */
+    v_uint32 getRowCount() const;
+
+  };
+
+public:
+  typedef void (*SerializerMethod)(Column&, v_uint32, const oatpp::Void&);
+private:
+  static void initColumn(Column& column, enum_field_types bufferType, bool isUnsigned, v_buff_size elementSize);
+private:
+  std::vector<SerializerMethod> m_methods;
+public:
+
+  BatchSerializer();
+
+  void setSerializerMethod(const data::mapping::type::ClassId& classId, SerializerMethod method);
+
+  /**
+   * Serialize value of one parameter in one row.
+   * @param batch - &l:BatchSerializer::Batch;.
+   * @param paramIndex - index of the query parameter.
+   * @param rowIndex - index of the parameter row.
+   * @param polymorph - value.
+   */
+  void serialize(Batch& batch, v_uint32 paramIndex, v_uint32 rowIndex, const oatpp::Void& polymorph) const;
+
+  /**
+   * Reset `STMT_ATTR_ARRAY_SIZE` so the statement can be executed with single-row parameters again.
+   * @param stmt - prepared statement.
+   */
+  static void resetArraySize(MYSQL_STMT* stmt);
+
+private:
+
+  template<class Wrapper, typename T, enum_field_types TYPE, bool UNSIGNED>
+  static void serializeFixed(Column& column, v_uint32 rowIndex, const oatpp::Void& polymorph);
+
+  static void serializeString(Column& column, v_uint32 rowIndex, const oatpp::Void& polymorph);
+
+  static void serializeEnum(Column& column, v_uint32 rowIndex, const oatpp::Void& polymorph);
+
+};
+
+}}}
+
+#endif // oatpp_mariadb_mapping_BatchSerializer_hpp
@@ -0,0 +1,201 @@
+#include "ColumnarResult.hpp"
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+oatpp::String ColumnarResult::Column::getString(v_int64 row) const {
+  if (isNull(row)) {
+    return nullptr;
+  }
+  return oatpp::String(getStringData(row), getStringSize(row));
+}
+
+ColumnarResult::ColumnarResult()
+  : m_rowCount(0)
+{}
+
+void ColumnarResult::init(const std::vector<MYSQL_BIND>& binds, const std::vector<oatpp::String>& names, v_int64 expectedRows) {
+
+  m_columns.clear();
+  m_appenders.clear();
+  m_rowCount = 0;
+
+  m_columns.resize(binds.size());
+  m_appenders.resize(binds.size());
+
+  const auto reserveRows = static_cast<size_t>(expectedRows > 0 ? expectedRows : 0);
+
+  for (size_t i = 0; i < binds.size(); i++) {
+
+    const MYSQL_BIND& bind = binds[i];
+    Column& column = m_columns[i];
+    column.name = i < names.size() ? names[i] : nullptr;
+    column.isUnsigned = bind.is_unsigned;
+    column.nullCount = 0;
+    column.nullBitmap.reserve((reserveRows + 63) / 64);
+
+    switch (bind.buffer_type) {
+      case MYSQL_TYPE_TINY:
+        column.type = ColumnType::INT64;
+        m_appenders[i] = &ColumnarResult::appendInt8;
+        break;
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_YEAR:
+        column.type = ColumnType::INT64;
+        m_appenders[i] = &ColumnarResult::appendInt16;
+        break;
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_INT24:
+        column.type = ColumnType::INT64;
+        m_appenders[i] = &ColumnarResult::appendInt32;
+        break;
+      case MYSQL_TYPE_LONGLONG:
+      case MYSQL_TYPE_BIT:
+        column.type = ColumnType::INT64;
+        column.isUnsigned = bind.is_unsigned || bind.buffer_type == MYSQL_TYPE_BIT;
+        m_appenders[i] = &ColumnarResult::appendInt64;
+        break;
+      case MYSQL_TYPE_FLOAT:
+        column.type = ColumnType::DOUBLE;
+        m_appenders[i] = &ColumnarResult::appendFloat;
+        break;
+      case MYSQL_TYPE_DOUBLE:
+        column.type = ColumnType::DOUBLE;
+        m_appenders[i] = &ColumnarResult::appendDouble;
+        break;
+      default:
+        column.type = ColumnType::STRING;
+        m_appenders[i] = &ColumnarResult::appendString;
+        break;
+    }
+
+    switch (column.type) {
+      case ColumnType::INT64:
+        column.int64Values.reserve(reserveRows);
+        break;
+      case ColumnType::DOUBLE:
+        column.doubleValues.reserve(reserveRows);
+        break;
+      case ColumnType::STRING:
+        column.offsets.reserve(reserveRows + 1);
+        column.offsets.push_back(0);
+        break;
+    }
+
+  }
+
+}
+
+void ColumnarResult::setNull(Column& column, v_int64 row) {
+  column.nullBitmap[row >> 6] |= (v_uint64) 1 << (row & 63);
+  column.nullCount++;
+}
+
+void ColumnarResult::appendInt8(Column& column, const MYSQL_BIND& bind, v_int64 row) {
+  if (*bind.is_null) {
+    setNull(column, row);
+    column.int64Values.push_back(0);
+  } else if (column.isUnsigned) {
+    column.int64Values.push_back(*static_cast<const uint8_t*>(bind.buffer));
+  } else {
+    column.int64Values.push_back(*static_cast<const int8_t*>(bind.buffer));
+  }
+}
+
+void ColumnarResult::appendInt16(Column& column, const MYSQL_BIND& bind, v_int64 row) {
+  if (*bind.is_null) {
+    setNull(column, row);
+    column.int64Values.push_back(0);
+  } else if (column.isUnsigned) {
+    column.int64Values.push_back(*static_cast<const uint16_t*>(bind.buffer));
+  } else {
+    column.int64Values.push_back(*static_cast<const int16_t*>(bind.buffer));
+  }
+}
+
+void ColumnarResult::appendInt32(Column& column, const MYSQL_BIND& bind, v_int64 row) {
+  if (*bind.is_null) {
+    setNull(column, row);
+    column.int64Values.push_back(0);
+  } else if (column.isUnsigned) {
+    column.int64Values.push_back(*static_cast<const uint32_t*>(bind.buffer));
+  } else {
+    column.int64Values.push_back(*static_cast<const int32_t*>(bind.buffer));
+  }
+}
+
+void ColumnarResult::appendInt64(Column& column, const MYSQL_BIND& bind, v_int64 row) {
+  if (*bind.is_null) {
+    setNull(column, row);
+    column.int64Values.push_back(0);
+  } else {
+    column.int64Values.push_back(*static_cast<const int64_t*>(bind.buffer));
+  }
+}
+
+void ColumnarResult::appendFloat(Column& column, const MYSQL_BIND& bind, v_int64 row) {
+  if (*bind.is_null) {
+    setNull(column, row);
+    column.doubleValues.push_back(0);
+  } else {
+    column.doubleValues.push_back(*static_cast<const float*>(bind.buffer));
+  }
+}
+
+void ColumnarResult::appendDouble(Column& column, const MYSQL_BIND& bind, v_int64 row) {
+  if (*bind.is_null) {
+    setNull(column, row);
+    column.doubleValues.push_back(0);
+  } else {
+    column.doubleValues.push_back(*static_cast<const double*>(bind.buffer));
+  }
+}
+
+void ColumnarResult::appendString(Column& column, const MYSQL_BIND& bind, v_int64 row) {
+  if (*bind.is_null) {
+    setNull(column, row);
+  } else {
+    auto begin = static_cast<const char*>(bind.buffer);
+    column.data.insert(column.data.end(), begin, begin + *bind.length);
+  }
+  column.offsets.push_back(column.data.size());
+}
+
+void ColumnarResult::appendRow(const std::vector<MYSQL_BIND>& binds) {
+
+  const v_int64 row = m_rowCount;
+  const bool newBitmapWord = (row & 63) == 0;
+
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    Column& column = m_columns[i];
+    if (newBitmapWord) {
+      column.nullBitmap.push_back(0);
+    }
+    m_appenders[i](column, binds[i], row);
+  }
+
+  m_rowCount++;
+
+}
+
+v_int64 ColumnarResult::getRowCount() const {
+  return m_rowCount;
+}
+
+v_int64 ColumnarResult::getColumnCount() const {
+  return static_cast<v_int64>(m_columns.size());
+}
+
+const ColumnarResult::Column& ColumnarResult::getColumn(v_int64 index) const {
+  return m_columns.at(static_cast<size_t>(index));
+}
+
+const ColumnarResult::Column* ColumnarResult::findColumn(const oatpp::String& name) const {
+  for (const auto& column : m_columns) {
+    if (column.name == name) {
+      return &column;
+    }
+  }
+  return nullptr;
+}
+
+}}}
@@ -0,0 +1,200 @@
+#ifndef oatpp_mariadb_mapping_ColumnarResult_hpp
+#define oatpp_mariadb_mapping_ColumnarResult_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+#include <vector>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+/**
+ * Rows of a result set decoded column by column into contiguous typed buffers. <br>
+ * Integers are stored as `v_int64`, floating point values as `v_float64`, everything else as strings
+ * (offsets + one data block per column). `NULL` values are marked in a per-column bitmap - their slot in
+ * the value array is `0`. No per-cell allocation - suitable for aggregates and vectorized processing.
+ */
+class ColumnarResult {
+public:
+
+  /**
+   * Storage type of a column.
+   */
+  enum class ColumnType : v_int32 {
+
+    /**
+     * `TINYINT` ... `BIGINT`, `BIT`, `YEAR` - &l:ColumnarResult::Column::int64Values;.
+     * `BIGINT UNSIGNED` values above `INT64_MAX` keep their bit pattern - see &l:ColumnarResult::Column::isUnsigned;.
+     */
+    INT64 = 0,
+
+    /**
+     * `FLOAT`, `DOUBLE` - &l:ColumnarResult::Column::doubleValues;.
+     */
+    DOUBLE = 1,
+
+    /**
+     * Strings, blobs, date/time, decimals, JSON - &l:ColumnarResult::Column::offsets; and &l:ColumnarResult::Column::data;.
+     */
+    STRING = 2
+
+  };
+
+  /**
+   * Values of one column.
+   */
+  struct Column {
+
+    /**
+     * Column name.
+     */
+    oatpp::String name;
+
+    /**
+     * Storage type.
+     */
+    ColumnType type;
+
+    /**
+     * Integer column is unsigned.
+     */
+    bool isUnsigned;
+
+    /**
+     * Values of an &l:ColumnarResult::ColumnType::INT64; column - one per row.
+     */
+    std::vector<v_int64> int64Values;
+
+    /**
+     * Values of a &l:ColumnarResult::ColumnType::DOUBLE; column - one per row.
+     */
+    std::vector<v_float64> doubleValues;
+
+    /**
+     * Start offsets of the values of a &l:ColumnarResult::ColumnType::STRING; column in `data` - `rowCount + 1` entries,
+     * value `i` is `[offsets[i], offsets[i + 1])`.
+     */
+    std::vector<v_uint64> offsets;
+
+    /**
+     * Concatenated values of a &l:ColumnarResult::ColumnType::STRING; column.
+     */
+    std::vector<char> data;
+
+    /**
+     * Null bitmap - bit `i % 64` of word `i / 64` is set if the value of row `i` is `NULL`.
+     */
+    std::vector<v_uint64> nullBitmap;
+
+    /**
+     * Number of `NULL` values.
+     */
+    v_int64 nullCount;
+
+    /**
+     * Check if the value of the row is `NULL`.
+     * @param row - row index.
+     * @return
+     */
+    bool isNull(v_int64 row) const {
+      return (nullBitmap[row >> 6] >> (row & 63)) & 1;
+    }
+
+    /**
+     * Get pointer to the value of a &l:ColumnarResult::ColumnType::STRING; column.
+     * @param row - row index.
+     * @return - pointer into `data`. Not null-terminated.
+     */
+    const char* getStringData(v_int64 row) const {
+      return data.data() + offsets[row];
+    }
+
+    /**
+     * Get size of the value of a &l:ColumnarResult::ColumnType::STRING; column.
+     * @param row - row index.
+     * @return - size in bytes.
+     */
+    v_buff_size getStringSize(v_int64 row) const {
+      return static_cast<v_buff_size>(offsets[row + 1] - offsets[row]);
+    }
+
+    /**
+     * Copy the value of a &l:ColumnarResult::ColumnType::STRING; column to `oatpp::String`.
+     * @param row - row index.
+     * @return - value or `nullptr` if the value is `NULL`.
+     */
+    oatpp::String getString(v_int64 row) const;
+
+  };
+
+private:
+
+  typedef void (*Appender)(Column&, const MYSQL_BIND&, v_int64);
+
+  static void appendInt8(Column& column, const MYSQL_BIND& bind, v_int64 row);
+  static void appendInt16(Column& column, const MYSQL_BIND& bind, v_int64 row);
+  static void appendInt32(Column& column, const MYSQL_BIND& bind, v_int64 row);
+  static void appendInt64(Column& column, const MYSQL_BIND& bind, v_int64 row);
+  static void appendFloat(Column& column, const MYSQL_BIND& bind, v_int64 row);
+  static void appendDouble(Column& column, const MYSQL_BIND& bind, v_int64 row);
+  static void appendString(Column& column, const MYSQL_BIND& bind, v_int64 row);
+
+  static void setNull(Column& column, v_int64 row);
+
+private:
+  std::vector<Column> m_columns;
+  std::vector<Appender> m_appenders;
+  v_int64 m_rowCount;
+public:
+
+  /**
+   * Default constructor. No columns, no rows.
+   */
+  ColumnarResult();
+
+  /**
+   * Set up columns for the bound result buffers.
+   * @param binds - result binds (`ResultMapper::ResultData::bindResults`).
+   * @param names - column names.
+   * @param expectedRows - number of rows to reserve space for.
+   */
+  void init(const std::vector<MYSQL_BIND>& binds, const std::vector<oatpp::String>& names, v_int64 expectedRows);
+
+  /**
+   * Append the row currently held in the bound result buffers.
+   * @param binds - result binds the columnar result was initialized with.
+   */
+  void appendRow(const std::vector<MYSQL_BIND>& binds);
+
+  /**
+   * Get number of rows.
+   * @return
+   */
+  v_int64 getRowCount() const;
+
+  /**
+   * Get number of columns.
+   * @return
+   */
+  v_int64 getColumnCount() const;
+
+  /**
+   * Get column by index.
+   * @param index - column index.
+   * @return - &l:ColumnarResult::Column;.
+   */
+  const Column& getColumn(v_int64 index) const;
+
+  /**
+   * Get column by name.
+   * @param name - column name.
+   * @return - &l:ColumnarResult::Column; or `nullptr` if there is no such column.
+   */
+  const Column* findColumn(const oatpp::String& name) const;
+
+};
+
+}}}
+
+#endif // oatpp_mariadb_mapping_ColumnarResult_hpp
@@ -75,6 +75,14 @@ oatpp::Void Deserializer::deserialize(const InData& data, const Type* type) cons
 
 }
 
+Deserializer::DeserializerMethod Deserializer::getDeserializerMethod(const Type* type) const {
+  auto id = type->classId.id;
+  if(id >= m_methods.size()) {
+    return nullptr;
+  }
+  return m_methods[id];
+}
+
 v_int64 Deserializer::deInt(const InData& data) {
   v_int64 value;
 
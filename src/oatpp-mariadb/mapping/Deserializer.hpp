@@ -46,6 +46,13 @@ public:
 
   oatpp::Void deserialize(const InData& data, const Type* type) const;
 
+  /**
+   * Get deserializer method registered for the class of the type.
+   * @param type - oatpp type.
+   * @return - method or `nullptr` if the type is deserialized through an interpretation.
+   */
+  DeserializerMethod getDeserializerMethod(const Type* type) const;
+
 private:
 
   static oatpp::Void deserializeString(const Deserializer* _this, const InData& data, const Type* type);
@@ -14,6 +14,47 @@ namespace oatpp { namespace mariadb { namespace mapping {
  */
 class JsonHelper {
 public:
+
+  /**
+   * Write a JSON string literal. Quotes, backslashes and control characters are escaped,
+   * other bytes (UTF-8) are written as is.
+   * @param stream - output stream.
+   * @param data - string data.
+   * @param size - string size.
+   */
+  static void writeString(oatpp::data::stream::ConsistentOutputStream* stream, const char* data, v_buff_size size) {
+    static const char* const HEX = "0123456789abcdef";
+    stream->writeCharSimple('"');
+    v_buff_size start = 0;
+    for (v_buff_size i = 0; i < size; i++) {
+      auto c = static_cast<v_char8>(data[i]);
+      if (c != '"' && c != '\\' && c >= 0x20) {
+        continue;
+      }
+      if (i > start) {
+        stream->writeSimple(data + start, i - start);
+      }
+      start = i + 1;
+      switch (c) {
+        case '"': stream->writeSimple("\\\"", 2); break;
+        case '\\': stream->writeSimple("\\\\", 2); break;
+        case '\b': stream->writeSimple("\\b", 2); break;
+        case '\f': stream->writeSimple("\\f", 2); break;
+        case '\n': stream->writeSimple("\\n", 2); break;
+        case '\r': stream->writeSimple("\\r", 2); break;
+        case '\t': stream->writeSimple("\\t", 2); break;
+        default: {
+          char escaped[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 15]};
+          stream->writeSimple(escaped, 6);
+        }
+      }
+    }
+    if (size > start) {
+      stream->writeSimple(data + start, size - start);
+    }
+    stream->writeCharSimple('"');
+  }
+
   static void setupIntegerSerializers(oatpp::parser::json::mapping::ObjectMapper& mapper) {
     auto config = mapper.getSerializer()->getConfig();
     config->enabledInterpretations = {"Int64", "UInt64"};
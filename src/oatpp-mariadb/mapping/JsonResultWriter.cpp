@@ -0,0 +1,82 @@
+#include "JsonResultWriter.hpp"
+#include "JsonHelper.hpp"
+
+#include "oatpp/core/data/stream/BufferStream.hpp"
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+template<typename T>
+void JsonResultWriter::writeNumber(data::stream::ConsistentOutputStream* stream, const MYSQL_BIND& bind) {
+  stream->writeAsString(*static_cast<const T*>(bind.buffer));
+}
+
+void JsonResultWriter::writeString(data::stream::ConsistentOutputStream* stream, const MYSQL_BIND& bind) {
+  JsonHelper::writeString(stream, static_cast<const char*>(bind.buffer), static_cast<v_buff_size>(*bind.length));
+}
+
+JsonResultWriter::JsonResultWriter(const std::vector<MYSQL_BIND>& binds, const std::vector<oatpp::String>& names) {
+
+  m_keys.reserve(binds.size());
+  m_writers.reserve(binds.size());
+
+  for (size_t i = 0; i < binds.size(); i++) {
+
+    const MYSQL_BIND& bind = binds[i];
+
+    data::stream::BufferOutputStream key;
+    if (i > 0) {
+      key.writeCharSimple(',');
+    }
+    const auto& name = i < names.size() ? names[i] : oatpp::String("");
+    JsonHelper::writeString(&key, name->data(), static_cast<v_buff_size>(name->size()));
+    key.writeCharSimple(':');
+    m_keys.push_back(key.toStdString());
+
+    switch (bind.buffer_type) {
+      case MYSQL_TYPE_TINY:
+        m_writers.push_back(bind.is_unsigned ? &JsonResultWriter::writeNumber<v_uint8> : &JsonResultWriter::writeNumber<v_int8>);
+        break;
+      case MYSQL_TYPE_SHORT:
+      case MYSQL_TYPE_YEAR:
+        m_writers.push_back(bind.is_unsigned ? &JsonResultWriter::writeNumber<v_uint16> : &JsonResultWriter::writeNumber<v_int16>);
+        break;
+      case MYSQL_TYPE_LONG:
+      case MYSQL_TYPE_INT24:
+        m_writers.push_back(bind.is_unsigned ? &JsonResultWriter::writeNumber<v_uint32> : &JsonResultWriter::writeNumber<v_int32>);
+        break;
+      case MYSQL_TYPE_LONGLONG:
+        m_writers.push_back(bind.is_unsigned ? &JsonResultWriter::writeNumber<v_uint64> : &JsonResultWriter::writeNumber<v_int64>);
+        break;
+      case MYSQL_TYPE_BIT:
+        m_writers.push_back(&JsonResultWriter::writeNumber<v_uint64>);
+        break;
+      case MYSQL_TYPE_FLOAT:
+        m_writers.push_back(&JsonResultWriter::writeNumber<v_float32>);
+        break;
+      case MYSQL_TYPE_DOUBLE:
+        m_writers.push_back(&JsonResultWriter::writeNumber<v_float64>);
+        break;
+      default:
+        m_writers.push_back(&JsonResultWriter::writeString);
+        break;
+    }
+
+  }
+
+}
+
+void JsonResultWriter::writeRow(data::stream::ConsistentOutputStream* stream, const std::vector<MYSQL_BIND>& binds) const {
+  stream->writeCharSimple('{');
+  for (size_t i = 0; i < m_writers.size(); i++) {
+    stream->writeSimple(m_keys[i].data(), static_cast<v_buff_size>(m_keys[i].size()));
+    const MYSQL_BIND& bind = binds[i];
+    if (*bind.is_null) {
+      stream->writeSimple("null", 4);
+    } else {
+      m_writers[i](stream, bind);
+    }
+  }
+  stream->writeCharSimple('}');
+}
+
+}}}
@@ -0,0 +1,51 @@
+#ifndef oatpp_mariadb_mapping_JsonResultWriter_hpp
+#define oatpp_mariadb_mapping_JsonResultWriter_hpp
+
+#include "oatpp/core/data/stream/Stream.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+#include <string>
+#include <vector>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+/**
+ * Writes rows of a result set as JSON objects straight from the bound `MYSQL_BIND` buffers. <br>
+ * Keys are the column names, `NULL` is written as `null` (like `includeNullFields` of
+ * &id:oatpp::mariadb::mapping::JsonHelper;). Integers - including `BIGINT` and `BIGINT UNSIGNED` - are written as
+ * JSON numbers like the `Int64`/`UInt64` serializers of &id:oatpp::mariadb::mapping::JsonHelper;, `FLOAT`/`DOUBLE`
+ * as numbers, everything else (strings, date/time, decimals, JSON, blobs) as JSON strings.
+ */
+class JsonResultWriter {
+private:
+  typedef void (*ValueWriter)(data::stream::ConsistentOutputStream*, const MYSQL_BIND&);
+private:
+  template<typename T>
+  static void writeNumber(data::stream::ConsistentOutputStream* stream, const MYSQL_BIND& bind);
+  static void writeString(data::stream::ConsistentOutputStream* stream, const MYSQL_BIND& bind);
+private:
+  std::vector<std::string> m_keys;
+  std::vector<ValueWriter> m_writers;
+public:
+
+  /**
+   * Constructor. Resolves a value writer for each column and pre-renders the `"name":` keys.
+   * @param binds - result binds (`ResultMapper::ResultData::bindResults`).
+   * @param names - column names.
+   */
+  JsonResultWriter(const std::vector<MYSQL_BIND>& binds, const std::vector<oatpp::String>& names);
+
+  /**
+   * Write the row currently held in the bound result buffers as a JSON object.
+   * @param stream - output stream.
+   * @param binds - result binds the writer was created for.
+   */
+  void writeRow(data::stream::ConsistentOutputStream* stream, const std::vector<MYSQL_BIND>& binds) const;
+
+};
+
+}}}
+
+#endif // oatpp_mariadb_mapping_JsonResultWriter_hpp
@@ -1,5 +1,7 @@
 #include "ResultMapper.hpp"
 
+#include <algorithm>
+
 namespace oatpp { namespace mariadb { namespace mapping {
 
 ResultMapper::ResultData::ResultData(MYSQL_STMT* pStmt, const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver)
@@ -14,6 +16,10 @@ ResultMapper::ResultData::ResultData(MYSQL_STMT* pStmt, const std::shared_ptr<co
   , bindLengths()
   , bindBuffers()
   , metaResults(nullptr)
+  , resultStored(false)
+  , useCursor(false)
+  , unbuffered(false)
+  , snapshotPosition(0)
 {
   if (!stmt) {
     OATPP_LOGE("ResultMapper", "Error: stmt is null in constructor");
@@ -27,6 +33,34 @@ ResultMapper::ResultData::ResultData(MYSQL_STMT* pStmt, const std::shared_ptr<co
   }
 }
 
+ResultMapper::ResultData::ResultData(const std::shared_ptr<const ResultSnapshot>& pSnapshot,
+                                     const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver)
+  : stmt(nullptr)
+  , typeResolver(pTypeResolver)
+  , colNames(pSnapshot->getNames())
+  , colCount(static_cast<v_int64>(pSnapshot->getColumns().size()))
+  , rowIndex(0)
+  , hasMore(false)
+  , isSuccess(true)
+  , bindResults(pSnapshot->getColumns())
+  , bindIsNull(pSnapshot->getColumns().size())
+  , bindLengths(pSnapshot->getColumns().size())
+  , bindBuffers(pSnapshot->getColumns().size())
+  , metaResults(nullptr)
+  , resultStored(true)
+  , useCursor(false)
+  , unbuffered(false)
+  , snapshot(pSnapshot)
+  , snapshotPosition(0)
+{
+  for (v_int64 i = 0; i < colCount; i++) {
+    colIndices[data::share::StringKeyLabel(colNames[i])] = static_cast<v_int32>(i);
+    bindResults[i].is_null = &bindIsNull[i];
+    bindResults[i].length = &bindLengths[i];
+  }
+  hasMore = fetchRow() == 0;
+}
+
 ResultMapper::ResultData::~ResultData() {
   // Clear the vectors to ensure no dangling pointers
   bindResults.clear();
@@ -55,7 +89,7 @@ void ResultMapper::ResultData::init() {
     OATPP_LOGD("ResultMapper", "No metadata in init() (normal for non-SELECT queries)");
     
     // For INSERT...RETURNING queries, we still need to fetch the result
-    int result = mysql_stmt_store_result(stmt);
+    int result = resultStored ? 0 : mysql_stmt_store_result(stmt);
     if (result != 0) {
       OATPP_LOGE("ResultMapper", "Failed to store result: %s", mysql_stmt_error(stmt));
       isSuccess = false;
@@ -135,13 +169,7 @@ void ResultMapper::ResultData::init() {
           case MYSQL_TYPE_TINY_BLOB:
           case MYSQL_TYPE_MEDIUM_BLOB:
           case MYSQL_TYPE_LONG_BLOB:
-            if (fields[i].flags & BINARY_FLAG) {
-              // For BINARY columns, allocate exact size without null terminator
-              bufferSize = fields[i].length;
-            } else {
-              // For text columns, add null terminator
-              bufferSize = fields[i].length + 1;
-            }
+            bufferSize = getInitialBufferSize(fields[i].length, fields[i].flags & BINARY_FLAG);
             bind.buffer_type = MYSQL_TYPE_STRING;
             break;
           case MYSQL_TYPE_DATE:
@@ -165,11 +193,11 @@ void ResultMapper::ResultData::init() {
           case MYSQL_TYPE_SET:
           case MYSQL_TYPE_JSON:
             bind.buffer_type = MYSQL_TYPE_STRING;
-            bufferSize = fields[i].length + 1;  // Add 1 for null terminator
+            bufferSize = getInitialBufferSize(fields[i].length, false);
             break;
           default:
             bind.buffer_type = MYSQL_TYPE_STRING;
-            bufferSize = fields[i].length + 1;
+            bufferSize = getInitialBufferSize(fields[i].length, false);
             break;
         }
 
@@ -198,7 +226,7 @@ void ResultMapper::ResultData::init() {
       }
 
       // Fetch first row after binding
-      int fetchResult = mysql_stmt_fetch(stmt);
+      int fetchResult = fetchRow();
       if (fetchResult == 0) {
         hasMore = true;
         isSuccess = true;
@@ -242,23 +270,31 @@ void ResultMapper::ResultData::init() {
     OATPP_LOGD("ResultMapper", "Initialized column %d: %s", i, colName->c_str());
   }
 
-  // Store the result set
-  int result = mysql_stmt_store_result(stmt);
-  if (result != 0) {
-    OATPP_LOGE("ResultMapper", "Failed to store result: %s", mysql_stmt_error(stmt));
-    isSuccess = false;
-    hasMore = false;
-    return;
-  }
+  int result = 0;
+  if (useCursor || unbuffered) {
+    // Row count is unknown until the rows are read - the first fetch tells if there are any
+    hasMore = true;
+  } else {
 
-  // Check if we have any rows
-  my_ulonglong rows = mysql_stmt_num_rows(stmt);
-  hasMore = (rows > 0);
-  OATPP_LOGD("ResultMapper", "Found %llu rows in result", rows);
+    // Store the result set
+    result = resultStored ? 0 : mysql_stmt_store_result(stmt);
+    if (result != 0) {
+      OATPP_LOGE("ResultMapper", "Failed to store result: %s", mysql_stmt_error(stmt));
+      isSuccess = false;
+      hasMore = false;
+      return;
+    }
+
+    // Check if we have any rows
+    my_ulonglong rows = mysql_stmt_num_rows(stmt);
+    hasMore = (rows > 0);
+    OATPP_LOGD("ResultMapper", "Found %llu rows in result", rows);
+
+  }
 
   if (hasMore) {
     // Fetch first row
-    result = mysql_stmt_fetch(stmt);
+    result = fetchRow();
     if (result == 0) {
       hasMore = true;
       isSuccess = true;  // Set success flag when first row is fetched successfully
@@ -276,13 +312,13 @@ void ResultMapper::ResultData::init() {
 }
 
 void ResultMapper::ResultData::next() {
-  if (!stmt || !hasMore) {
+  if ((!stmt && !snapshot) || !hasMore) {
     OATPP_LOGD("ResultMapper", "No more rows to fetch");
     hasMore = false;
     return;
   }
 
-  auto res = mysql_stmt_fetch(stmt);
+  auto res = fetchRow();
   if (res == 0) {
     rowIndex++;
     hasMore = true;
@@ -296,6 +332,75 @@ void ResultMapper::ResultData::next() {
   }
 }
 
+unsigned long ResultMapper::ResultData::getInitialBufferSize(unsigned long columnLength, bool isBinary) {
+  // Binary values are read by length - text values get room for the null terminator
+  unsigned long size = std::min(columnLength, INITIAL_BUFFER_SIZE);
+  return isBinary ? std::max(size, 1UL) : size + 1;
+}
+
+int ResultMapper::ResultData::fetchRow() {
+
+  if (snapshot) {
+    if (snapshotPosition >= snapshot->getRowCount()) {
+      return MYSQL_NO_DATA;
+    }
+    snapshot->loadRow(snapshotPosition++, bindResults, bindBuffers);
+    return 0;
+  }
+
+  int res = fetchStatementRow();
+  if (res == 0 && recorder && !recorder->appendRow(bindResults)) {
+    OATPP_LOGD("ResultMapper", "Result is too large to be recorded. Recording dropped.");
+    recorder.reset();
+  }
+  return res;
+
+}
+
+int ResultMapper::ResultData::fetchStatementRow() {
+
+  int res = mysql_stmt_fetch(stmt);
+  if (res != MYSQL_DATA_TRUNCATED) {
+    return res;
+  }
+
+  bool rebind = false;
+  for (v_int64 i = 0; i < colCount; i++) {
+
+    MYSQL_BIND& bind = bindResults[i];
+    if (bindIsNull[i] || bind.buffer_type != MYSQL_TYPE_STRING || bindLengths[i] <= bind.buffer_length) {
+      continue;
+    }
+
+    // Room for the null terminator of text values
+    unsigned long bufferSize = bindLengths[i] + 1;
+    bindBuffers[i].resize(bufferSize);
+    bind.buffer = bindBuffers[i].data();
+    bind.buffer_length = bufferSize;
+
+    if (mysql_stmt_fetch_column(stmt, &bind, (unsigned int) i, 0) != 0) {
+      OATPP_LOGE("ResultMapper", "Error fetching column %d: %s", (int) i, mysql_stmt_error(stmt));
+      return 1;
+    }
+    rebind = true;
+
+  }
+
+  if (!rebind) {
+    // Truncated fixed-size value - not recoverable by a bigger buffer
+    return res;
+  }
+
+  // The statement keeps its own copy of the binds - point it at the grown buffers
+  if (mysql_stmt_bind_result(stmt, bindResults.data()) != 0) {
+    OATPP_LOGE("ResultMapper", "Failed to bind result: %s", mysql_stmt_error(stmt));
+    return 1;
+  }
+
+  return 0;
+
+}
+
 void ResultMapper::ResultData::bindResultsForCache() {
   if (!stmt) {
     throw std::runtime_error("Statement is null");
@@ -394,20 +499,15 @@ void ResultMapper::ResultData::bindResultsForCache() {
       case MYSQL_TYPE_TINY_BLOB:
       case MYSQL_TYPE_MEDIUM_BLOB:
       case MYSQL_TYPE_LONG_BLOB:
-        if (fieldInfo->isBinary) {
-          // For BINARY columns, allocate exact size without null terminator
-          bindBuffers[i].resize(fieldInfo->columnLength);
-          bind.buffer_type = MYSQL_TYPE_STRING;
-          bind.buffer = bindBuffers[i].data();
-          bind.buffer_length = fieldInfo->columnLength;
-        } else {
-          // For text columns, add null terminator
-          bindBuffers[i].resize(fieldInfo->columnLength + 1);
-          bind.buffer_type = MYSQL_TYPE_STRING;
-          bind.buffer = bindBuffers[i].data();
-          bind.buffer_length = fieldInfo->columnLength + 1;
-        }
+      {
+        // Longer values are read on MYSQL_DATA_TRUNCATED - see fetchRow()
+        unsigned long bufferSize = getInitialBufferSize(fieldInfo->columnLength, fieldInfo->isBinary);
+        bindBuffers[i].resize(bufferSize);
+        bind.buffer_type = MYSQL_TYPE_STRING;
+        bind.buffer = bindBuffers[i].data();
+        bind.buffer_length = bufferSize;
         break;
+      }
         
       case MYSQL_TYPE_DATE:
         bindBuffers[i].resize(11);  // YYYY-MM-DD + null terminator
@@ -441,12 +541,14 @@ void ResultMapper::ResultData::bindResultsForCache() {
         
       case MYSQL_TYPE_ENUM:
       case MYSQL_TYPE_SET:
-      case MYSQL_TYPE_JSON:
-        bindBuffers[i].resize(fieldInfo->columnLength + 1);  // Add 1 for null terminator
+      case MYSQL_TYPE_JSON: {
+        unsigned long bufferSize = getInitialBufferSize(fieldInfo->columnLength, false);
+        bindBuffers[i].resize(bufferSize);
         bind.buffer_type = MYSQL_TYPE_STRING;
         bind.buffer = bindBuffers[i].data();
-        bind.buffer_length = fieldInfo->columnLength + 1;
+        bind.buffer_length = bufferSize;
         break;
+      }
         
       default:
         throw std::runtime_error("Buffer type is not supported");
@@ -669,7 +771,7 @@ oatpp::Void ResultMapper::readOneRowAsCollection(ResultMapper* _this, ResultData
   }
 
   // Move to next row
-  int fetchResult = mysql_stmt_fetch(dbData->stmt);
+  int fetchResult = dbData->fetchRow();
   if (fetchResult == 0) {
     dbData->hasMore = true;
   } else if (fetchResult == MYSQL_NO_DATA) {
@@ -703,7 +805,7 @@ oatpp::Void ResultMapper::readOneRowAsMap(ResultMapper* _this, ResultData* dbDat
   }
 
   // Move to next row
-  int fetchResult = mysql_stmt_fetch(dbData->stmt);
+  int fetchResult = dbData->fetchRow();
   if (fetchResult == 0) {
     dbData->hasMore = true;
   } else if (fetchResult == MYSQL_NO_DATA) {
@@ -717,221 +819,268 @@ oatpp::Void ResultMapper::readOneRowAsMap(ResultMapper* _this, ResultData* dbDat
   return map;
 }
 
-oatpp::Void ResultMapper::readOneRowAsObject(ResultMapper* _this, ResultData* dbData, const Type* type) {
-  if (!dbData->hasMore) {
-    return oatpp::Void(nullptr);
+void ResultMapper::readBoolean(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object) {
+  (void) _this;
+  auto& bind = dbData->bindResults[column.index];
+  if (*bind.is_null) {
+    column.property->set(object, nullptr);
+  } else {
+    column.property->set(object, oatpp::Boolean(*static_cast<signed char*>(bind.buffer) != 0));
+  }
+}
+
+template<typename T>
+void ResultMapper::readInt32(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object) {
+  (void) _this;
+  auto& bind = dbData->bindResults[column.index];
+  column.property->set(object, oatpp::Int32(static_cast<v_int32>(*static_cast<T*>(bind.buffer))));
+}
+
+template<typename T, class Wrapper>
+void ResultMapper::readInt64(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object) {
+  (void) _this;
+  auto& bind = dbData->bindResults[column.index];
+  if (*bind.is_null) {
+    column.property->set(object, nullptr);
+  } else {
+    column.property->set(object, Wrapper(static_cast<typename Wrapper::ObjectType>(*static_cast<T*>(bind.buffer))));
+  }
+}
+
+void ResultMapper::readWithMethod(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object) {
+  mapping::Deserializer::InData inData(&dbData->bindResults[column.index], dbData->typeResolver);
+  column.property->set(object, column.method(&_this->m_deserializer, inData, column.property->type));
+}
+
+void ResultMapper::readWithInterpretation(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object) {
+  mapping::Deserializer::InData inData(&dbData->bindResults[column.index], dbData->typeResolver);
+  column.property->set(object, _this->m_deserializer.deserialize(inData, column.property->type));
+}
+
+template<typename T, class Wrapper>
+void ResultMapper::decodeNumber(const MYSQL_BIND& bind, oatpp::Void& field) {
+  // The field is declared as Wrapper - the property only sees it as oatpp::Void
+  auto& value = reinterpret_cast<Wrapper&>(field);
+  if (*bind.is_null) {
+    value = nullptr;
+  } else {
+    value = static_cast<typename Wrapper::ObjectType>(*static_cast<const T*>(bind.buffer));
   }
+}
+
+void ResultMapper::decodeString(const MYSQL_BIND& bind, oatpp::Void& field) {
+  auto& value = reinterpret_cast<oatpp::String&>(field);
+  if (*bind.is_null) {
+    value = nullptr;
+  } else {
+    value = oatpp::String(static_cast<const char*>(bind.buffer), static_cast<v_buff_size>(*bind.length));
+  }
+}
+
+template<class Wrapper>
+ResultMapper::MappingPlan::FieldDecoder ResultMapper::resolveNumberDecoder(const MYSQL_BIND& bind) {
+  switch (bind.buffer_type) {
+    case MYSQL_TYPE_TINY:
+      return bind.is_unsigned ? &ResultMapper::decodeNumber<uint8_t, Wrapper> : &ResultMapper::decodeNumber<int8_t, Wrapper>;
+    case MYSQL_TYPE_SHORT:
+      return bind.is_unsigned ? &ResultMapper::decodeNumber<uint16_t, Wrapper> : &ResultMapper::decodeNumber<int16_t, Wrapper>;
+    case MYSQL_TYPE_LONG:
+      return bind.is_unsigned ? &ResultMapper::decodeNumber<uint32_t, Wrapper> : &ResultMapper::decodeNumber<int32_t, Wrapper>;
+    case MYSQL_TYPE_LONGLONG:
+      return bind.is_unsigned ? &ResultMapper::decodeNumber<uint64_t, Wrapper> : &ResultMapper::decodeNumber<int64_t, Wrapper>;
+    case MYSQL_TYPE_BIT:
+      return &ResultMapper::decodeNumber<uint64_t, Wrapper>;
+    case MYSQL_TYPE_FLOAT:
+      return &ResultMapper::decodeNumber<float, Wrapper>;
+    case MYSQL_TYPE_DOUBLE:
+      return &ResultMapper::decodeNumber<double, Wrapper>;
+    default:
+      return nullptr;
+  }
+}
+
+ResultMapper::MappingPlan::FieldDecoder ResultMapper::resolveFieldDecoder(const MYSQL_BIND& bind, const Type* type) {
+
+  const auto id = type->classId.id;
+
+  if (id == data::mapping::type::__class::String::CLASS_ID.id) {
+    return bind.buffer_type == MYSQL_TYPE_STRING ? &ResultMapper::decodeString : nullptr;
+  }
+
+  // Floating point columns only go to floating point properties - integers are read the way the Deserializer reads them
+  const bool isFloatBuffer = bind.buffer_type == MYSQL_TYPE_FLOAT || bind.buffer_type == MYSQL_TYPE_DOUBLE;
+
+  if (id == data::mapping::type::__class::Float64::CLASS_ID.id) return resolveNumberDecoder<oatpp::Float64>(bind);
+  if (id == data::mapping::type::__class::Float32::CLASS_ID.id) return resolveNumberDecoder<oatpp::Float32>(bind);
+  if (isFloatBuffer) return nullptr;
+
+  if (id == data::mapping::type::__class::Int8::CLASS_ID.id) return resolveNumberDecoder<oatpp::Int8>(bind);
+  if (id == data::mapping::type::__class::UInt8::CLASS_ID.id) return resolveNumberDecoder<oatpp::UInt8>(bind);
+  if (id == data::mapping::type::__class::Int16::CLASS_ID.id) return resolveNumberDecoder<oatpp::Int16>(bind);
+  if (id == data::mapping::type::__class::UInt16::CLASS_ID.id) return resolveNumberDecoder<oatpp::UInt16>(bind);
+  if (id == data::mapping::type::__class::Int32::CLASS_ID.id) return resolveNumberDecoder<oatpp::Int32>(bind);
+  if (id == data::mapping::type::__class::UInt32::CLASS_ID.id) return resolveNumberDecoder<oatpp::UInt32>(bind);
+  if (id == data::mapping::type::__class::Int64::CLASS_ID.id) return resolveNumberDecoder<oatpp::Int64>(bind);
+  if (id == data::mapping::type::__class::UInt64::CLASS_ID.id) return resolveNumberDecoder<oatpp::UInt64>(bind);
+  if (id == data::mapping::type::__class::Boolean::CLASS_ID.id) return resolveNumberDecoder<oatpp::Boolean>(bind);
+
+  return nullptr;
+
+}
+
+std::shared_ptr<const ResultMapper::MappingPlan> ResultMapper::createMappingPlan(ResultData* dbData, const Type* type) const {
 
   auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
-  auto object = dispatcher->createObject();
   const auto& fieldsMap = dispatcher->getProperties()->getMap();
 
-  // Initialize all Int32 fields to 0 to prevent null pointer issues
-  for (const auto& pair : fieldsMap) {
-    auto property = pair.second;
-    if (property && property->type->classId.id == oatpp::data::mapping::type::__class::Int32::CLASS_ID.id) {
-      property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Int32(0));
-    }
-  }
+  auto plan = std::make_shared<MappingPlan>();
+  plan->type = type;
 
-  // Special case: If there's only one column and it's a RETURNING clause result,
-  // try to map it to the matching property type
-  if (dbData->colCount == 1) {
-    auto& bind = dbData->bindResults[0];
-    
-    if (!*bind.is_null) {
-      oatpp::String fieldName = dbData->colNames[0];
-      OATPP_LOGD("ResultMapper", "Column name: %s", fieldName->c_str());
-      
-      auto it = fieldsMap.find(*fieldName);
-      
-      // For RETURNING clauses, try to match with 'id' property if exact match not found
-      if (it == fieldsMap.end()) {
-        OATPP_LOGD("ResultMapper", "Column name not found, trying 'id'");
-        it = fieldsMap.find("id");  // Common case for RETURNING id
-      }
+  // A single column (typically a RETURNING clause) is read leniently: NULL leaves the property as is,
+  // Int32 properties take any integer buffer
+  const bool singleColumn = dbData->colCount == 1;
 
-      if (it != fieldsMap.end()) {
-        auto property = it->second;
-        OATPP_LOGD("ResultMapper", "Found property: %s", it->first.c_str());
-        
-        if (property) {
-          if (property->type == oatpp::data::mapping::type::__class::Boolean::getType()) {
-            if (bind.buffer_type == MYSQL_TYPE_TINY) {
-              if (*bind.is_null) {
-                OATPP_LOGD("ResultMapper", "Setting null boolean value for property %s", fieldName->c_str());
-                property->set(static_cast<oatpp::BaseObject*>(object.get()), nullptr);
-              } else {
-                signed char value = *static_cast<signed char*>(bind.buffer);
-                OATPP_LOGD("ResultMapper", "Setting boolean value %d for property %s", (int)value, fieldName->c_str());
-                property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Boolean(value != 0));
-              }
-            } else {
-              mapping::Deserializer::InData inData(&bind, dbData->typeResolver);
-              property->set(static_cast<oatpp::BaseObject*>(object.get()), _this->m_deserializer.deserialize(inData, property->type));
-            }
-          } else if (property->type->classId.id == oatpp::data::mapping::type::__class::Int32::CLASS_ID.id) {
-            int value = 0;
-            bool handled = false;
-
-            switch (bind.buffer_type) {
-              case MYSQL_TYPE_TINY:
-                value = *static_cast<signed char*>(bind.buffer);
-                handled = true;
-                break;
-              case MYSQL_TYPE_SHORT:
-              case MYSQL_TYPE_YEAR:
-                value = *static_cast<short*>(bind.buffer);
-                handled = true;
-                break;
-              case MYSQL_TYPE_LONG:
-              case MYSQL_TYPE_INT24:
-                value = *static_cast<int*>(bind.buffer);
-                handled = true;
-                break;
-              case MYSQL_TYPE_LONGLONG:
-                value = static_cast<int>(*static_cast<long long*>(bind.buffer));
-                handled = true;
-                break;
-              default:
-                OATPP_LOGD("ResultMapper", "Unhandled buffer type: %d", bind.buffer_type);
-                handled = false;
-                break;
-            }
-
-            if (handled) {
-              OATPP_LOGD("ResultMapper", "Mapping single column value %d to Int32 property %s", value, fieldName->c_str());
-              property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Int32(value));
-            }
-          } else if (property->type == oatpp::data::mapping::type::__class::Int64::getType() ||
-                     property->type == oatpp::data::mapping::type::__class::UInt64::getType()) {
-            if (bind.buffer_type == MYSQL_TYPE_LONGLONG || bind.buffer_type == MYSQL_TYPE_BIT) {
-              if (*bind.is_null) {
-                OATPP_LOGD("ResultMapper", "Setting null int64 value for property %s", fieldName->c_str());
-                property->set(static_cast<oatpp::BaseObject*>(object.get()), nullptr);
-              } else if (bind.is_unsigned || bind.buffer_type == MYSQL_TYPE_BIT) {
-                uint64_t value = *static_cast<uint64_t*>(bind.buffer);
-                OATPP_LOGD("ResultMapper", "Setting unsigned int64/bit value %llu for property %s", value, fieldName->c_str());
-                if (property->type == oatpp::data::mapping::type::__class::UInt64::getType()) {
-                  property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::UInt64(value));
-                } else {
-                  property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Int64(static_cast<int64_t>(value)));
-                }
-              } else {
-                int64_t value = *static_cast<int64_t*>(bind.buffer);
-                OATPP_LOGD("ResultMapper", "Setting signed int64 value %lld for property %s", value, fieldName->c_str());
-                if (property->type == oatpp::data::mapping::type::__class::UInt64::getType()) {
-                  property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::UInt64(static_cast<uint64_t>(value)));
-                } else {
-                  property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Int64(value));
-                }
-              }
-            } else {
-              mapping::Deserializer::InData inData(&bind, dbData->typeResolver);
-              property->set(static_cast<oatpp::BaseObject*>(object.get()), _this->m_deserializer.deserialize(inData, property->type));
-            }
-          } else if (property->type == oatpp::data::mapping::type::__class::Boolean::getType()) {
-            if (bind.buffer_type == MYSQL_TYPE_TINY) {
-              if (*bind.is_null) {
-                OATPP_LOGD("ResultMapper", "Setting null boolean value for property %s", fieldName->c_str());
-                property->set(static_cast<oatpp::BaseObject*>(object.get()), nullptr);
-              } else {
-                signed char value = *static_cast<signed char*>(bind.buffer);
-                OATPP_LOGD("ResultMapper", "Setting boolean value %d for property %s", (int)value, fieldName->c_str());
-                property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Boolean(value != 0));
-              }
-            } else {
-              mapping::Deserializer::InData inData(&bind, dbData->typeResolver);
-              property->set(static_cast<oatpp::BaseObject*>(object.get()), _this->m_deserializer.deserialize(inData, property->type));
-            }
-          } else {
-            mapping::Deserializer::InData inData(&bind, dbData->typeResolver);
-            property->set(static_cast<oatpp::BaseObject*>(object.get()), _this->m_deserializer.deserialize(inData, property->type));
-          }
-        } else {
-          OATPP_LOGD("ResultMapper", "Property is null");
-        }
+  for (v_int64 i = 0; i < dbData->colCount; i++) {
+
+    const auto& bind = dbData->bindResults[i];
+    const oatpp::String& fieldName = dbData->colNames[i];
+
+    auto it = fieldsMap.find(*fieldName);
+    // For RETURNING clauses, try to match with 'id' property if exact match not found
+    if (it == fieldsMap.end()) {
+      OATPP_LOGD("ResultMapper", "Column '%s' not found, trying 'id'", fieldName->c_str());
+      it = fieldsMap.find("id");  // Common case for RETURNING id
+    }
+    if (it == fieldsMap.end() || !it->second) {
+      OATPP_LOGD("ResultMapper", "No matching property found for column '%s'", fieldName->c_str());
+      continue;
+    }
+
+    MappingPlan::Column column;
+    column.index = i;
+    column.property = it->second;
+    column.reader = nullptr;
+    column.method = nullptr;
+    column.decoder = nullptr;
+    column.skipNull = singleColumn;
+
+    const Type* propertyType = column.property->type;
+    const bool isUInt64 = propertyType == oatpp::data::mapping::type::__class::UInt64::getType();
+
+    if (propertyType == oatpp::data::mapping::type::__class::Boolean::getType() && bind.buffer_type == MYSQL_TYPE_TINY) {
+      column.reader = &ResultMapper::readBoolean;
+    } else if ((propertyType == oatpp::data::mapping::type::__class::Int64::getType() || isUInt64) &&
+               (bind.buffer_type == MYSQL_TYPE_LONGLONG || bind.buffer_type == MYSQL_TYPE_BIT)) {
+      if (bind.is_unsigned || bind.buffer_type == MYSQL_TYPE_BIT) {
+        column.reader = isUInt64 ? &ResultMapper::readInt64<uint64_t, oatpp::UInt64> : &ResultMapper::readInt64<uint64_t, oatpp::Int64>;
       } else {
-        OATPP_LOGD("ResultMapper", "No matching property found");
+        column.reader = isUInt64 ? &ResultMapper::readInt64<int64_t, oatpp::UInt64> : &ResultMapper::readInt64<int64_t, oatpp::Int64>;
+      }
+    } else if (singleColumn && propertyType->classId.id == oatpp::data::mapping::type::__class::Int32::CLASS_ID.id) {
+      switch (bind.buffer_type) {
+        case MYSQL_TYPE_TINY: column.reader = &ResultMapper::readInt32<signed char>; break;
+        case MYSQL_TYPE_SHORT: column.reader = &ResultMapper::readInt32<short>; break;
+        case MYSQL_TYPE_LONG: column.reader = &ResultMapper::readInt32<int>; break;
+        case MYSQL_TYPE_LONGLONG: column.reader = &ResultMapper::readInt32<long long>; break;
+        default:
+          OATPP_LOGD("ResultMapper", "Unhandled buffer type: %d", bind.buffer_type);
+          continue;
       }
     } else {
-      OATPP_LOGD("ResultMapper", "Column value is null");
+      column.method = m_deserializer.getDeserializerMethod(propertyType);
+      column.reader = column.method ? &ResultMapper::readWithMethod : &ResultMapper::readWithInterpretation;
     }
-  } else {
-    // Normal case: Map all columns to properties by name
-    for (unsigned int i = 0; i < dbData->colCount; i++) {
-      auto& bind = dbData->bindResults[i];
-      
-      oatpp::String fieldName = dbData->colNames[i];
-      auto it = fieldsMap.find(*fieldName);
-      
-      // For RETURNING clauses, try to match with 'id' property if exact match not found
-      if (it == fieldsMap.end()) {
-        OATPP_LOGD("ResultMapper", "Column name not found, trying 'id'");
-        it = fieldsMap.find("id");  // Common case for RETURNING id
-      }
 
-      if (it != fieldsMap.end()) {
-        auto property = it->second;
-        OATPP_LOGD("ResultMapper", "Found property: %s", it->first.c_str());
-        
-        if (property) {
-          if (property->type == oatpp::data::mapping::type::__class::Boolean::getType()) {
-            if (bind.buffer_type == MYSQL_TYPE_TINY) {
-              if (*bind.is_null) {
-                OATPP_LOGD("ResultMapper", "Setting null boolean value for property %s", fieldName->c_str());
-                property->set(static_cast<oatpp::BaseObject*>(object.get()), nullptr);
-              } else {
-                signed char value = *static_cast<signed char*>(bind.buffer);
-                OATPP_LOGD("ResultMapper", "Setting boolean value %d for property %s", (int)value, fieldName->c_str());
-                property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Boolean(value != 0));
-              }
-            } else {
-              mapping::Deserializer::InData inData(&bind, dbData->typeResolver);
-              property->set(static_cast<oatpp::BaseObject*>(object.get()), _this->m_deserializer.deserialize(inData, property->type));
-            }
-          } else if (property->type == oatpp::data::mapping::type::__class::Int64::getType() ||
-                     property->type == oatpp::data::mapping::type::__class::UInt64::getType()) {
-            if (bind.buffer_type == MYSQL_TYPE_LONGLONG || bind.buffer_type == MYSQL_TYPE_BIT) {
-              if (*bind.is_null) {
-                OATPP_LOGD("ResultMapper", "Setting null int64 value for property %s", fieldName->c_str());
-                property->set(static_cast<oatpp::BaseObject*>(object.get()), nullptr);
-              } else if (bind.is_unsigned || bind.buffer_type == MYSQL_TYPE_BIT) {
-                uint64_t value = *static_cast<uint64_t*>(bind.buffer);
-                OATPP_LOGD("ResultMapper", "Setting unsigned int64/bit value %llu for property %s", value, fieldName->c_str());
-                if (property->type == oatpp::data::mapping::type::__class::UInt64::getType()) {
-                  property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::UInt64(value));
-                } else {
-                  property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Int64(static_cast<int64_t>(value)));
-                }
-              } else {
-                int64_t value = *static_cast<int64_t*>(bind.buffer);
-                OATPP_LOGD("ResultMapper", "Setting signed int64 value %lld for property %s", value, fieldName->c_str());
-                if (property->type == oatpp::data::mapping::type::__class::UInt64::getType()) {
-                  property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::UInt64(static_cast<uint64_t>(value)));
-                } else {
-                  property->set(static_cast<oatpp::BaseObject*>(object.get()), oatpp::Int64(value));
-                }
-              }
-            } else {
-              mapping::Deserializer::InData inData(&bind, dbData->typeResolver);
-              property->set(static_cast<oatpp::BaseObject*>(object.get()), _this->m_deserializer.deserialize(inData, property->type));
-            }
-          } else {
-            mapping::Deserializer::InData inData(&bind, dbData->typeResolver);
-            property->set(static_cast<oatpp::BaseObject*>(object.get()), _this->m_deserializer.deserialize(inData, property->type));
-          }
-        } else {
-          OATPP_LOGD("ResultMapper", "Property is null");
-        }
-      } else {
-        OATPP_LOGD("ResultMapper", "No matching property found");
+    column.decoder = resolveFieldDecoder(bind, propertyType);
+    plan->columns.push_back(column);
+
+  }
+
+  // Int32 properties default to 0 unless every row sets them
+  for (const auto& pair : fieldsMap) {
+    auto property = pair.second;
+    if (!property || property->type->classId.id != oatpp::data::mapping::type::__class::Int32::CLASS_ID.id) {
+      continue;
+    }
+    bool alwaysSet = false;
+    for (const auto& column : plan->columns) {
+      if (column.property == property && !column.skipNull) {
+        alwaysSet = true;
+        break;
       }
     }
+    if (!alwaysSet) {
+      plan->defaults.push_back(property);
+    }
+  }
+
+  return plan;
+
+}
+
+std::shared_ptr<const ResultMapper::MappingPlan> ResultMapper::getMappingPlan(ResultData* dbData, const Type* type) {
+
+  if (dbData->mappingPlan && dbData->mappingPlan->type == type) {
+    return dbData->mappingPlan;
+  }
+
+  // Key: DTO type + name, buffer type and sign of every column
+  std::string key(reinterpret_cast<const char*>(&type), sizeof(type));
+  for (v_int64 i = 0; i < dbData->colCount; i++) {
+    const auto& bind = dbData->bindResults[i];
+    key.push_back(static_cast<char>(bind.buffer_type));
+    key.push_back(bind.is_unsigned ? 'u' : 's');
+    key.append(dbData->colNames[i]->data(), dbData->colNames[i]->size() + 1);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_plansMutex);
+    auto it = m_plans.find(key);
+    if (it != m_plans.end()) {
+      dbData->mappingPlan = it->second;
+      return dbData->mappingPlan;
+    }
+  }
+
+  auto plan = createMappingPlan(dbData, type);
+
+  {
+    std::lock_guard<std::mutex> lock(m_plansMutex);
+    if (m_plans.size() >= MAX_MAPPING_PLANS) {
+      m_plans.clear();
+    }
+    m_plans[key] = plan;
+  }
+
+  dbData->mappingPlan = plan;
+  return plan;
+
+}
+
+oatpp::Void ResultMapper::readOneRowAsObject(ResultMapper* _this, ResultData* dbData, const Type* type) {
+  if (!dbData->hasMore) {
+    return oatpp::Void(nullptr);
+  }
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto object = dispatcher->createObject();
+  auto base = static_cast<oatpp::BaseObject*>(object.get());
+
+  auto plan = _this->getMappingPlan(dbData, type);
+
+  for (auto property : plan->defaults) {
+    property->set(base, oatpp::Int32(0));
+  }
+
+  for (const auto& column : plan->columns) {
+    if (column.skipNull && *dbData->bindResults[column.index].is_null) {
+      continue;
+    }
+    column.reader(_this, dbData, column, base);
   }
 
   // Move to next row
-  int fetchResult = mysql_stmt_fetch(dbData->stmt);
+  int fetchResult = dbData->fetchRow();
   if (fetchResult == 0) {
     dbData->hasMore = true;
   } else if (fetchResult == MYSQL_NO_DATA) {
@@ -1031,4 +1180,50 @@ oatpp::Void ResultMapper::readRows(ResultData* dbData, const Type* type, v_int64
 
 }
 
+ColumnarResult ResultMapper::readColumnar(ResultData* dbData, v_int64 count) {
+
+  // Reserve for the whole window - or for the rest of a stored result
+  v_int64 expectedRows = count;
+  if (expectedRows < 0 && dbData->stmt && !dbData->useCursor && !dbData->unbuffered) {
+    expectedRows = static_cast<v_int64>(mysql_stmt_num_rows(dbData->stmt)) - dbData->rowIndex;
+  }
+
+  ColumnarResult result;
+  result.init(dbData->bindResults, dbData->colNames, expectedRows);
+
+  if (!dbData->isSuccess) {
+    return result;
+  }
+
+  while (dbData->hasMore && (count < 0 || result.getRowCount() < count)) {
+    result.appendRow(dbData->bindResults);
+    dbData->next();
+  }
+
+  return result;
+
+}
+
+v_int64 ResultMapper::writeJson(ResultData* dbData, data::stream::ConsistentOutputStream* stream, v_int64 count) {
+
+  stream->writeCharSimple('[');
+
+  v_int64 rowCount = 0;
+  if (dbData->isSuccess && dbData->hasMore) {
+    JsonResultWriter writer(dbData->bindResults, dbData->colNames);
+    while (dbData->hasMore && (count < 0 || rowCount < count)) {
+      if (rowCount > 0) {
+        stream->writeCharSimple(',');
+      }
+      writer.writeRow(stream, dbData->bindResults);
+      rowCount++;
+      dbData->next();
+    }
+  }
+
+  stream->writeCharSimple(']');
+  return rowCount;
+
+}
+
 }}}
@@ -1,12 +1,19 @@
 #ifndef oatpp_mariadb_mapping_ResultMapper_hpp
 #define oatpp_mariadb_mapping_ResultMapper_hpp
 
+#include "ColumnarResult.hpp"
 #include "Deserializer.hpp"
+#include "JsonResultWriter.hpp"
+#include "ResultSnapshot.hpp"
 #include "oatpp/core/data/mapping/TypeResolver.hpp"
 #include "oatpp/core/Types.hpp"
 
 #include <mysql/mysql.h>
 
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 namespace oatpp { namespace mariadb { namespace mapping {
 
 /**
@@ -14,12 +21,23 @@ namespace oatpp { namespace mariadb { namespace mapping {
  */
 class ResultMapper {
 public:
+  typedef oatpp::data::mapping::type::Type Type;
+public:
+
+  struct MappingPlan;
 
   /**
    * Result data. Get data row by row.
    */
   struct ResultData {
 
+    /**
+     * Initial buffer size of variable-length columns (strings, blobs, JSON). <br>
+     * Buffers are not sized to the declared column length (up to 4GB for `LONGBLOB`) - a longer value
+     * is detected by `MYSQL_DATA_TRUNCATED` and read in full into a grown buffer with `mysql_stmt_fetch_column`.
+     */
+    static constexpr unsigned long INITIAL_BUFFER_SIZE = 256;
+
     /**
      * Constructor.
      * @param pStmt
@@ -27,6 +45,15 @@ public:
      */
     ResultData(MYSQL_STMT* pStmt, const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver);
 
+    /**
+     * Constructor. Rows are replayed from the snapshot instead of being fetched from a statement.
+     * The first row is loaded right away - no &l:ResultMapper::ResultData::init (); call is needed.
+     * @param pSnapshot - &id:oatpp::mariadb::mapping::ResultSnapshot;.
+     * @param pTypeResolver
+     */
+    ResultData(const std::shared_ptr<const ResultSnapshot>& pSnapshot,
+               const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver);
+
     /**
      * Destructor. Free mariadb resources.
      */
@@ -97,6 +124,45 @@ public:
      */
     MYSQL_RES* metaResults;
 
+    /**
+     * `mysql_stmt_store_result` was already called by the caller (non-blocking execution).
+     * &l:ResultMapper::ResultData::init (); then skips storing the result.
+     */
+    bool resultStored;
+
+    /**
+     * The statement was executed with a server-side read-only cursor (`STMT_ATTR_CURSOR_TYPE`).
+     * &l:ResultMapper::ResultData::init (); then doesn't store the result - rows are fetched from the server
+     * in windows of `STMT_ATTR_PREFETCH_ROWS` rows while they are read.
+     */
+    bool useCursor;
+
+    /**
+     * Unbuffered (streaming) read - &l:ResultMapper::ResultData::init (); doesn't store the result,
+     * rows are read off the wire one by one while they are mapped.
+     */
+    bool unbuffered;
+
+    /**
+     * &l:ResultMapper::MappingPlan; of the DTO type last read from this result.
+     */
+    std::shared_ptr<const MappingPlan> mappingPlan;
+
+    /**
+     * Snapshot the rows are replayed from. `nullptr` - rows come from `stmt`.
+     */
+    std::shared_ptr<const ResultSnapshot> snapshot;
+
+    /**
+     * Index of the next snapshot row to replay.
+     */
+    v_int64 snapshotPosition;
+
+    /**
+     * If set, every fetched row is appended to this snapshot. Dropped if the snapshot grows past its size limit.
+     */
+    std::shared_ptr<ResultSnapshot> recorder;
+
   public:
 
     /**
@@ -114,8 +180,102 @@ public:
      */
     void bindResultsForCache();
 
+    /**
+     * Fetch next row into the bound buffers (`mysql_stmt_fetch`). <br>
+     * Variable-length values which didn't fit into their buffers are read in full - the buffers are grown,
+     * the value is fetched again with `mysql_stmt_fetch_column` and the result is rebound for the next rows.
+     * Replays the next row of the `snapshot` if there is one, appends the row to the `recorder` if there is one.
+     * @return - `0` on success, `MYSQL_NO_DATA` if there are no more rows, other value on error.
+     */
+    int fetchRow();
+
+  private:
+
+    static unsigned long getInitialBufferSize(unsigned long columnLength, bool isBinary);
+
+    int fetchStatementRow();
+
   };
 
+  /**
+   * Column-to-property mapping of one DTO type for one result set layout (column names and buffer types). <br>
+   * Built once and cached by the mapper, so rows are mapped in a loop over the mapped columns -
+   * no property lookup by name and no buffer type checks per row.
+   */
+  struct MappingPlan {
+
+    struct Column;
+
+    /**
+     * Reads the value of one column into the property of the object.
+     */
+    typedef void (*ColumnReader)(const ResultMapper*, ResultData*, const Column&, data::mapping::type::BaseObject*);
+
+    /**
+     * Writes the column value straight into the DTO field of the property's wrapper type. Used by
+     * &l:ResultMapper::readRowsAs ();.
+     */
+    typedef void (*FieldDecoder)(const MYSQL_BIND&, oatpp::Void&);
+
+    /**
+     * Mapped column.
+     */
+    struct Column {
+
+      /**
+       * Column index.
+       */
+      v_int64 index;
+
+      /**
+       * Property the column is mapped to.
+       */
+      data::mapping::type::BaseObject::Property* property;
+
+      /**
+       * Reader resolved for the column buffer type and the property type.
+       */
+      ColumnReader reader;
+
+      /**
+       * Deserializer method of the property type. `nullptr` if the type is read through an interpretation.
+       */
+      Deserializer::DeserializerMethod method;
+
+      /**
+       * Typed decoder for the buffer type and the property type. `nullptr` if there is none - `reader` is used then.
+       */
+      FieldDecoder decoder;
+
+      /**
+       * Leave the property untouched when the value is `NULL`.
+       */
+      bool skipNull;
+
+    };
+
+    /**
+     * DTO type.
+     */
+    const Type* type;
+
+    /**
+     * Mapped columns.
+     */
+    std::vector<Column> columns;
+
+    /**
+     * `Int32` properties set to `0` before a row is mapped.
+     */
+    std::vector<data::mapping::type::BaseObject::Property*> defaults;
+
+  };
+
+  /**
+   * Maximum number of cached mapping plans. The cache is dropped when it's full.
+   */
+  static constexpr v_uint32 MAX_MAPPING_PLANS = 1024;
+
 private:
   struct FieldInfo {
     const std::string name;
@@ -139,7 +299,6 @@ private:
 
   void initBind(MYSQL_BIND& bind, const std::shared_ptr<FieldInfo>& fieldInfo);
 
-  typedef oatpp::data::mapping::type::Type Type;
   typedef oatpp::Void (*ReadOneRowMethod)(ResultMapper*, ResultData*, const Type*);
   typedef oatpp::Void (*ReadRowsMethod)(ResultMapper*, ResultData*, const Type*, v_int64);
 private:
@@ -153,10 +312,38 @@ private:
   static oatpp::Void readRowsAsCollection(ResultMapper* _this, ResultData* dbData, const Type* type, v_int64 count);
   static oatpp::Void readRowsAsObject(ResultMapper* _this, ResultData* dbData, const Type* type, v_int64 count);
 
+  // Mapping plan column readers
+  static void readBoolean(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object);
+
+  template<typename T>
+  static void readInt32(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object);
+
+  template<typename T, class Wrapper>
+  static void readInt64(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object);
+
+  static void readWithMethod(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object);
+
+  static void readWithInterpretation(const ResultMapper* _this, ResultData* dbData, const MappingPlan::Column& column, data::mapping::type::BaseObject* object);
+
+  // Typed field decoders
+  template<typename T, class Wrapper>
+  static void decodeNumber(const MYSQL_BIND& bind, oatpp::Void& field);
+
+  static void decodeString(const MYSQL_BIND& bind, oatpp::Void& field);
+
+  template<class Wrapper>
+  static MappingPlan::FieldDecoder resolveNumberDecoder(const MYSQL_BIND& bind);
+
+  static MappingPlan::FieldDecoder resolveFieldDecoder(const MYSQL_BIND& bind, const Type* type);
+
+  std::shared_ptr<const MappingPlan> createMappingPlan(ResultData* dbData, const Type* type) const;
+
 private:
   Deserializer m_deserializer;
   std::vector<ReadOneRowMethod> m_readOneRowMethods;
   std::vector<ReadRowsMethod> m_readRowsMethods;
+  std::mutex m_plansMutex;
+  std::unordered_map<std::string, std::shared_ptr<const MappingPlan>> m_plans;
 public:
 
   /**
@@ -178,6 +365,16 @@ public:
    */
   void setReadRowsMethod(const data::mapping::type::ClassId& classId, ReadRowsMethod method);
 
+  /**
+   * Get &l:ResultMapper::MappingPlan; of the DTO type for the result. <br>
+   * The plan is looked up once per result set and DTO type - by the column layout, in the mapper's cache -
+   * and kept in `dbData`, so all executions of a template with the same DTO type share one plan.
+   * @param dbData - &l:ResultMapper::ResultData;.
+   * @param type - DTO type.
+   * @return - &l:ResultMapper::MappingPlan;.
+   */
+  std::shared_ptr<const MappingPlan> getMappingPlan(ResultData* dbData, const Type* type);
+
   /**
    * Read one row to oatpp object or collection. <br>
    * Allowed output type classes are:
@@ -210,6 +407,79 @@ public:
    */
   oatpp::Void readRows(ResultData* dbData, const Type* type, v_int64 count);
 
+  /**
+   * Read `count` of rows into column-major typed buffers - see &id:oatpp::mariadb::mapping::ColumnarResult;. <br>
+   * Values are copied straight from the bound result buffers, no oatpp objects are created.
+   * @param dbData - &l:ResultMapper::ResultData;.
+   * @param count - number of rows to read. `-1` - all remaining rows.
+   * @return - &id:oatpp::mariadb::mapping::ColumnarResult;.
+   */
+  ColumnarResult readColumnar(ResultData* dbData, v_int64 count);
+
+  /**
+   * Write `count` of rows to the stream as a JSON array of objects - see &id:oatpp::mariadb::mapping::JsonResultWriter;. <br>
+   * Rows are written one by one straight from the bound result buffers - no DTOs are created.
+   * @param dbData - &l:ResultMapper::ResultData;.
+   * @param stream - output stream.
+   * @param count - number of rows to write. `-1` - all remaining rows.
+   * @return - number of rows written.
+   */
+  v_int64 writeJson(ResultData* dbData, data::stream::ConsistentOutputStream* stream, v_int64 count);
+
+  /**
+   * Read `count` of rows into a vector of DTOs of a type known at compile time. <br>
+   * Same mapping as &l:ResultMapper::readRows (); for `oatpp::Vector<oatpp::Object<DtoT>>`, but objects and the
+   * vector are created directly and values are decoded by typed decoders resolved in the
+   * &l:ResultMapper::MappingPlan; - written straight into the DTO fields, without `oatpp::Void` boxing
+   * or class id dispatch per cell. Columns without a typed decoder fall back to the generic deserializer.
+   * @tparam DtoT - DTO class.
+   * @param dbData - &l:ResultMapper::ResultData;.
+   * @param count - number of rows to read. `-1` - all remaining rows.
+   * @return - `oatpp::Vector<oatpp::Object<DtoT>>`.
+   */
+  template<class DtoT>
+  oatpp::Vector<oatpp::Object<DtoT>> readRowsAs(ResultData* dbData, v_int64 count = -1) {
+
+    auto rows = oatpp::Vector<oatpp::Object<DtoT>>::createShared();
+    if (!dbData->isSuccess || !dbData->hasMore) {
+      return rows;
+    }
+
+    auto plan = getMappingPlan(dbData, oatpp::Object<DtoT>::Class::getType());
+    if (count > 0) {
+      rows->reserve(static_cast<size_t>(count));
+    }
+
+    while (dbData->hasMore && (count < 0 || static_cast<v_int64>(rows->size()) < count)) {
+
+      auto object = oatpp::Object<DtoT>::createShared();
+      auto base = static_cast<data::mapping::type::BaseObject*>(object.get());
+
+      for (auto property : plan->defaults) {
+        reinterpret_cast<oatpp::Int32&>(property->getAsRef(base)) = 0;
+      }
+
+      for (const auto& column : plan->columns) {
+        const auto& bind = dbData->bindResults[column.index];
+        if (column.skipNull && *bind.is_null) {
+          continue;
+        }
+        if (column.decoder) {
+          column.decoder(bind, column.property->getAsRef(base));
+        } else {
+          column.reader(this, dbData, column, base);
+        }
+      }
+
+      rows->push_back(std::move(object));
+      dbData->next();
+
+    }
+
+    return rows;
+
+  }
+
 };
 
 }}}
@@ -0,0 +1,99 @@
+#include "ResultSnapshot.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+ResultSnapshot::ResultSnapshot(v_int64 maxBytes)
+  : m_rowCount(0)
+  , m_metadataSize(0)
+  , m_maxBytes(maxBytes)
+{}
+
+void ResultSnapshot::init(const std::vector<MYSQL_BIND>& binds, const std::vector<oatpp::String>& names) {
+
+  m_names = names;
+  m_columns.resize(binds.size());
+  m_metadataSize = static_cast<v_int64>(binds.size() * sizeof(MYSQL_BIND));
+  for (const auto& name : names) {
+    m_metadataSize += name ? static_cast<v_int64>(name->size()) : 0;
+  }
+
+  for (size_t i = 0; i < binds.size(); i++) {
+    MYSQL_BIND& column = m_columns[i];
+    std::memset(&column, 0, sizeof(MYSQL_BIND));
+    column.buffer_type = binds[i].buffer_type;
+    column.is_unsigned = binds[i].is_unsigned;
+  }
+
+}
+
+bool ResultSnapshot::appendRow(const std::vector<MYSQL_BIND>& binds) {
+
+  for (size_t i = 0; i < m_columns.size(); i++) {
+
+    const MYSQL_BIND& bind = binds[i];
+    Cell cell;
+    cell.offset = m_data.size();
+    cell.isNull = *bind.is_null;
+    cell.length = 0;
+
+    if (!cell.isNull) {
+      const bool isString = bind.buffer_type == MYSQL_TYPE_STRING;
+      cell.length = isString ? std::min(*bind.length, bind.buffer_length) : bind.buffer_length;
+      // null terminator for strings, every cell starts 8-byte aligned
+      v_uint64 size = (cell.length + (isString ? 1 : 0) + 7) & ~static_cast<v_uint64>(7);
+      m_data.resize(m_data.size() + size, 0);
+      std::memcpy(m_data.data() + cell.offset, bind.buffer, cell.length);
+    }
+
+    m_cells.push_back(cell);
+
+  }
+
+  m_rowCount++;
+
+  return getByteSize() <= m_maxBytes;
+
+}
+
+void ResultSnapshot::loadRow(v_int64 row, std::vector<MYSQL_BIND>& binds, std::vector<std::vector<char>>& buffers) const {
+  const Cell* cells = m_cells.data() + row * static_cast<v_int64>(m_columns.size());
+  for (size_t i = 0; i < m_columns.size(); i++) {
+    MYSQL_BIND& bind = binds[i];
+    const Cell& cell = cells[i];
+    *bind.is_null = cell.isNull;
+    *bind.length = cell.length;
+    if (cell.isNull) {
+      continue;
+    }
+    // room for the null terminator of strings
+    auto& buffer = buffers[i];
+    if (buffer.size() <= cell.length) {
+      buffer.resize(cell.length + 1);
+      bind.buffer = buffer.data();
+      bind.buffer_length = buffer.size();
+    }
+    std::memcpy(buffer.data(), m_data.data() + cell.offset, cell.length);
+    buffer[cell.length] = 0;
+  }
+}
+
+const std::vector<oatpp::String>& ResultSnapshot::getNames() const {
+  return m_names;
+}
+
+const std::vector<MYSQL_BIND>& ResultSnapshot::getColumns() const {
+  return m_columns;
+}
+
+v_int64 ResultSnapshot::getRowCount() const {
+  return m_rowCount;
+}
+
+v_int64 ResultSnapshot::getByteSize() const {
+  return static_cast<v_int64>(sizeof(ResultSnapshot) + m_data.size() + m_cells.size() * sizeof(Cell)) + m_metadataSize;
+}
+
+}}}
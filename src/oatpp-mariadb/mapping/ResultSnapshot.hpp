@@ -0,0 +1,95 @@
+#ifndef oatpp_mariadb_mapping_ResultSnapshot_hpp
+#define oatpp_mariadb_mapping_ResultSnapshot_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+#include <vector>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+/**
+ * Copy of the rows of a result set as they were held in the bound result buffers. <br>
+ * Recorded by &id:oatpp::mariadb::mapping::ResultMapper::ResultData; while the rows are read and replayed
+ * into the same kind of buffers later, so cached rows are mapped by the regular mapper paths - into any DTO type,
+ * columnar or JSON. Values are stored in one block, each cell aligned to 8 bytes.
+ * Immutable once recorded - may be replayed by many threads at once.
+ */
+class ResultSnapshot {
+private:
+
+  struct Cell {
+    v_uint64 offset;
+    unsigned long length;
+    bool isNull;
+  };
+
+private:
+  std::vector<oatpp::String> m_names;
+  std::vector<MYSQL_BIND> m_columns;
+  std::vector<Cell> m_cells;
+  std::vector<char> m_data;
+  v_int64 m_rowCount;
+  v_int64 m_metadataSize;
+  v_int64 m_maxBytes;
+public:
+
+  /**
+   * Constructor.
+   * @param maxBytes - size limit. &l:ResultSnapshot::appendRow (); fails once the snapshot grows past it.
+   */
+  explicit ResultSnapshot(v_int64 maxBytes);
+
+  /**
+   * Set up columns. Only the buffer types and unsigned flags of the binds are kept.
+   * @param binds - result binds (`ResultMapper::ResultData::bindResults`).
+   * @param names - column names.
+   */
+  void init(const std::vector<MYSQL_BIND>& binds, const std::vector<oatpp::String>& names);
+
+  /**
+   * Append the row currently held in the bound result buffers.
+   * @param binds - result binds the snapshot was initialized with.
+   * @return - `false` if the snapshot grew past its size limit. The snapshot must not be used then.
+   */
+  bool appendRow(const std::vector<MYSQL_BIND>& binds);
+
+  /**
+   * Copy the values of a row into result buffers. Deserializers clear the buffers they read, so every replay
+   * gets its own copy. Buffers are grown as needed and the binds are pointed at them.
+   * @param row - row index.
+   * @param binds - binds created from &l:ResultSnapshot::getColumns ();. Their `is_null` and `length` are set.
+   * @param buffers - buffers of the binds, one per column.
+   */
+  void loadRow(v_int64 row, std::vector<MYSQL_BIND>& binds, std::vector<std::vector<char>>& buffers) const;
+
+  /**
+   * Get column names.
+   * @return
+   */
+  const std::vector<oatpp::String>& getNames() const;
+
+  /**
+   * Get column binds - buffer types and unsigned flags, no buffers.
+   * @return
+   */
+  const std::vector<MYSQL_BIND>& getColumns() const;
+
+  /**
+   * Get number of rows.
+   * @return
+   */
+  v_int64 getRowCount() const;
+
+  /**
+   * Get approximate memory used by the snapshot.
+   * @return - size in bytes.
+   */
+  v_int64 getByteSize() const;
+
+};
+
+}}}
+
+#endif // oatpp_mariadb_mapping_ResultSnapshot_hpp
@@ -22,8 +22,15 @@
  *
  ***************************************************************************/
 
+
 #include "Serializer.hpp"
 
+#include "oatpp-mariadb/types/LongData.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
 #if defined(WIN32) || defined(_WIN32)
   #include <winsock2.h>
 #else
@@ -32,6 +39,114 @@
 
 namespace oatpp { namespace mariadb { namespace mapping {
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Serializer::BindContext
+
+namespace {
+
+constexpr v_buff_size ARENA_ALIGNMENT = alignof(std::max_align_t);
+
+v_buff_size alignSize(v_buff_size size) {
+  return (size + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1);
+}
+
+}
+
+Serializer::BindContext::BindContext(v_uint32 paramCount)
+  : m_block(m_inline)
+  , m_blockSize(INLINE_SIZE)
+  , m_blockPosition(0)
+  , m_binds(nullptr)
+  , m_values(nullptr)
+  , m_paramCount(paramCount)
+{
+  if (m_paramCount > 0) {
+    m_binds = static_cast<MYSQL_BIND*>(allocate(sizeof(MYSQL_BIND) * m_paramCount));
+    std::memset(m_binds, 0, sizeof(MYSQL_BIND) * m_paramCount);
+    for (v_uint32 i = 0; i < m_paramCount; i++) {
+      m_binds[i].buffer_type = MYSQL_TYPE_NULL;
+      m_binds[i].is_null_value = 1;
+      m_binds[i].is_null = &m_binds[i].is_null_value;
+    }
+    m_values = static_cast<oatpp::Void*>(allocate(sizeof(oatpp::Void) * m_paramCount));
+    for (v_uint32 i = 0; i < m_paramCount; i++) {
+      new (&m_values[i]) oatpp::Void();
+    }
+  }
+}
+
+Serializer::BindContext::~BindContext() {
+  for (v_uint32 i = 0; i < m_paramCount; i++) {
+    m_values[i].~Void();
+  }
+}
+
+void* Serializer::BindContext::allocate(v_buff_size size) {
+  size = alignSize(size > 0 ? size : 1);
+  if (m_blockPosition + size > m_blockSize) {
+    // a new block at least as large as the inline one, the rest of the old block is wasted
+    m_blockSize = std::max(size, INLINE_SIZE);
+    m_heapBlocks.emplace_back(new char[m_blockSize]);
+    m_block = m_heapBlocks.back().get();
+    m_blockPosition = 0;
+  }
+  void* result = m_block + m_blockPosition;
+  m_blockPosition += size;
+  return result;
+}
+
+MYSQL_BIND& Serializer::BindContext::getBind(v_uint32 paramIndex) {
+  if (paramIndex >= m_paramCount) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::Serializer::BindContext::getBind()]: Error. "
+                             "Parameter index out of range: " + std::to_string(paramIndex));
+  }
+  return m_binds[paramIndex];
+}
+
+void Serializer::BindContext::retain(v_uint32 paramIndex, const oatpp::Void& value) {
+  if (paramIndex >= m_paramCount) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::Serializer::BindContext::retain()]: Error. "
+                             "Parameter index out of range: " + std::to_string(paramIndex));
+  }
+  m_values[paramIndex] = value;
+}
+
+void Serializer::BindContext::addLongData(v_uint32 paramIndex, const oatpp::Void& value) {
+  retain(paramIndex, value);
+  m_longDataParams.push_back(paramIndex);
+}
+
+bool Serializer::BindContext::hasLongData() const {
+  return !m_longDataParams.empty();
+}
+
+v_uint32 Serializer::BindContext::getParamCount() const {
+  return m_paramCount;
+}
+
+v_uint32 Serializer::BindContext::getHeapBlockCount() const {
+  return static_cast<v_uint32>(m_heapBlocks.size());
+}
+
+void Serializer::BindContext::bind(MYSQL_STMT* stmt) {
+  if (!stmt) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::Serializer::BindContext::bind()]: Error. Statement is null.");
+  }
+  if (m_paramCount > 0 && mysql_stmt_bind_param(stmt, m_binds)) {
+    auto error = mysql_stmt_error(stmt);
+    OATPP_LOGE("Serializer", "Failed to bind parameters: %s", error);
+    throw std::runtime_error(std::string("[oatpp::mariadb::mapping::Serializer::BindContext::bind()]: Error. "
+                                         "Failed to bind parameters: ") + error);
+  }
+  for (auto paramIndex : m_longDataParams) {
+    auto bytes = m_values[paramIndex].cast<types::LongData>()->send(stmt, paramIndex);
+    OATPP_LOGD("Serializer", "Sent %lld bytes of long data for parameter %u", (long long) bytes, paramIndex);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Serializer
+
 Serializer::Serializer() {
 
   m_methods.resize(data::mapping::type::ClassId::getClassCount(), nullptr);
@@ -40,20 +155,20 @@ Serializer::Serializer() {
   setSerializerMethod(data::mapping::type::__class::Any::CLASS_ID, nullptr);
   setSerializerMethod(data::mapping::type::__class::Boolean::CLASS_ID, &Serializer::serializeBoolean);
 
-  setSerializerMethod(data::mapping::type::__class::Int8::CLASS_ID, &Serializer::serializeInt8);
-  setSerializerMethod(data::mapping::type::__class::UInt8::CLASS_ID, &Serializer::serializeUInt8);
+  setSerializerMethod(data::mapping::type::__class::Int8::CLASS_ID, &Serializer::serializeFixed<oatpp::Int8, int8_t, MYSQL_TYPE_TINY, false>);
+  setSerializerMethod(data::mapping::type::__class::UInt8::CLASS_ID, &Serializer::serializeFixed<oatpp::UInt8, uint8_t, MYSQL_TYPE_TINY, true>);
 
-  setSerializerMethod(data::mapping::type::__class::Int16::CLASS_ID, &Serializer::serializeInt16);
-  setSerializerMethod(data::mapping::type::__class::UInt16::CLASS_ID, &Serializer::serializeUInt16);
+  setSerializerMethod(data::mapping::type::__class::Int16::CLASS_ID, &Serializer::serializeFixed<oatpp::Int16, int16_t, MYSQL_TYPE_SHORT, false>);
+  setSerializerMethod(data::mapping::type::__class::UInt16::CLASS_ID, &Serializer::serializeFixed<oatpp::UInt16, uint16_t, MYSQL_TYPE_SHORT, true>);
 
-  setSerializerMethod(data::mapping::type::__class::Int32::CLASS_ID, &Serializer::serializeInt32);
-  setSerializerMethod(data::mapping::type::__class::UInt32::CLASS_ID, &Serializer::serializeUInt32);
+  setSerializerMethod(data::mapping::type::__class::Int32::CLASS_ID, &Serializer::serializeFixed<oatpp::Int32, int32_t, MYSQL_TYPE_LONG, false>);
+  setSerializerMethod(data::mapping::type::__class::UInt32::CLASS_ID, &Serializer::serializeFixed<oatpp::UInt32, uint32_t, MYSQL_TYPE_LONG, true>);
 
-  setSerializerMethod(data::mapping::type::__class::Int64::CLASS_ID, &Serializer::serializeInt64);
-  setSerializerMethod(data::mapping::type::__class::UInt64::CLASS_ID, &Serializer::serializeUInt64);
+  setSerializerMethod(data::mapping::type::__class::Int64::CLASS_ID, &Serializer::serializeFixed<oatpp::Int64, int64_t, MYSQL_TYPE_LONGLONG, false>);
+  setSerializerMethod(data::mapping::type::__class::UInt64::CLASS_ID, &Serializer::serializeFixed<oatpp::UInt64, uint64_t, MYSQL_TYPE_LONGLONG, true>);
 
-  setSerializerMethod(data::mapping::type::__class::Float32::CLASS_ID, &Serializer::serializeFloat32);
-  setSerializerMethod(data::mapping::type::__class::Float64::CLASS_ID, &Serializer::serializeFloat64);
+  setSerializerMethod(data::mapping::type::__class::Float32::CLASS_ID, &Serializer::serializeFixed<oatpp::Float32, float, MYSQL_TYPE_FLOAT, false>);
+  setSerializerMethod(data::mapping::type::__class::Float64::CLASS_ID, &Serializer::serializeFixed<oatpp::Float64, double, MYSQL_TYPE_DOUBLE, false>);
 
   setSerializerMethod(data::mapping::type::__class::AbstractObject::CLASS_ID, nullptr);
   setSerializerMethod(data::mapping::type::__class::AbstractEnum::CLASS_ID, &Serializer::serializeEnum);
@@ -65,29 +180,8 @@ Serializer::Serializer() {
   setSerializerMethod(data::mapping::type::__class::AbstractPairList::CLASS_ID, nullptr);
   setSerializerMethod(data::mapping::type::__class::AbstractUnorderedMap::CLASS_ID, nullptr);
 
-}
+  setSerializerMethod(types::__class::LongData::CLASS_ID, &Serializer::serializeLongData);
 
-Serializer::~Serializer() {
-  // Clean up all allocated memory
-  for(auto& param : m_bindParams) {
-    if(param.buffer != nullptr) {
-      free(param.buffer);
-      param.buffer = nullptr;
-    }
-    if(param.is_null != nullptr && param.is_null != &param.is_null_value) {
-      free(param.is_null);
-      param.is_null = nullptr;
-    }
-    if(param.length != nullptr && param.length != &param.length_value) {
-      free(param.length);
-      param.length = nullptr;
-    }
-    if(param.error != nullptr && param.error != &param.error_value) {
-      free(param.error);
-      param.error = nullptr;
-    }
-  }
-  m_bindParams.clear();
 }
 
 void Serializer::setSerializerMethod(const data::mapping::type::ClassId& classId, SerializerMethod method) {
@@ -98,15 +192,12 @@ void Serializer::setSerializerMethod(const data::mapping::type::ClassId& classId
   m_methods[id] = method;
 }
 
-void Serializer::serialize(MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) const {
+void Serializer::serialize(BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph) const {
   auto id = polymorph.getValueType()->classId.id;
-  auto& method = m_methods[id];
-
-  OATPP_LOGD("Serializer::serialize()", "classId=%d, className=%s, paramIndex=%d, method=%p", 
-    id, polymorph.getValueType()->classId.name, paramIndex, method);
+  auto method = id < m_methods.size() ? m_methods[id] : nullptr;
 
   if(method) {
-    (*method)(this, stmt, paramIndex, polymorph);
+    (*method)(this, context, paramIndex, polymorph);
   } else {
     throw std::runtime_error("[oatpp::mariadb::mapping::Serializer::serialize()]: "
                              "Error. No serialize method for type '" + std::string(polymorph.getValueType()->classId.name) +
@@ -114,607 +205,79 @@ void Serializer::serialize(MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::V
   }
 }
 
-std::vector<MYSQL_BIND>& Serializer::getBindParams() const {
-  return m_bindParams;
-}
-
-void Serializer::setBindParam(MYSQL_BIND& bind, v_uint32 paramIndex) const {
-  if (paramIndex >= m_bindParams.size()) {
-    m_bindParams.resize(paramIndex + 1);
-  }
-  // Zero out the target bind structure before copying
-  std::memset(&m_bindParams[paramIndex], 0, sizeof(MYSQL_BIND));
-  // Copy the bind parameter
-  m_bindParams[paramIndex] = bind;
-}
-
-void Serializer::bindParameters(MYSQL_STMT* stmt) const {
-  if (!stmt) {
-    OATPP_LOGE("Serializer", "Error: MySQL statement is null");
-    throw std::runtime_error("MySQL statement is null");
-  }
-  
-  if (!m_bindParams.empty()) {
-    if(mysql_stmt_bind_param(stmt, m_bindParams.data())) {
-      auto error = mysql_stmt_error(stmt);
-      OATPP_LOGE("Serializer", "Failed to bind parameters: %s", error);
-      throw std::runtime_error(error);
-    }
-  }
-}
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// Serializer functions
-
-void Serializer::serializeString(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  OATPP_LOGD("Serializer", "Serializing String value for paramIndex=%d", paramIndex);
-  
-  if (!stmt) {
-    OATPP_LOGE("Serializer", "Error: MySQL statement is null");
-    throw std::runtime_error("MySQL statement is null");
-  }
-  
-  if(paramIndex >= _this->m_bindParams.size()) {
-    OATPP_LOGD("Serializer", "Resizing bind params array from %d to %d", _this->m_bindParams.size(), paramIndex + 1);
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  
-  bind.is_null = (my_bool*)malloc(sizeof(my_bool));
-  if(!bind.is_null) {
-    OATPP_LOGE("Serializer", "Failed to allocate memory for is_null indicator");
-    throw std::runtime_error("Failed to allocate memory for is_null indicator");
-  }
-  
-  bind.length = (unsigned long*)malloc(sizeof(unsigned long));
-  if(!bind.length) {
-    free(bind.is_null);
-    OATPP_LOGE("Serializer", "Failed to allocate memory for length indicator");
-    throw std::runtime_error("Failed to allocate memory for length indicator");
-  }
-  
-  if(polymorph) {
-    auto str = polymorph.cast<oatpp::String>();
-    if(str) {
-      const char* cstr = str->c_str();
-      std::size_t len = str->length();
-      
-      // Always allocate buffer, even for empty strings
-      bind.buffer = malloc(len > 0 ? len : 1);
-      if(!bind.buffer) {
-        free(bind.is_null);
-        free(bind.length);
-        OATPP_LOGE("Serializer", "Failed to allocate memory for string value");
-        throw std::runtime_error("Failed to allocate memory for string value");
-      }
-      
-      if (len > 0) {
-        std::memcpy(bind.buffer, cstr, len);
-      }
-      
-      bind.buffer_length = len;
-      *bind.length = len;
-      *bind.is_null = 0;
-
-      // Check if this is a binary string by looking for non-printable characters
-      bool isBinary = false;
-      for(size_t i = 0; i < len; i++) {
-        unsigned char c = static_cast<unsigned char>(cstr[i]);
-        if(c > 127 || (c < 32 && c != '\t' && c != '\n' && c != '\r')) {
-          isBinary = true;
-          break;
-        }
-      }
-
-      // Use BLOB type for binary data, STRING for text
-      bind.buffer_type = isBinary ? MYSQL_TYPE_BLOB : MYSQL_TYPE_STRING;
-      OATPP_LOGD("Serializer", "Using %s type for field, length=%lu, data=%s", 
-                 isBinary ? "BLOB" : "STRING", 
-                 *bind.length,
-                 isBinary ? "<binary>" : (len > 0 ? cstr : "<empty>"));
-    } else {
-      bind.buffer = nullptr;
-      bind.buffer_length = 0;
-      *bind.length = 0;
-      *bind.is_null = 1;
-      bind.buffer_type = MYSQL_TYPE_STRING;
-      OATPP_LOGD("Serializer", "String value is null");
-    }
-  } else {
-    bind.buffer = nullptr;
-    bind.buffer_length = 0;
-    *bind.length = 0;
-    *bind.is_null = 1;
-    bind.buffer_type = MYSQL_TYPE_STRING;
-  }
-}
-
-void Serializer::serializeBoolean(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  OATPP_LOGD("Serializer", "Serializing Boolean value for paramIndex=%d", paramIndex);
-  
-  if (!stmt) {
-    OATPP_LOGE("Serializer", "Error: MySQL statement is null");
-    throw std::runtime_error("MySQL statement is null");
-  }
-  
-  if(paramIndex >= _this->m_bindParams.size()) {
-    OATPP_LOGD("Serializer", "Resizing bind params array from %d to %d", _this->m_bindParams.size(), paramIndex + 1);
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  
-  bind.is_null = (my_bool*)malloc(sizeof(my_bool));
-  if(!bind.is_null) {
-    OATPP_LOGE("Serializer", "Failed to allocate memory for is_null indicator");
-    throw std::runtime_error("Failed to allocate memory for is_null indicator");
-  }
-  
-  bind.buffer = malloc(sizeof(signed char));
-  if(!bind.buffer) {
-    free(bind.is_null);
-    OATPP_LOGE("Serializer", "Failed to allocate memory for Boolean value");
-    throw std::runtime_error("Failed to allocate memory for Boolean value");
-  }
-  
-  bind.buffer_type = MYSQL_TYPE_TINY;
-  bind.is_unsigned = false;  // Use signed char for boolean
-  bind.buffer_length = sizeof(signed char);
-  
-  if(polymorph) {
-    auto value = polymorph.cast<oatpp::Boolean>();
-    if(value.getValueType() != nullptr) {  // Check if value is not null
-      *static_cast<signed char*>(bind.buffer) = value.getValue(false) ? 1 : 0;
-      *bind.is_null = 0;
-      OATPP_LOGD("Serializer", "Serializing boolean value: %d", (int)*static_cast<signed char*>(bind.buffer));
-    } else {
-      *bind.is_null = 1;
-      *static_cast<signed char*>(bind.buffer) = 0;
-      OATPP_LOGD("Serializer", "Serializing null boolean value (value is null)");
-    }
-  } else {
-    *bind.is_null = 1;
-    *static_cast<signed char*>(bind.buffer) = 0;
-    OATPP_LOGD("Serializer", "Serializing null boolean value (polymorph is null)");
-  }
-}
-
-void Serializer::serializeInt8(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  if(paramIndex >= _this->m_bindParams.size()) {
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_TINY;
-  
-  if(polymorph) {
-    auto value = polymorph.cast<oatpp::Int8>();
-    if(value) {
-      bind.buffer = malloc(sizeof(int8_t));
-      if(!bind.buffer) {
-        throw std::runtime_error("Failed to allocate memory for Int8 value");
-      }
-      *static_cast<int8_t*>(bind.buffer) = value;
-      bind.buffer_length = sizeof(int8_t);
-      bind.is_null_value = 0;
-    } else {
-      bind.is_null_value = 1;
-    }
-  } else {
-    bind.is_null_value = 1;
-  }
-  
-  bind.is_null = &bind.is_null_value;
-}
-
-void Serializer::serializeUInt8(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  OATPP_LOGD("Serializer", "Serializing UInt8 value for paramIndex=%d", paramIndex);
-  
-  if (!stmt) {
-    OATPP_LOGE("Serializer", "Error: MySQL statement is null");
-    throw std::runtime_error("MySQL statement is null");
-  }
-  
-  if(paramIndex >= _this->m_bindParams.size()) {
-    OATPP_LOGD("Serializer", "Resizing bind params array from %d to %d", _this->m_bindParams.size(), paramIndex + 1);
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  
-  // Allocate buffer for the value
-  bind.buffer = malloc(sizeof(uint8_t));
-  if(!bind.buffer) {
-    OATPP_LOGE("Serializer", "Failed to allocate memory for UInt8 value");
-    throw std::runtime_error("Failed to allocate memory for UInt8 value");
-  }
-  std::memset(bind.buffer, 0, sizeof(uint8_t));
-  
-  // Allocate is_null indicator
-  bind.is_null = (my_bool*)malloc(sizeof(my_bool));
-  if(!bind.is_null) {
-    free(bind.buffer);
-    OATPP_LOGE("Serializer", "Failed to allocate memory for is_null indicator");
-    throw std::runtime_error("Failed to allocate memory for is_null indicator");
-  }
-  
-  bind.buffer_type = MYSQL_TYPE_TINY;
-  bind.is_unsigned = 1;  // Unsigned integer
-  bind.buffer_length = sizeof(uint8_t);
-  
-  if(polymorph) {
-    auto value = polymorph.cast<oatpp::UInt8>();
-    if(value) {
-      *static_cast<uint8_t*>(bind.buffer) = static_cast<uint8_t>(*value);
-      *bind.is_null = 0;
-      OATPP_LOGD("Serializer", "UInt8 value set: %u", *static_cast<uint8_t*>(bind.buffer));
-    } else {
-      *bind.is_null = 1;
-      OATPP_LOGD("Serializer", "UInt8 value is null");
-    }
-  } else {
-    *bind.is_null = 1;
-    OATPP_LOGD("Serializer", "UInt8 value is null (polymorph is null)");
-  }
-}
-
-void Serializer::serializeInt16(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  if(paramIndex >= _this->m_bindParams.size()) {
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
+MYSQL_BIND& Serializer::initBind(BindContext& context, v_uint32 paramIndex, enum_field_types bufferType, bool isUnsigned) {
+  auto& bind = context.getBind(paramIndex);
   std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_SHORT;
-  
-  if(polymorph) {
-    auto value = polymorph.cast<oatpp::Int16>();
-    if(value) {
-      bind.buffer = malloc(sizeof(int16_t));
-      if(!bind.buffer) {
-        throw std::runtime_error("Failed to allocate memory for Int16 value");
-      }
-      *static_cast<int16_t*>(bind.buffer) = value;
-      bind.buffer_length = sizeof(int16_t);
-      bind.is_null_value = 0;
-    } else {
-      bind.is_null_value = 1;
-    }
-  } else {
-    bind.is_null_value = 1;
-  }
-  
+  bind.buffer_type = bufferType;
+  bind.is_unsigned = isUnsigned;
+  bind.is_null_value = 1;
   bind.is_null = &bind.is_null_value;
+  bind.length = &bind.length_value;
+  return bind;
 }
 
-void Serializer::serializeUInt16(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  if(paramIndex >= _this->m_bindParams.size()) {
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_SHORT;
-  bind.is_unsigned = true;
-  
-  if(polymorph) {
-    auto value = polymorph.cast<oatpp::UInt16>();
-    if(value) {
-      bind.buffer = malloc(sizeof(uint16_t));
-      if(!bind.buffer) {
-        throw std::runtime_error("Failed to allocate memory for UInt16 value");
-      }
-      *static_cast<uint16_t*>(bind.buffer) = value;
-      bind.buffer_length = sizeof(uint16_t);
-      bind.is_null_value = 0;
-    } else {
-      bind.is_null_value = 1;
-    }
-  } else {
-    bind.is_null_value = 1;
-  }
-  
-  bind.is_null = &bind.is_null_value;
-}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Serializer functions
 
-void Serializer::serializeInt32(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  OATPP_LOGD("Serializer", "Serializing Int32 value for paramIndex=%d", paramIndex);
-  
-  if (!stmt) {
-    OATPP_LOGE("Serializer", "Error: MySQL statement is null");
-    throw std::runtime_error("MySQL statement is null");
-  }
-  
-  if(paramIndex >= _this->m_bindParams.size()) {
-    OATPP_LOGD("Serializer", "Resizing bind params array from %d to %d", _this->m_bindParams.size(), paramIndex + 1);
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  
+template<class Wrapper, typename T, enum_field_types TYPE, bool UNSIGNED>
+void Serializer::serializeFixed(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph) {
+  (void) _this;
+  auto& bind = initBind(context, paramIndex, TYPE, UNSIGNED);
   if(polymorph) {
-    auto value = polymorph.cast<oatpp::Int32>();
-    
-    bind.is_null = (my_bool*)malloc(sizeof(my_bool));
-    if(!bind.is_null) {
-      throw std::runtime_error("Failed to allocate memory for is_null indicator");
-    }
-    
-    bind.length = (unsigned long*)malloc(sizeof(unsigned long));
-    if(!bind.length) {
-      free(bind.is_null);
-      throw std::runtime_error("Failed to allocate memory for length indicator");
-    }
-    
-    if(value) {
-      bind.buffer_type = MYSQL_TYPE_LONG;
-      bind.buffer = malloc(sizeof(int32_t));
-      if(!bind.buffer) {
-        free(bind.is_null);
-        free(bind.length);
-        throw std::runtime_error("Failed to allocate memory for Int32 value");
-      }
-      *static_cast<int32_t*>(bind.buffer) = static_cast<int32_t>(value);
-      bind.buffer_length = sizeof(int32_t);
-      bind.is_unsigned = 0;
-      *bind.is_null = 0;
-      *bind.length = sizeof(int32_t);
-      
-      OATPP_LOGD("Serializer", "Int32 value set: %d, buffer_type=%d, buffer_length=%d", 
-                 static_cast<int32_t>(value), bind.buffer_type, bind.buffer_length);
-    } else {
-      bind.buffer_type = MYSQL_TYPE_NULL;
-      *bind.is_null = 1;
-      *bind.length = 0;
-      bind.buffer = nullptr;
-      bind.buffer_length = 0;
-      OATPP_LOGD("Serializer", "Int32 value is null");
-    }
-  } else {
-    bind.is_null = (my_bool*)malloc(sizeof(my_bool));
-    if(!bind.is_null) {
-      throw std::runtime_error("Failed to allocate memory for is_null indicator");
-    }
-    
-    bind.length = (unsigned long*)malloc(sizeof(unsigned long));
-    if(!bind.length) {
-      free(bind.is_null);
-      throw std::runtime_error("Failed to allocate memory for length indicator");
-    }
-    
-    bind.buffer_type = MYSQL_TYPE_NULL;
-    *bind.is_null = 1;
-    *bind.length = 0;
-    bind.buffer = nullptr;
-    bind.buffer_length = 0;
-    OATPP_LOGD("Serializer", "Int32 value is null (polymorph is null)");
+    auto value = polymorph.cast<Wrapper>();
+    auto buffer = static_cast<T*>(context.allocate(sizeof(T)));
+    *buffer = static_cast<T>(*value);
+    bind.buffer = buffer;
+    bind.buffer_length = sizeof(T);
+    bind.length_value = sizeof(T);
+    bind.is_null_value = 0;
   }
 }
 
-void Serializer::serializeUInt32(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  if(paramIndex >= _this->m_bindParams.size()) {
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_LONG;
-  bind.is_unsigned = true;
-  
+void Serializer::serializeString(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph) {
+  (void) _this;
+  auto& bind = initBind(context, paramIndex, MYSQL_TYPE_STRING, false);
   if(polymorph) {
-    auto value = polymorph.cast<oatpp::UInt32>();
-    if(value) {
-      bind.buffer = malloc(sizeof(uint32_t));
-      if(!bind.buffer) {
-        throw std::runtime_error("Failed to allocate memory for UInt32 value");
+    auto str = polymorph.cast<oatpp::String>();
+    const char* cstr = str->data();
+    std::size_t len = str->size();
+
+    // Check if this is a binary string by looking for non-printable characters
+    bool isBinary = false;
+    for(size_t i = 0; i < len; i++) {
+      unsigned char c = static_cast<unsigned char>(cstr[i]);
+      if(c > 127 || (c < 32 && c != '\t' && c != '\n' && c != '\r')) {
+        isBinary = true;
+        break;
       }
-      *static_cast<uint32_t*>(bind.buffer) = value;
-      bind.buffer_length = sizeof(uint32_t);
-      bind.is_null_value = 0;
-    } else {
-      bind.is_null_value = 1;
     }
-  } else {
-    bind.is_null_value = 1;
-  }
-  
-  bind.is_null = &bind.is_null_value;
-}
 
-void Serializer::serializeInt64(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  OATPP_LOGD("Serializer", "Serializing Int64 value for paramIndex=%d", paramIndex);
-  
-  if (!stmt) {
-    OATPP_LOGE("Serializer", "Error: MySQL statement is null");
-    throw std::runtime_error("MySQL statement is null");
+    // Use BLOB type for binary data, STRING for text. The bind points into the retained string - no copy
+    bind.buffer_type = isBinary ? MYSQL_TYPE_BLOB : MYSQL_TYPE_STRING;
+    bind.buffer = const_cast<char*>(cstr);
+    bind.buffer_length = len;
+    bind.length_value = len;
+    bind.is_null_value = 0;
+    context.retain(paramIndex, polymorph);
   }
-  
-  if(paramIndex >= _this->m_bindParams.size()) {
-    OATPP_LOGD("Serializer", "Resizing bind params array from %d to %d", _this->m_bindParams.size(), paramIndex + 1);
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_LONGLONG;
-  bind.is_unsigned = 0;  // Signed integer
-  bind.length_value = sizeof(int64_t);
-  bind.length = &bind.length_value;
-  bind.buffer_length = sizeof(int64_t);
-  
-  // Allocate buffer regardless of value to maintain consistent memory layout
-  bind.buffer = malloc(sizeof(int64_t));
-  if(!bind.buffer) {
-    OATPP_LOGE("Serializer", "Failed to allocate memory for Int64 value");
-    throw std::runtime_error("Failed to allocate memory for Int64 value");
-  }
-  
-  // Initialize buffer to 0
-  std::memset(bind.buffer, 0, sizeof(int64_t));
-  
-  if(polymorph) {
-    auto value = polymorph.cast<oatpp::Int64>();
-    if(value) {
-      *static_cast<int64_t*>(bind.buffer) = static_cast<int64_t>(value);
-      bind.is_null_value = 0;
-      OATPP_LOGD("Serializer", "Int64 value set: %lld", *static_cast<int64_t*>(bind.buffer));
-    } else {
-      bind.is_null_value = 1;
-      OATPP_LOGD("Serializer", "Int64 value is null");
-    }
-  } else {
-    bind.is_null_value = 1;
-    OATPP_LOGD("Serializer", "Int64 value is null (polymorph is null)");
-  }
-  
-  bind.is_null = &bind.is_null_value;
-  OATPP_LOGD("Serializer", "Int64 binding completed for paramIndex=%d, is_null=%d", paramIndex, bind.is_null_value);
-}
-
-void Serializer::serializeUInt64(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  OATPP_LOGD("Serializer", "Serializing UInt64 value for paramIndex=%d", paramIndex);
-  
-  if (!stmt) {
-    OATPP_LOGE("Serializer", "Error: MySQL statement is null");
-    throw std::runtime_error("MySQL statement is null");
-  }
-  
-  if(paramIndex >= _this->m_bindParams.size()) {
-    OATPP_LOGD("Serializer", "Resizing bind params array from %d to %d", _this->m_bindParams.size(), paramIndex + 1);
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_LONGLONG;
-  bind.is_unsigned = 1;  // Unsigned integer
-  bind.length_value = sizeof(uint64_t);
-  bind.length = &bind.length_value;
-  bind.buffer_length = sizeof(uint64_t);
-  
-  // Allocate buffer regardless of value to maintain consistent memory layout
-  bind.buffer = malloc(sizeof(uint64_t));
-  if(!bind.buffer) {
-    OATPP_LOGE("Serializer", "Failed to allocate memory for UInt64 value");
-    throw std::runtime_error("Failed to allocate memory for UInt64 value");
-  }
-  
-  // Initialize buffer to 0
-  std::memset(bind.buffer, 0, sizeof(uint64_t));
-  
-  if(polymorph) {
-    auto value = polymorph.cast<oatpp::UInt64>();
-    if(value) {
-      *static_cast<uint64_t*>(bind.buffer) = static_cast<uint64_t>(value);
-      bind.is_null_value = 0;
-      OATPP_LOGD("Serializer", "UInt64 value set: %llu", *static_cast<uint64_t*>(bind.buffer));
-    } else {
-      bind.is_null_value = 1;
-      OATPP_LOGD("Serializer", "UInt64 value is null");
-    }
-  } else {
-    bind.is_null_value = 1;
-    OATPP_LOGD("Serializer", "UInt64 value is null (polymorph is null)");
-  }
-  
-  bind.is_null = &bind.is_null_value;
-  OATPP_LOGD("Serializer", "UInt64 binding completed for paramIndex=%d, is_null=%d", paramIndex, bind.is_null_value);
-}
-
-void Serializer::serializeFloat32(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  if(paramIndex >= _this->m_bindParams.size()) {
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_FLOAT;
-  
-  if(polymorph) {
-    auto value = polymorph.cast<oatpp::Float32>();
-    if(value) {
-      bind.buffer = malloc(sizeof(float));
-      if(!bind.buffer) {
-        throw std::runtime_error("Failed to allocate memory for Float32 value");
-      }
-      *static_cast<float*>(bind.buffer) = value;
-      bind.buffer_length = sizeof(float);
-      bind.is_null_value = 0;
-    } else {
-      bind.is_null_value = 1;
-    }
-  } else {
-    bind.is_null_value = 1;
-  }
-  
-  bind.is_null = &bind.is_null_value;
 }
 
-void Serializer::serializeFloat64(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  OATPP_LOGD("Serializer", "Serializing Float64 value for paramIndex=%d", paramIndex);
-  
-  if (!stmt) {
-    OATPP_LOGE("Serializer", "Error: MySQL statement is null");
-    throw std::runtime_error("MySQL statement is null");
-  }
-  
-  if(paramIndex >= _this->m_bindParams.size()) {
-    OATPP_LOGD("Serializer", "Resizing bind params array from %d to %d", _this->m_bindParams.size(), paramIndex + 1);
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_DOUBLE;
-  bind.is_unsigned = 0;  // Not applicable for doubles, but set for consistency
-  bind.length_value = sizeof(double);
-  bind.length = &bind.length_value;
-  bind.buffer_length = sizeof(double);
-  
-  // Allocate buffer regardless of value to maintain consistent memory layout
-  bind.buffer = malloc(sizeof(double));
-  if(!bind.buffer) {
-    OATPP_LOGE("Serializer", "Failed to allocate memory for Float64 value");
-    throw std::runtime_error("Failed to allocate memory for Float64 value");
-  }
-  
-  // Initialize buffer to 0
-  std::memset(bind.buffer, 0, sizeof(double));
-  
+void Serializer::serializeBoolean(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph) {
+  (void) _this;
+  auto& bind = initBind(context, paramIndex, MYSQL_TYPE_TINY, false);
   if(polymorph) {
-    auto value = polymorph.cast<oatpp::Float64>();
-    if(value) {
-      *static_cast<double*>(bind.buffer) = static_cast<double>(*value);
-      bind.is_null_value = 0;
-      OATPP_LOGD("Serializer", "Float64 value set: %f", *static_cast<double*>(bind.buffer));
-    } else {
-      bind.is_null_value = 1;
-      OATPP_LOGD("Serializer", "Float64 value is null");
-    }
-  } else {
-    bind.is_null_value = 1;
-    OATPP_LOGD("Serializer", "Float64 value is null (polymorph is null)");
+    auto buffer = static_cast<signed char*>(context.allocate(sizeof(signed char)));
+    *buffer = polymorph.cast<oatpp::Boolean>().getValue(false) ? 1 : 0;
+    bind.buffer = buffer;
+    bind.buffer_length = sizeof(signed char);
+    bind.length_value = sizeof(signed char);
+    bind.is_null_value = 0;
   }
-  
-  bind.is_null = &bind.is_null_value;
-  OATPP_LOGD("Serializer", "Float64 binding completed for paramIndex=%d, is_null=%d", paramIndex, bind.is_null_value);
 }
 
-void Serializer::serializeEnum(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) {
-  if(paramIndex >= _this->m_bindParams.size()) {
-    _this->m_bindParams.resize(paramIndex + 1);
-  }
-  
-  auto& bind = _this->m_bindParams[paramIndex];
-  std::memset(&bind, 0, sizeof(MYSQL_BIND));
-  bind.buffer_type = MYSQL_TYPE_STRING;
-  
+void Serializer::serializeEnum(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph) {
+  (void) _this;
+  auto& bind = initBind(context, paramIndex, MYSQL_TYPE_STRING, false);
   if(polymorph) {
     auto polymorphicDispatcher = static_cast<const data::mapping::type::__class::AbstractEnum::PolymorphicDispatcher*>(
       polymorph.getValueType()->polymorphicDispatcher
@@ -724,29 +287,26 @@ void Serializer::serializeEnum(const Serializer* _this, MYSQL_STMT* stmt, v_uint
     if(e == data::mapping::type::EnumInterpreterError::OK) {
       auto str = interpretation.cast<oatpp::String>();
       if(str) {
-        const char* cstr = str->c_str();
-        std::size_t len = str->length();
-        
-        bind.buffer = malloc(len + 1);
-        if (!bind.buffer) {
-          throw std::runtime_error("Failed to allocate memory for enum value");
-        }
-        std::memcpy(bind.buffer, cstr, len + 1);
-        bind.buffer_length = len;
+        bind.buffer = const_cast<char*>(str->data());
+        bind.buffer_length = str->size();
+        bind.length_value = str->size();
         bind.is_null_value = 0;
-        bind.length_value = len;
-      } else {
-        bind.is_null_value = 1;
+        context.retain(paramIndex, str);
       }
-    } else {
-      bind.is_null_value = 1;
     }
-  } else {
-    bind.is_null_value = 1;
   }
-  
-  bind.is_null = &bind.is_null_value;
-  bind.length = &bind.length_value;
+}
+
+void Serializer::serializeLongData(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph) {
+  (void) _this;
+  auto& bind = initBind(context, paramIndex, MYSQL_TYPE_LONG_BLOB, false);
+  if(polymorph) {
+    // no buffer - the value is sent in chunks by BindContext::bind()
+    auto longData = polymorph.cast<types::LongData>();
+    bind.buffer_type = longData->isBinary() ? MYSQL_TYPE_LONG_BLOB : MYSQL_TYPE_STRING;
+    bind.is_null_value = 0;
+    context.addLongData(paramIndex, polymorph);
+  }
 }
 
 }}}
@@ -5,65 +5,159 @@
 #include "oatpp/core/Types.hpp"
 #include <mysql/mysql.h>
 
+#include <cstddef>
+#include <memory>
+#include <vector>
+
 namespace oatpp { namespace mariadb { namespace mapping {
 
 /**
- * Mapper of oatpp values to mariadb values.
+ * Mapper of oatpp values to mariadb values. <br>
+ * Stateless after setup - parameters of each execution are serialized into their own
+ * &l:Serializer::BindContext;, so one serializer can be used by many threads.
  */
 class Serializer {
 public:
-  typedef void (*SerializerMethod)(const Serializer*, MYSQL_STMT*, v_uint32, const oatpp::Void&);
+
+  /**
+   * Parameter binds of one statement execution. <br>
+   * Owns the `MYSQL_BIND` array and everything it points to until the statement has been executed.
+   * Memory comes from a bump arena - an inline block holds the bind array and scalar values of typical queries,
+   * larger requests get one extra heap block each. Null flags and lengths use the fields of `MYSQL_BIND` itself.
+   * String values are not copied - the bind points into the string, which is retained by the context.
+   * Not thread-safe - one context per execution.
+   */
+  class BindContext {
+  public:
+
+    /**
+     * Size of the inline arena block.
+     */
+    static constexpr v_buff_size INLINE_SIZE = 2048;
+
+  private:
+    alignas(std::max_align_t) char m_inline[INLINE_SIZE];
+    char* m_block;
+    v_buff_size m_blockSize;
+    v_buff_size m_blockPosition;
+    std::vector<std::unique_ptr<char[]>> m_heapBlocks;
+    MYSQL_BIND* m_binds;
+    oatpp::Void* m_values;
+    v_uint32 m_paramCount;
+    std::vector<v_uint32> m_longDataParams;
+  public:
+
+    /**
+     * Constructor. All parameters are bound as `NULL` until serialized.
+     * @param paramCount - number of statement parameters.
+     */
+    explicit BindContext(v_uint32 paramCount);
+
+    /**
+     * Destructor. Releases the retained values and all arena blocks.
+     */
+    ~BindContext();
+
+    BindContext(const BindContext&) = delete;
+    BindContext& operator=(const BindContext&) = delete;
+
+    /**
+     * Allocate memory from the arena. Aligned to `std::max_align_t`. Released with the context.
+     * @param size - number of bytes.
+     * @return - pointer to the memory.
+     */
+    void* allocate(v_buff_size size);
+
+    /**
+     * Get bind of the parameter. Binds are initialized as `NULL` values of type `MYSQL_TYPE_NULL`.
+     * @param paramIndex - index of the parameter.
+     * @return - `MYSQL_BIND`.
+     */
+    MYSQL_BIND& getBind(v_uint32 paramIndex);
+
+    /**
+     * Keep value alive until the context is destroyed. The bind of the parameter may point into it.
+     * @param paramIndex - index of the parameter.
+     * @param value - value.
+     */
+    void retain(v_uint32 paramIndex, const oatpp::Void& value);
+
+    /**
+     * Retain a &id:oatpp::mariadb::types::LongData; value and send it with `mysql_stmt_send_long_data`
+     * right after the parameters are bound.
+     * @param paramIndex - index of the parameter.
+     * @param value - &id:oatpp::mariadb::types::LongData;.
+     */
+    void addLongData(v_uint32 paramIndex, const oatpp::Void& value);
+
+    /**
+     * Check if any parameter is sent with `mysql_stmt_send_long_data`.
+     * @return
+     */
+    bool hasLongData() const;
+
+    /**
+     * Get number of statement parameters.
+     * @return
+     */
+    v_uint32 getParamCount() const;
+
+    /**
+     * Get number of heap blocks allocated because the inline block was too small.
+     * @return
+     */
+    v_uint32 getHeapBlockCount() const;
+
+    /**
+     * Bind all parameters to the statement (`mysql_stmt_bind_param`) and send long data values.
+     * Throws `std::runtime_error` on error.
+     * @param stmt - prepared statement.
+     */
+    void bind(MYSQL_STMT* stmt);
+
+  };
+
+public:
+  typedef void (*SerializerMethod)(const Serializer*, BindContext&, v_uint32, const oatpp::Void&);
 private:
   std::vector<SerializerMethod> m_methods;
-  mutable std::vector<MYSQL_BIND> m_bindParams;
 public:
 
   Serializer();
 
-  ~Serializer();
-
   void setSerializerMethod(const data::mapping::type::ClassId& classId, SerializerMethod method);
 
-  void serialize(MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph) const;
-
-  std::vector<MYSQL_BIND>& getBindParams() const;
+  /**
+   * Serialize value of one parameter into the bind context.
+   * @param context - &l:Serializer::BindContext;.
+   * @param paramIndex - index of the parameter.
+   * @param polymorph - value.
+   */
+  void serialize(BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph) const;
 
   /**
-   * Bind all parameters to the MySQL statement.
-   * This should be called after all parameters have been serialized.
-   * @param stmt - MySQL statement to bind parameters to
+   * Reset the parameter's bind and prepare it for a value of the given type. For custom serializer methods.
+   * The bind stays `NULL` until `is_null_value` is cleared.
+   * @param context - &l:Serializer::BindContext;.
+   * @param paramIndex - index of the parameter.
+   * @param bufferType - MariaDB buffer type.
+   * @param isUnsigned - unsigned flag of integer types.
+   * @return - `MYSQL_BIND` with `is_null` and `length` pointing to its own `is_null_value` and `length_value`.
    */
-  void bindParameters(MYSQL_STMT* stmt) const;
+  static MYSQL_BIND& initBind(BindContext& context, v_uint32 paramIndex, enum_field_types bufferType, bool isUnsigned);
 
 private:
 
-  void setBindParam(MYSQL_BIND& bind, v_uint32 paramIndex) const;
-
-  static void serializeString(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
-
-  static void serializeBoolean(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
-
-  static void serializeInt8(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
-
-  static void serializeUInt8(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
-
-  static void serializeInt16(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
-
-  static void serializeUInt16(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
-
-  static void serializeInt32(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
-
-  static void serializeUInt32(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
-
-  static void serializeInt64(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
+  template<class Wrapper, typename T, enum_field_types TYPE, bool UNSIGNED>
+  static void serializeFixed(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph);
 
-  static void serializeUInt64(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
+  static void serializeString(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph);
 
-  static void serializeFloat32(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
+  static void serializeBoolean(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph);
 
-  static void serializeFloat64(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
+  static void serializeEnum(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph);
 
-  static void serializeEnum(const Serializer* _this, MYSQL_STMT* stmt, v_uint32 paramIndex, const oatpp::Void& polymorph);
+  static void serializeLongData(const Serializer* _this, BindContext& context, v_uint32 paramIndex, const oatpp::Void& polymorph);
 
 };
 
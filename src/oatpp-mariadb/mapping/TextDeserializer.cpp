@@ -0,0 +1,238 @@
+#include "TextDeserializer.hpp"
+
+#include <cstdlib>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+TextDeserializer::InData::InData(const char* pData,
+                                 unsigned long pSize,
+                                 const MYSQL_FIELD* pField,
+                                 const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver)
+  : data(pData)
+  , size(pSize)
+  , field(pField)
+  , typeResolver(pTypeResolver)
+  , isNull(pData == nullptr)
+{}
+
+TextDeserializer::TextDeserializer() {
+
+  m_methods.resize(data::mapping::type::ClassId::getClassCount(), nullptr);
+
+  setDeserializerMethod(data::mapping::type::__class::String::CLASS_ID, &TextDeserializer::deserializeString);
+  setDeserializerMethod(data::mapping::type::__class::Any::CLASS_ID, &TextDeserializer::deserializeAny);
+  setDeserializerMethod(data::mapping::type::__class::Boolean::CLASS_ID, &TextDeserializer::deserializeBoolean);
+
+  setDeserializerMethod(data::mapping::type::__class::Int8::CLASS_ID, &TextDeserializer::deserializeInt<oatpp::Int8>);
+  setDeserializerMethod(data::mapping::type::__class::UInt8::CLASS_ID, &TextDeserializer::deserializeUInt<oatpp::UInt8>);
+
+  setDeserializerMethod(data::mapping::type::__class::Int16::CLASS_ID, &TextDeserializer::deserializeInt<oatpp::Int16>);
+  setDeserializerMethod(data::mapping::type::__class::UInt16::CLASS_ID, &TextDeserializer::deserializeUInt<oatpp::UInt16>);
+
+  setDeserializerMethod(data::mapping::type::__class::Int32::CLASS_ID, &TextDeserializer::deserializeInt<oatpp::Int32>);
+  setDeserializerMethod(data::mapping::type::__class::UInt32::CLASS_ID, &TextDeserializer::deserializeUInt<oatpp::UInt32>);
+
+  setDeserializerMethod(data::mapping::type::__class::Int64::CLASS_ID, &TextDeserializer::deserializeInt<oatpp::Int64>);
+  setDeserializerMethod(data::mapping::type::__class::UInt64::CLASS_ID, &TextDeserializer::deserializeUInt<oatpp::UInt64>);
+
+  setDeserializerMethod(data::mapping::type::__class::Float32::CLASS_ID, &TextDeserializer::deserializeFloat32);
+  setDeserializerMethod(data::mapping::type::__class::Float64::CLASS_ID, &TextDeserializer::deserializeFloat64);
+
+  setDeserializerMethod(data::mapping::type::__class::AbstractEnum::CLASS_ID, &TextDeserializer::deserializeEnum);
+
+}
+
+void TextDeserializer::setDeserializerMethod(const data::mapping::type::ClassId& classId, DeserializerMethod method) {
+  const v_uint32 id = classId.id;
+  if(id >= m_methods.size()) {
+    m_methods.resize(id + 1, nullptr);
+  }
+  m_methods[id] = method;
+}
+
+oatpp::Void TextDeserializer::deserialize(const InData& data, const Type* type) const {
+
+  auto id = type->classId.id;
+  auto method = id < m_methods.size() ? m_methods[id] : nullptr;
+
+  if(method) {
+    return (*method)(this, data, type);
+  }
+
+  auto* interpretation = type->findInterpretation(data.typeResolver->getEnabledInterpretations());
+  if(interpretation) {
+    return interpretation->fromInterpretation(deserialize(data, interpretation->getInterpretationType()));
+  }
+
+  throw std::runtime_error("[oatpp::mariadb::mapping::TextDeserializer::deserialize()]: "
+                           "Error. No deserialize method for type '" + std::string(type->classId.name) + "'");
+
+}
+
+// Text protocol sends BIT columns as raw big-endian bytes, everything else numeric as decimal text.
+// Values of rows read with mysql_fetch_row are always zero-terminated.
+v_int64 TextDeserializer::deInt(const InData& data) {
+  if(data.field->type == MYSQL_TYPE_BIT) {
+    return static_cast<v_int64>(deUInt(data));
+  }
+  return std::strtoll(data.data, nullptr, 10);
+}
+
+v_uint64 TextDeserializer::deUInt(const InData& data) {
+  if(data.field->type == MYSQL_TYPE_BIT) {
+    v_uint64 value = 0;
+    for(unsigned long i = 0; i < data.size; i++) {
+      value = (value << 8) | static_cast<v_uint8>(data.data[i]);
+    }
+    return value;
+  }
+  return std::strtoull(data.data, nullptr, 10);
+}
+
+v_float64 TextDeserializer::deFloat(const InData& data) {
+  if(data.field->type == MYSQL_TYPE_BIT) {
+    return static_cast<v_float64>(deUInt(data));
+  }
+  return std::strtod(data.data, nullptr);
+}
+
+oatpp::Void TextDeserializer::deserializeString(const TextDeserializer* _this, const InData& data, const Type* type) {
+  (void) _this;
+  (void) type;
+
+  if(data.isNull) {
+    return oatpp::String();
+  }
+
+  return oatpp::String(data.data, data.size);
+}
+
+template<class IntWrapper>
+oatpp::Void TextDeserializer::deserializeInt(const TextDeserializer* _this, const InData& data, const Type* type) {
+  (void) _this;
+  (void) type;
+
+  if(data.isNull) {
+    return IntWrapper();
+  }
+
+  return IntWrapper(static_cast<typename IntWrapper::UnderlyingType>(deInt(data)));
+}
+
+template<class IntWrapper>
+oatpp::Void TextDeserializer::deserializeUInt(const TextDeserializer* _this, const InData& data, const Type* type) {
+  (void) _this;
+  (void) type;
+
+  if(data.isNull) {
+    return IntWrapper();
+  }
+
+  return IntWrapper(static_cast<typename IntWrapper::UnderlyingType>(deUInt(data)));
+}
+
+oatpp::Void TextDeserializer::deserializeFloat32(const TextDeserializer* _this, const InData& data, const Type* type) {
+  (void) _this;
+  (void) type;
+
+  if(data.isNull) {
+    return oatpp::Float32();
+  }
+
+  return oatpp::Float32(static_cast<v_float32>(deFloat(data)));
+}
+
+oatpp::Void TextDeserializer::deserializeFloat64(const TextDeserializer* _this, const InData& data, const Type* type) {
+  (void) _this;
+  (void) type;
+
+  if(data.isNull) {
+    return oatpp::Float64();
+  }
+
+  return oatpp::Float64(deFloat(data));
+}
+
+oatpp::Void TextDeserializer::deserializeBoolean(const TextDeserializer* _this, const InData& data, const Type* type) {
+  (void) _this;
+  (void) type;
+
+  if(data.isNull) {
+    return oatpp::Boolean();
+  }
+
+  return oatpp::Boolean(deUInt(data) != 0);
+}
+
+oatpp::Void TextDeserializer::deserializeAny(const TextDeserializer* _this, const InData& data, const Type* type) {
+
+  (void) type;
+
+  if(data.isNull) {
+    return oatpp::Void(Any::Class::getType());
+  }
+
+  bool isUnsigned = (data.field->flags & UNSIGNED_FLAG) != 0;
+  const Type* valueType;
+
+  switch(data.field->type) {
+    case MYSQL_TYPE_TINY:
+      valueType = isUnsigned ? oatpp::UInt8::Class::getType() : oatpp::Int8::Class::getType();
+      break;
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_YEAR:
+      valueType = isUnsigned ? oatpp::UInt16::Class::getType() : oatpp::Int16::Class::getType();
+      break;
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+      valueType = isUnsigned ? oatpp::UInt32::Class::getType() : oatpp::Int32::Class::getType();
+      break;
+    case MYSQL_TYPE_LONGLONG:
+      valueType = isUnsigned ? oatpp::UInt64::Class::getType() : oatpp::Int64::Class::getType();
+      break;
+    case MYSQL_TYPE_BIT:
+      valueType = oatpp::UInt64::Class::getType();
+      break;
+    case MYSQL_TYPE_FLOAT:
+      valueType = oatpp::Float32::Class::getType();
+      break;
+    case MYSQL_TYPE_DOUBLE:
+      valueType = oatpp::Float64::Class::getType();
+      break;
+    default:
+      // DECIMAL, dates, times, strings, blobs, JSON - keep the text representation
+      valueType = oatpp::String::Class::getType();
+  }
+
+  auto value = _this->deserialize(data, valueType);
+  auto anyHandle = std::make_shared<data::mapping::type::AnyHandle>(value.getPtr(), value.getValueType());
+  return oatpp::Void(anyHandle, Any::Class::getType());
+
+}
+
+oatpp::Void TextDeserializer::deserializeEnum(const TextDeserializer* _this, const InData& data, const Type* type) {
+
+  auto polymorphicDispatcher = static_cast<const data::mapping::type::__class::AbstractEnum::PolymorphicDispatcher*>(
+    type->polymorphicDispatcher
+  );
+
+  data::mapping::type::EnumInterpreterError e = data::mapping::type::EnumInterpreterError::OK;
+  const auto& value = _this->deserialize(data, polymorphicDispatcher->getInterpretationType());
+
+  const auto& result = polymorphicDispatcher->fromInterpretation(value, e);
+
+  if(e == data::mapping::type::EnumInterpreterError::OK) {
+    return result;
+  }
+
+  switch(e) {
+    case data::mapping::type::EnumInterpreterError::CONSTRAINT_NOT_NULL:
+      throw std::runtime_error("[oatpp::mariadb::mapping::TextDeserializer::deserializeEnum()]: Error. Enum constraint violated - 'NotNull'.");
+
+    default:
+      throw std::runtime_error("[oatpp::mariadb::mapping::TextDeserializer::deserializeEnum()]: Error. Can't deserialize Enum.");
+  }
+
+}
+
+}}}
@@ -0,0 +1,78 @@
+#ifndef oatpp_mariadb_mapping_TextDeserializer_hpp
+#define oatpp_mariadb_mapping_TextDeserializer_hpp
+
+#include "oatpp/core/data/mapping/TypeResolver.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+/**
+ * Mapper from mariadb text protocol values to oatpp values. <br>
+ * Text protocol counterpart of &id:oatpp::mariadb::mapping::Deserializer;.
+ */
+class TextDeserializer {
+public:
+  typedef oatpp::data::mapping::type::Type Type;
+public:
+
+  // Data structure to hold one column of a text row
+  struct InData {
+
+    InData(const char* pData,
+           unsigned long pSize,
+           const MYSQL_FIELD* pField,
+           const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver);
+
+    const char* data;
+    unsigned long size;
+    const MYSQL_FIELD* field;
+
+    std::shared_ptr<const data::mapping::TypeResolver> typeResolver;
+
+    bool isNull;
+
+  };
+
+public:
+  typedef oatpp::Void (*DeserializerMethod)(const TextDeserializer*, const InData&, const Type*);
+private:
+  static v_int64 deInt(const InData& data);
+  static v_uint64 deUInt(const InData& data);
+  static v_float64 deFloat(const InData& data);
+private:
+  std::vector<DeserializerMethod> m_methods;
+public:
+
+  TextDeserializer();
+
+  void setDeserializerMethod(const data::mapping::type::ClassId& classId, DeserializerMethod method);
+
+  oatpp::Void deserialize(const InData& data, const Type* type) const;
+
+private:
+
+  static oatpp::Void deserializeString(const TextDeserializer* _this, const InData& data, const Type* type);
+
+  template<class IntWrapper>
+  static oatpp::Void deserializeInt(const TextDeserializer* _this, const InData& data, const Type* type);
+
+  template<class IntWrapper>
+  static oatpp::Void deserializeUInt(const TextDeserializer* _this, const InData& data, const Type* type);
+
+  static oatpp::Void deserializeFloat32(const TextDeserializer* _this, const InData& data, const Type* type);
+
+  static oatpp::Void deserializeFloat64(const TextDeserializer* _this, const InData& data, const Type* type);
+
+  static oatpp::Void deserializeBoolean(const TextDeserializer* _this, const InData& data, const Type* type);
+
+  static oatpp::Void deserializeAny(const TextDeserializer* _this, const InData& data, const Type* type);
+
+  static oatpp::Void deserializeEnum(const TextDeserializer* _this, const InData& data, const Type* type);
+
+};
+
+}}}
+
+#endif // oatpp_mariadb_mapping_TextDeserializer_hpp
@@ -0,0 +1,237 @@
+#include "TextResultMapper.hpp"
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+TextResultMapper::ResultData::ResultData(MYSQL_RES* pResult, const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver)
+  : result(pResult)
+  , typeResolver(pTypeResolver)
+  , fields(nullptr)
+  , colCount(0)
+  , row(nullptr)
+  , lengths(nullptr)
+  , rowIndex(0)
+  , hasMore(false)
+{
+  if (!result) {
+    return;
+  }
+
+  colCount = mysql_num_fields(result);
+  fields = mysql_fetch_fields(result);
+  colNames.reserve(colCount);
+  for (v_int64 i = 0; i < colCount; i++) {
+    colNames.emplace_back(fields[i].name, fields[i].name_length);
+  }
+
+  row = mysql_fetch_row(result);
+  if (row) {
+    lengths = mysql_fetch_lengths(result);
+    hasMore = true;
+  }
+}
+
+TextResultMapper::ResultData::~ResultData() {
+  if (result) {
+    mysql_free_result(result);
+    result = nullptr;
+  }
+}
+
+void TextResultMapper::ResultData::next() {
+  if (!result || !hasMore) {
+    hasMore = false;
+    return;
+  }
+  rowIndex++;
+  row = mysql_fetch_row(result);
+  if (row) {
+    lengths = mysql_fetch_lengths(result);
+  } else {
+    hasMore = false;
+  }
+}
+
+TextDeserializer::InData TextResultMapper::ResultData::getInData(v_int64 col) const {
+  return TextDeserializer::InData(row[col], lengths[col], &fields[col], typeResolver);
+}
+
+TextResultMapper::TextResultMapper() {
+
+  {
+    m_readOneRowMethods.resize(data::mapping::type::ClassId::getClassCount(), nullptr);
+
+    // object
+    setReadOneRowMethod(data::mapping::type::__class::AbstractObject::CLASS_ID, &TextResultMapper::readOneRowAsObject);
+
+    // collection
+    setReadOneRowMethod(data::mapping::type::__class::AbstractVector::CLASS_ID, &TextResultMapper::readOneRowAsCollection);
+    setReadOneRowMethod(data::mapping::type::__class::AbstractList::CLASS_ID, &TextResultMapper::readOneRowAsCollection);
+    setReadOneRowMethod(data::mapping::type::__class::AbstractUnorderedSet::CLASS_ID,
+                        &TextResultMapper::readOneRowAsCollection);
+
+    // map
+    setReadOneRowMethod(data::mapping::type::__class::AbstractPairList::CLASS_ID, &TextResultMapper::readOneRowAsMap);
+    setReadOneRowMethod(data::mapping::type::__class::AbstractUnorderedMap::CLASS_ID, &TextResultMapper::readOneRowAsMap);
+  }
+
+  {
+    m_readRowsMethods.resize(data::mapping::type::ClassId::getClassCount(), nullptr);
+
+    // collection
+    setReadRowsMethod(data::mapping::type::__class::AbstractVector::CLASS_ID, &TextResultMapper::readRowsAsCollection);
+    setReadRowsMethod(data::mapping::type::__class::AbstractList::CLASS_ID, &TextResultMapper::readRowsAsCollection);
+    setReadRowsMethod(data::mapping::type::__class::AbstractUnorderedSet::CLASS_ID, &TextResultMapper::readRowsAsCollection);
+
+    // object
+    setReadRowsMethod(data::mapping::type::__class::AbstractObject::CLASS_ID, &TextResultMapper::readRowsAsObject);
+  }
+
+}
+
+void TextResultMapper::setReadOneRowMethod(const data::mapping::type::ClassId& classId, ReadOneRowMethod method) {
+  const v_uint32 id = classId.id;
+  if(id >= m_readOneRowMethods.size()) {
+    m_readOneRowMethods.resize(id + 1, nullptr);
+  }
+  m_readOneRowMethods[id] = method;
+}
+
+void TextResultMapper::setReadRowsMethod(const data::mapping::type::ClassId& classId, ReadRowsMethod method) {
+  const v_uint32 id = classId.id;
+  if(id >= m_readRowsMethods.size()) {
+    m_readRowsMethods.resize(id + 1, nullptr);
+  }
+  m_readRowsMethods[id] = method;
+}
+
+oatpp::Void TextResultMapper::readOneRowAsCollection(TextResultMapper* _this, ResultData* dbData, const Type* type) {
+
+  auto dispatcher = static_cast<const data::mapping::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto collection = dispatcher->createObject();
+
+  const Type* itemType = dispatcher->getItemType();
+
+  for(v_int64 i = 0; i < dbData->colCount; i ++) {
+    dispatcher->addItem(collection, _this->m_deserializer.deserialize(dbData->getInData(i), itemType));
+  }
+
+  return collection;
+
+}
+
+oatpp::Void TextResultMapper::readOneRowAsMap(TextResultMapper* _this, ResultData* dbData, const Type* type) {
+
+  auto dispatcher = static_cast<const data::mapping::type::__class::Map::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto map = dispatcher->createObject();
+
+  const Type* keyType = dispatcher->getKeyType();
+  if(keyType->classId.id != oatpp::data::mapping::type::__class::String::CLASS_ID.id){
+    throw std::runtime_error("[oatpp::mariadb::mapping::TextResultMapper::readOneRowAsMap()]: Invalid map key. Key should be String");
+  }
+
+  const Type* valueType = dispatcher->getValueType();
+  for(v_int64 i = 0; i < dbData->colCount; i ++) {
+    dispatcher->addItem(map, dbData->colNames[i], _this->m_deserializer.deserialize(dbData->getInData(i), valueType));
+  }
+
+  return map;
+
+}
+
+oatpp::Void TextResultMapper::readOneRowAsObject(TextResultMapper* _this, ResultData* dbData, const Type* type) {
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto object = dispatcher->createObject();
+  const auto& fieldsMap = dispatcher->getProperties()->getMap();
+
+  for(v_int64 i = 0; i < dbData->colCount; i ++) {
+    auto it = fieldsMap.find(*dbData->colNames[i]);
+    if(it != fieldsMap.end()) {
+      auto property = it->second;
+      property->set(static_cast<oatpp::BaseObject*>(object.get()),
+                    _this->m_deserializer.deserialize(dbData->getInData(i), property->type));
+    }
+  }
+
+  return object;
+
+}
+
+oatpp::Void TextResultMapper::readRowsAsCollection(TextResultMapper* _this, ResultData* dbData, const Type* type, v_int64 count) {
+
+  auto dispatcher = static_cast<const oatpp::data::mapping::type::__class::Collection::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  oatpp::Void collection = dispatcher->createObject();
+
+  const Type* itemType = dispatcher->getItemType();
+
+  v_int64 itemsLeft = count;
+  while(dbData->hasMore && (count < 0 || itemsLeft > 0)) {
+    dispatcher->addItem(collection, _this->readOneRow(dbData, itemType));
+    --itemsLeft;
+  }
+
+  return collection;
+
+}
+
+oatpp::Void TextResultMapper::readRowsAsObject(TextResultMapper* _this, ResultData* dbData, const Type* type, v_int64 count) {
+
+  if (count > 1) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::TextResultMapper::readRowsAsObject()]: "
+                             "Error. Cannot read multiple rows into a single object.");
+  }
+
+  if (!dbData->hasMore) {
+    return nullptr;
+  }
+
+  return _this->readOneRow(dbData, type);
+
+}
+
+oatpp::Void TextResultMapper::readRow(ResultData* dbData, const Type* type) {
+
+  auto id = type->classId.id;
+  auto method = id < m_readOneRowMethods.size() ? m_readOneRowMethods[id] : nullptr;
+
+  if(method) {
+    return (*method)(this, dbData, type);
+  }
+
+  // if no method found - try to find interpretation
+  auto* interpretation = type->findInterpretation(dbData->typeResolver->getEnabledInterpretations());
+  if(interpretation) {
+    return interpretation->fromInterpretation(readRow(dbData, interpretation->getInterpretationType()));
+  }
+
+  throw std::runtime_error("[oatpp::mariadb::mapping::TextResultMapper::readRow]: Error. "
+                           "No deserializer found for type '" + std::string(type->classId.name) + "'");
+
+}
+
+oatpp::Void TextResultMapper::readOneRow(ResultData* dbData, const Type* type) {
+
+  if (!dbData->hasMore) {
+    return nullptr;
+  }
+
+  auto result = readRow(dbData, type);
+  dbData->next();
+  return result;
+
+}
+
+oatpp::Void TextResultMapper::readRows(ResultData* dbData, const Type* type, v_int64 count) {
+
+  auto id = type->classId.id;
+  if(id >= m_readRowsMethods.size() || !m_readRowsMethods[id]) {
+    throw std::runtime_error("[oatpp::mariadb::mapping::TextResultMapper::readRows]: "
+                             "Error. Invalid result container type. "
+                             "Allowed types are oatpp::Vector, oatpp::List, oatpp::UnorderedSet");
+  }
+
+  return m_readRowsMethods[id](this, dbData, type, count);
+
+}
+
+}}}
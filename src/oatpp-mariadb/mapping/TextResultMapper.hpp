@@ -0,0 +1,156 @@
+#ifndef oatpp_mariadb_mapping_TextResultMapper_hpp
+#define oatpp_mariadb_mapping_TextResultMapper_hpp
+
+#include "TextDeserializer.hpp"
+#include "oatpp/core/data/mapping/TypeResolver.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+namespace oatpp { namespace mariadb { namespace mapping {
+
+/**
+ * Mapper from mariadb text protocol result (`MYSQL_RES`) to oatpp objects. <br>
+ * Text protocol counterpart of &id:oatpp::mariadb::mapping::ResultMapper;.
+ */
+class TextResultMapper {
+public:
+
+  /**
+   * Result data. Get data row by row.
+   */
+  struct ResultData {
+
+    /**
+     * Constructor. Takes ownership of the result and reads the first row.
+     * @param pResult - result obtained from `mysql_store_result`.
+     * @param pTypeResolver
+     */
+    ResultData(MYSQL_RES* pResult, const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver);
+
+    /**
+     * Destructor. Frees the result.
+     */
+    ~ResultData();
+
+    ResultData(const ResultData&) = delete;
+    ResultData& operator=(const ResultData&) = delete;
+
+    /**
+     * mariadb result.
+     */
+    MYSQL_RES* result;
+
+    /**
+     * &id:oatpp::data::mapping::TypeResolver;.
+     */
+    std::shared_ptr<const data::mapping::TypeResolver> typeResolver;
+
+    /**
+     * Names of columns.
+     */
+    std::vector<oatpp::String> colNames;
+
+    /**
+     * Column metadata.
+     */
+    MYSQL_FIELD* fields;
+
+    /**
+     * Column count.
+     */
+    v_int64 colCount;
+
+    /**
+     * Current row.
+     */
+    MYSQL_ROW row;
+
+    /**
+     * Lengths of values of the current row.
+     */
+    unsigned long* lengths;
+
+    /**
+     * Current row index.
+     */
+    v_int64 rowIndex;
+
+    /**
+     * Has more to read.
+     */
+    bool hasMore;
+
+  public:
+
+    /**
+     * Move to next row.
+     */
+    void next();
+
+    /**
+     * Get value of the current row as &id:oatpp::mariadb::mapping::TextDeserializer::InData;.
+     * @param col - column index.
+     * @return
+     */
+    TextDeserializer::InData getInData(v_int64 col) const;
+
+  };
+
+private:
+  typedef oatpp::data::mapping::type::Type Type;
+  typedef oatpp::Void (*ReadOneRowMethod)(TextResultMapper*, ResultData*, const Type*);
+  typedef oatpp::Void (*ReadRowsMethod)(TextResultMapper*, ResultData*, const Type*, v_int64);
+private:
+
+  // Read one row methods
+  static oatpp::Void readOneRowAsCollection(TextResultMapper* _this, ResultData* dbData, const Type* type);
+  static oatpp::Void readOneRowAsMap(TextResultMapper* _this, ResultData* dbData, const Type* type);
+  static oatpp::Void readOneRowAsObject(TextResultMapper* _this, ResultData* dbData, const Type* type);
+
+  // Read rows methods
+  static oatpp::Void readRowsAsCollection(TextResultMapper* _this, ResultData* dbData, const Type* type, v_int64 count);
+  static oatpp::Void readRowsAsObject(TextResultMapper* _this, ResultData* dbData, const Type* type, v_int64 count);
+
+  // Read current row without moving to the next one
+  oatpp::Void readRow(ResultData* dbData, const Type* type);
+
+private:
+  TextDeserializer m_deserializer;
+  std::vector<ReadOneRowMethod> m_readOneRowMethods;
+  std::vector<ReadRowsMethod> m_readRowsMethods;
+public:
+
+  /**
+   * Default constructor.
+   */
+  TextResultMapper();
+
+  void setReadOneRowMethod(const data::mapping::type::ClassId& classId, ReadOneRowMethod method);
+
+  void setReadRowsMethod(const data::mapping::type::ClassId& classId, ReadRowsMethod method);
+
+  /**
+   * Read current row to oatpp object or collection and move to the next row. <br>
+   * Allowed output types are the same as for &id:oatpp::mariadb::mapping::ResultMapper::readOneRow;.
+   * @param dbData
+   * @param type
+   * @return
+   */
+  oatpp::Void readOneRow(ResultData* dbData, const Type* type);
+
+  /**
+   * Read `count` of rows to oatpp collection. `-1` reads all remaining rows. <br>
+   * Allowed output types are the same as for &id:oatpp::mariadb::mapping::ResultMapper::readRows;.
+   * @param dbData
+   * @param type
+   * @param count
+   * @return
+   */
+  oatpp::Void readRows(ResultData* dbData, const Type* type, v_int64 count);
+
+};
+
+}}}
+
+#endif // oatpp_mariadb_mapping_TextResultMapper_hpp
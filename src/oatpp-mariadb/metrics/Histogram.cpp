@@ -0,0 +1,123 @@
+#include "Histogram.hpp"
+
+#include <algorithm>
+
+namespace oatpp { namespace mariadb { namespace metrics {
+
+v_float64 Histogram::Snapshot::getMean() const {
+  if (count == 0) {
+    return 0;
+  }
+  return static_cast<v_float64>(sum) / static_cast<v_float64>(count);
+}
+
+v_uint64 Histogram::Snapshot::getPercentile(v_float64 fraction) const {
+  if (count == 0 || buckets.empty()) {
+    return 0;
+  }
+  fraction = std::max(0.0, std::min(fraction, 1.0));
+  v_uint64 rank = static_cast<v_uint64>(fraction * static_cast<v_float64>(count) + 0.5);
+  rank = std::max<v_uint64>(1, std::min(rank, count));
+  v_uint64 seen = 0;
+  for (v_int32 i = 0; i < static_cast<v_int32>(buckets.size()); i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      return std::min(getBucketUpperBound(i), max);
+    }
+  }
+  return max;
+}
+
+void Histogram::Snapshot::merge(const Snapshot& other) {
+  if (other.count == 0) {
+    return;
+  }
+  if (buckets.empty()) {
+    buckets.resize(BUCKET_COUNT, 0);
+  }
+  for (v_int32 i = 0; i < BUCKET_COUNT; i++) {
+    buckets[i] += other.buckets[i];
+  }
+  count += other.count;
+  sum += other.sum;
+  max = std::max(max, other.max);
+}
+
+Histogram::Histogram()
+  : m_count(0)
+  , m_sum(0)
+  , m_max(0)
+{
+  for (auto& bucket : m_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+}
+
+// e.g. 5 -> 5, 8..9 -> 8, 100 (0b1100100) -> exponent 6, sub-bucket 0b100 -> 36
+v_int32 Histogram::getBucketIndex(v_uint64 value) {
+  constexpr v_uint64 SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  constexpr v_uint64 MAX_VALUE = (v_uint64(1) << MAX_VALUE_BITS) - 1;
+  if (value < SUB_BUCKETS) {
+    return static_cast<v_int32>(value);
+  }
+  value = std::min(value, MAX_VALUE);
+  v_int32 exponent = SUB_BUCKET_BITS;
+  while ((value >> (exponent + 1)) != 0) {
+    exponent++;
+  }
+  v_int32 shift = exponent - SUB_BUCKET_BITS;
+  return ((shift + 1) << SUB_BUCKET_BITS) + static_cast<v_int32>((value >> shift) - SUB_BUCKETS);
+}
+
+v_uint64 Histogram::getBucketUpperBound(v_int32 index) {
+  constexpr v_int32 SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  if (index < SUB_BUCKETS) {
+    return static_cast<v_uint64>(index);
+  }
+  v_int32 shift = (index >> SUB_BUCKET_BITS) - 1;
+  v_uint64 lower = static_cast<v_uint64>(SUB_BUCKETS + (index & (SUB_BUCKETS - 1))) << shift;
+  return lower + (v_uint64(1) << shift) - 1;
+}
+
+void Histogram::record(v_uint64 value) {
+  m_buckets[getBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(value, std::memory_order_relaxed);
+  v_uint64 max = m_max.load(std::memory_order_relaxed);
+  while (value > max && !m_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+}
+
+void Histogram::recordSince(std::chrono::steady_clock::time_point start) {
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  record(static_cast<v_uint64>(std::max<std::chrono::microseconds::rep>(0, elapsed.count())));
+}
+
+Histogram::Snapshot Histogram::getSnapshot() const {
+  Snapshot snapshot;
+  snapshot.count = m_count.load(std::memory_order_relaxed);
+  if (snapshot.count == 0) {
+    return snapshot;
+  }
+  snapshot.sum = m_sum.load(std::memory_order_relaxed);
+  snapshot.max = m_max.load(std::memory_order_relaxed);
+  snapshot.buckets.resize(BUCKET_COUNT);
+  v_uint64 count = 0;
+  for (v_int32 i = 0; i < BUCKET_COUNT; i++) {
+    snapshot.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+    count += snapshot.buckets[i];
+  }
+  // keep percentiles consistent with the buckets if values were recorded meanwhile
+  snapshot.count = count;
+  return snapshot;
+}
+
+void Histogram::reset() {
+  for (auto& bucket : m_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_sum.store(0, std::memory_order_relaxed);
+  m_max.store(0, std::memory_order_relaxed);
+}
+
+}}}
@@ -0,0 +1,136 @@
+#ifndef oatpp_mariadb_metrics_Histogram_hpp
+#define oatpp_mariadb_metrics_Histogram_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+namespace oatpp { namespace mariadb { namespace metrics {
+
+/**
+ * Lock-free latency histogram. <br>
+ * Values (microseconds) go into log-linear buckets - each power of two is split into 8 buckets, so a percentile is
+ * reported at most 12.5% above the recorded value, from 1us up to ~19 hours. Recording is a few relaxed atomic
+ * increments, safe from any number of threads.
+ */
+class Histogram {
+public:
+
+  /**
+   * Number of bits of a value kept exactly - each power of two is split into `2^SUB_BUCKET_BITS` buckets.
+   */
+  static constexpr v_int32 SUB_BUCKET_BITS = 3;
+
+  /**
+   * Values are clamped below `2^MAX_VALUE_BITS`.
+   */
+  static constexpr v_int32 MAX_VALUE_BITS = 36;
+
+  /**
+   * Number of buckets.
+   */
+  static constexpr v_int32 BUCKET_COUNT = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+  /**
+   * Point-in-time copy of a histogram.
+   */
+  struct Snapshot {
+
+    /**
+     * Number of recorded values.
+     */
+    v_uint64 count = 0;
+
+    /**
+     * Sum of recorded values.
+     */
+    v_uint64 sum = 0;
+
+    /**
+     * Largest recorded value.
+     */
+    v_uint64 max = 0;
+
+    /**
+     * Number of values in each bucket - see &l:Histogram::getBucketIndex ();. Empty if nothing was recorded.
+     */
+    std::vector<v_uint64> buckets;
+
+    /**
+     * Get mean of recorded values.
+     * @return - `0` if nothing was recorded.
+     */
+    v_float64 getMean() const;
+
+    /**
+     * Get the value below or at which the given fraction of recorded values falls.
+     * @param fraction - e.g. `0.99` for p99.
+     * @return - upper bound of the bucket holding the percentile, capped by `max`. `0` if nothing was recorded.
+     */
+    v_uint64 getPercentile(v_float64 fraction) const;
+
+    /**
+     * Add values of another snapshot.
+     * @param other
+     */
+    void merge(const Snapshot& other);
+
+  };
+
+private:
+  std::array<std::atomic<v_uint64>, BUCKET_COUNT> m_buckets;
+  std::atomic<v_uint64> m_count;
+  std::atomic<v_uint64> m_sum;
+  std::atomic<v_uint64> m_max;
+public:
+
+  Histogram();
+
+  Histogram(const Histogram&) = delete;
+  Histogram& operator=(const Histogram&) = delete;
+
+  /**
+   * Get bucket of a value.
+   * @param value
+   * @return - bucket index. Values below `2^SUB_BUCKET_BITS` have a bucket each.
+   */
+  static v_int32 getBucketIndex(v_uint64 value);
+
+  /**
+   * Get largest value which goes into the bucket.
+   * @param index - bucket index.
+   * @return
+   */
+  static v_uint64 getBucketUpperBound(v_int32 index);
+
+  /**
+   * Record a value.
+   * @param value - usually microseconds.
+   */
+  void record(v_uint64 value);
+
+  /**
+   * Record time elapsed since `start` in microseconds.
+   * @param start
+   */
+  void recordSince(std::chrono::steady_clock::time_point start);
+
+  /**
+   * Get copy of the histogram. Values recorded concurrently may be partially included.
+   * @return - &l:Histogram::Snapshot;.
+   */
+  Snapshot getSnapshot() const;
+
+  /**
+   * Drop all recorded values.
+   */
+  void reset();
+
+};
+
+}}}
+
+#endif // oatpp_mariadb_metrics_Histogram_hpp
@@ -0,0 +1,163 @@
+#include "QueryMetrics.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace oatpp { namespace mariadb { namespace metrics {
+
+namespace {
+
+// threads are spread over the shards in the order they first record something
+v_uint32 getThreadSlot() {
+  static std::atomic<v_uint32> nextSlot(0);
+  thread_local v_uint32 slot = nextSlot.fetch_add(1, std::memory_order_relaxed);
+  return slot;
+}
+
+v_uint32 roundUpToPowerOfTwo(v_uint32 value) {
+  v_uint32 result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+}
+
+const Histogram::Snapshot& TemplateMetrics::Snapshot::get(Phase phase) const {
+  return phases[static_cast<v_int32>(phase)];
+}
+
+TemplateMetrics::TemplateMetrics(const oatpp::String& templateName, v_uint32 shardCount)
+  : m_templateName(templateName)
+  , m_shardMask(shardCount - 1)
+  , m_shards(new std::atomic<Shard*>[shardCount])
+{
+  for (v_uint32 i = 0; i < shardCount; i++) {
+    m_shards[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+TemplateMetrics::~TemplateMetrics() {
+  for (v_uint32 i = 0; i <= m_shardMask; i++) {
+    delete m_shards[i].load(std::memory_order_relaxed);
+  }
+}
+
+TemplateMetrics::Shard* TemplateMetrics::getShard() {
+  auto& slot = m_shards[getThreadSlot() & m_shardMask];
+  Shard* shard = slot.load(std::memory_order_acquire);
+  if (shard) {
+    return shard;
+  }
+  Shard* created = new Shard();
+  if (slot.compare_exchange_strong(shard, created, std::memory_order_acq_rel)) {
+    return created;
+  }
+  delete created; // another thread of the slot was first
+  return shard;
+}
+
+const char* TemplateMetrics::getPhaseName(Phase phase) {
+  switch (phase) {
+    case Phase::ACQUIRE: return "acquire";
+    case Phase::PREPARE: return "prepare";
+    case Phase::BIND: return "bind";
+    case Phase::EXECUTE: return "execute";
+    case Phase::STORE: return "store";
+    case Phase::MAPPING: return "mapping";
+  }
+  return "unknown";
+}
+
+void TemplateMetrics::record(Phase phase, std::chrono::steady_clock::duration duration) {
+  auto micros = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  getShard()->phases[static_cast<v_int32>(phase)].record(static_cast<v_uint64>(std::max<std::chrono::microseconds::rep>(0, micros)));
+}
+
+void TemplateMetrics::recordSince(Phase phase, std::chrono::steady_clock::time_point start) {
+  record(phase, std::chrono::steady_clock::now() - start);
+}
+
+const oatpp::String& TemplateMetrics::getTemplateName() const {
+  return m_templateName;
+}
+
+TemplateMetrics::Snapshot TemplateMetrics::getSnapshot() const {
+  Snapshot snapshot;
+  snapshot.templateName = m_templateName;
+  for (v_uint32 i = 0; i <= m_shardMask; i++) {
+    Shard* shard = m_shards[i].load(std::memory_order_acquire);
+    if (!shard) {
+      continue;
+    }
+    for (v_int32 p = 0; p < PHASE_COUNT; p++) {
+      snapshot.phases[p].merge(shard->phases[p].getSnapshot());
+    }
+  }
+  return snapshot;
+}
+
+void TemplateMetrics::reset() {
+  for (v_uint32 i = 0; i <= m_shardMask; i++) {
+    Shard* shard = m_shards[i].load(std::memory_order_acquire);
+    if (!shard) {
+      continue;
+    }
+    for (auto& histogram : shard->phases) {
+      histogram.reset();
+    }
+  }
+}
+
+QueryMetrics::QueryMetrics()
+  : QueryMetrics(Config())
+{}
+
+QueryMetrics::QueryMetrics(const Config& config) {
+  v_uint32 shardCount = config.shardCount;
+  if (shardCount == 0) {
+    shardCount = std::max<v_uint32>(1, std::thread::hardware_concurrency());
+  }
+  m_shardCount = roundUpToPowerOfTwo(std::min(shardCount, MAX_SHARDS));
+}
+
+std::shared_ptr<TemplateMetrics> QueryMetrics::getTemplate(const oatpp::String& templateName) {
+  std::string name = templateName ? *templateName : std::string();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& metrics = m_templates[name];
+  if (!metrics) {
+    metrics = std::make_shared<TemplateMetrics>(templateName, m_shardCount);
+  }
+  return metrics;
+}
+
+v_uint32 QueryMetrics::getShardCount() const {
+  return m_shardCount;
+}
+
+std::vector<TemplateMetrics::Snapshot> QueryMetrics::getSnapshot() const {
+  std::vector<std::shared_ptr<TemplateMetrics>> templates;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    templates.reserve(m_templates.size());
+    for (auto& entry : m_templates) {
+      templates.push_back(entry.second);
+    }
+  }
+  std::vector<TemplateMetrics::Snapshot> snapshots;
+  snapshots.reserve(templates.size());
+  for (auto& metrics : templates) {
+    snapshots.push_back(metrics->getSnapshot());
+  }
+  return snapshots;
+}
+
+void QueryMetrics::reset() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& entry : m_templates) {
+    entry.second->reset();
+  }
+}
+
+}}}
@@ -0,0 +1,233 @@
+#ifndef oatpp_mariadb_metrics_QueryMetrics_hpp
+#define oatpp_mariadb_metrics_QueryMetrics_hpp
+
+#include "Histogram.hpp"
+
+#include "oatpp/core/Types.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace oatpp { namespace mariadb { namespace metrics {
+
+/**
+ * Latency histograms of one query template, one per execution phase. <br>
+ * Histograms are sharded - each thread records into one of `shardCount` shards, allocated on first use, so threads
+ * executing the same template don't contend on the same cache lines. Snapshots merge the shards.
+ */
+class TemplateMetrics {
+public:
+
+  /**
+   * Execution phase.
+   */
+  enum class Phase : v_int32 {
+
+    /**
+     * Taking a connection from the provider. Only recorded if the executor takes the connection.
+     */
+    ACQUIRE = 0,
+
+    /**
+     * Taking the prepared statement from the statement cache, preparing it on a miss.
+     */
+    PREPARE = 1,
+
+    /**
+     * Serializing parameters and binding them to the statement.
+     */
+    BIND = 2,
+
+    /**
+     * `mysql_stmt_execute` - until the server answers.
+     */
+    EXECUTE = 3,
+
+    /**
+     * Storing the result client-side and reading the first row (`ResultData::init`).
+     */
+    STORE = 4,
+
+    /**
+     * Mapping rows to the result type. Includes reading rows from the server for cursor and streaming results.
+     */
+    MAPPING = 5
+
+  };
+
+  /**
+   * Number of phases.
+   */
+  static constexpr v_int32 PHASE_COUNT = 6;
+
+  /**
+   * Histograms of a template.
+   */
+  struct Snapshot {
+
+    /**
+     * Template name.
+     */
+    oatpp::String templateName;
+
+    /**
+     * Histogram of each phase, indexed by &l:TemplateMetrics::Phase;. Microseconds.
+     */
+    std::array<Histogram::Snapshot, PHASE_COUNT> phases;
+
+    /**
+     * Get histogram of a phase.
+     * @param phase - &l:TemplateMetrics::Phase;.
+     * @return - &id:oatpp::mariadb::metrics::Histogram::Snapshot;.
+     */
+    const Histogram::Snapshot& get(Phase phase) const;
+
+  };
+
+private:
+
+  struct alignas(64) Shard {
+    std::array<Histogram, PHASE_COUNT> phases;
+  };
+
+private:
+  Shard* getShard();
+private:
+  oatpp::String m_templateName;
+  v_uint32 m_shardMask;
+  std::unique_ptr<std::atomic<Shard*>[]> m_shards;
+public:
+
+  /**
+   * Constructor.
+   * @param templateName - template name.
+   * @param shardCount - number of shards, a power of two.
+   */
+  TemplateMetrics(const oatpp::String& templateName, v_uint32 shardCount);
+
+  /**
+   * Destructor.
+   */
+  ~TemplateMetrics();
+
+  TemplateMetrics(const TemplateMetrics&) = delete;
+  TemplateMetrics& operator=(const TemplateMetrics&) = delete;
+
+  /**
+   * Get phase name, e.g. `"execute"`.
+   * @param phase - &l:TemplateMetrics::Phase;.
+   * @return
+   */
+  static const char* getPhaseName(Phase phase);
+
+  /**
+   * Record duration of a phase.
+   * @param phase - &l:TemplateMetrics::Phase;.
+   * @param duration
+   */
+  void record(Phase phase, std::chrono::steady_clock::duration duration);
+
+  /**
+   * Record time elapsed since `start` as duration of a phase.
+   * @param phase - &l:TemplateMetrics::Phase;.
+   * @param start
+   */
+  void recordSince(Phase phase, std::chrono::steady_clock::time_point start);
+
+  /**
+   * Get template name.
+   * @return
+   */
+  const oatpp::String& getTemplateName() const;
+
+  /**
+   * Merge shards into a snapshot.
+   * @return - &l:TemplateMetrics::Snapshot;.
+   */
+  Snapshot getSnapshot() const;
+
+  /**
+   * Drop recorded values.
+   */
+  void reset();
+
+};
+
+/**
+ * Per-template phase latency histograms of an &id:oatpp::mariadb::Executor; - see
+ * &id:oatpp::mariadb::Executor::enableQueryMetrics;. Thread-safe.
+ */
+class QueryMetrics {
+public:
+
+  /**
+   * Maximum number of shards per template.
+   */
+  static constexpr v_uint32 MAX_SHARDS = 64;
+
+  /**
+   * Configuration.
+   */
+  struct Config {
+
+    /**
+     * Shards per template, rounded up to a power of two. `0` - number of hardware threads. <br>
+     * Each allocated shard takes ~13KB - lower it for executors with many templates.
+     */
+    v_uint32 shardCount = 0;
+
+  };
+
+private:
+  v_uint32 m_shardCount;
+  std::unordered_map<std::string, std::shared_ptr<TemplateMetrics>> m_templates;
+  mutable std::mutex m_mutex;
+public:
+
+  /**
+   * Constructor. Default &l:QueryMetrics::Config;.
+   */
+  QueryMetrics();
+
+  /**
+   * Constructor.
+   * @param config - &l:QueryMetrics::Config;.
+   */
+  explicit QueryMetrics(const Config& config);
+
+  /**
+   * Get metrics of a template, created on first call. Called once per template when it's parsed,
+   * executions record into the returned object without locking.
+   * @param templateName - template name.
+   * @return - &l:TemplateMetrics;.
+   */
+  std::shared_ptr<TemplateMetrics> getTemplate(const oatpp::String& templateName);
+
+  /**
+   * Get number of shards per template.
+   * @return
+   */
+  v_uint32 getShardCount() const;
+
+  /**
+   * Get histograms of all templates.
+   * @return - &l:TemplateMetrics::Snapshot; of each template.
+   */
+  std::vector<TemplateMetrics::Snapshot> getSnapshot() const;
+
+  /**
+   * Drop values recorded for all templates.
+   */
+  void reset();
+
+};
+
+}}}
+
+#endif // oatpp_mariadb_metrics_QueryMetrics_hpp
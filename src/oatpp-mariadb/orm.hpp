@@ -6,7 +6,9 @@
 #ifndef oatpp_mariadb_orm_hpp
 #define oatpp_mariadb_orm_hpp
 
+#include "ConnectionPool.hpp"
 #include "Executor.hpp"
+#include "RoutingExecutor.hpp"
 
 #include "oatpp/orm/SchemaMigration.hpp"
 #include "oatpp/orm/DbClient.hpp"
@@ -27,6 +27,10 @@
 #include "oatpp/core/data/stream/BufferStream.hpp"
 #include "oatpp/core/parser/ParsingError.hpp"
 
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
 namespace oatpp { namespace mariadb { namespace ql_template {
 
 // create a variable which starts with ':' and ends with a non-alphanumeric character except '_' or '.'
@@ -141,4 +145,561 @@ data::share::StringTemplate Parser::parseTemplate(const oatpp::String& text) {
 
 }
 
+// e.g. "user.name.first" -> Parameter{name="user", propertyPath={"name", "first"}}
+Parser::TemplateExtra::Parameter Parser::parseParameter(const oatpp::String& variableName) {
+
+  TemplateExtra::Parameter result;
+
+  parser::Caret caret(variableName);
+  auto nameLabel = caret.putLabel();
+  if(caret.findChar('.') && caret.getPosition() < caret.getDataSize() - 1) {
+
+    result.name = nameLabel.toString();
+
+    do {
+
+      caret.inc();
+      auto label = caret.putLabel();
+      caret.findChar('.');
+      result.propertyPath.push_back(label.std_str());
+
+    } while (caret.getPosition() < caret.getDataSize());
+
+    return result;
+
+  }
+
+  result.name = nameLabel.toString();
+  return result;
+
+}
+
+std::shared_ptr<const Parser::TemplateExtra::Parameter::PropertyChain>
+Parser::resolvePropertyChain(const data::mapping::type::Type* objectType, const std::vector<std::string>& propertyPath) {
+
+  auto chain = std::make_shared<TemplateExtra::Parameter::PropertyChain>();
+  chain->objectType = objectType;
+
+  const data::mapping::type::Type* type = objectType;
+  for(auto& propertyName : propertyPath) {
+
+    if(type->classId.id != data::mapping::type::__class::AbstractObject::CLASS_ID.id) {
+      chain->properties.clear();
+      break;
+    }
+
+    auto dispatcher = static_cast<const data::mapping::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+    auto& properties = dispatcher->getProperties()->getMap();
+    auto it = properties.find(propertyName);
+    if(it == properties.end()) {
+      chain->properties.clear();
+      break;
+    }
+
+    chain->properties.push_back(it->second);
+    type = it->second->type;
+
+  }
+
+  return chain;
+
+}
+
+namespace {
+
+bool isIdentifierChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+// case-insensitive keyword match at position with identifier boundaries on both sides
+bool isAtKeyword(const std::string& text, size_t pos, const char* keyword) {
+  size_t size = std::strlen(keyword);
+  if(pos + size > text.size() || (pos > 0 && isIdentifierChar(text[pos - 1]))) {
+    return false;
+  }
+  for(size_t i = 0; i < size; i++) {
+    if(std::toupper(static_cast<unsigned char>(text[pos + i])) != keyword[i]) {
+      return false;
+    }
+  }
+  return pos + size == text.size() || !isIdentifierChar(text[pos + size]);
+}
+
+// skip '...', "..." or `...` starting at pos. Returns position after the closing quote.
+size_t skipQuoted(const std::string& text, size_t pos) {
+  char quote = text[pos];
+  for(size_t i = pos + 1; i < text.size(); i++) {
+    if(text[i] == '\\' && quote != '`') {
+      i++;
+    } else if(text[i] == quote) {
+      return i + 1;
+    }
+  }
+  return text.size();
+}
+
+bool isQuote(char c) {
+  return c == '\'' || c == '"' || c == '`';
+}
+
+size_t skipBlank(const std::string& text, size_t pos) {
+  while(pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+    pos++;
+  }
+  return pos;
+}
+
+}
+
+// e.g. "INSERT INTO t (a, b) VALUES (?, ?);" -> start/end of "(?, ?)"
+bool Parser::findInsertValues(const oatpp::String& preparedText, v_buff_size& start, v_buff_size& end) {
+
+  start = -1;
+  end = -1;
+
+  if(!preparedText) {
+    return false;
+  }
+
+  const std::string& text = *preparedText;
+  size_t pos = skipBlank(text, 0);
+  if(!isAtKeyword(text, pos, "INSERT") && !isAtKeyword(text, pos, "REPLACE")) {
+    return false;
+  }
+
+  v_int64 rowStart = -1;
+  v_int64 rowEnd = -1;
+  v_uint32 placeholdersOutside = 0;
+
+  while(pos < text.size()) {
+
+    char c = text[pos];
+
+    if(isQuote(c)) {
+      pos = skipQuoted(text, pos);
+      continue;
+    }
+
+    if(c == '?') {
+      placeholdersOutside++;
+      pos++;
+      continue;
+    }
+
+    if(rowStart < 0 && (isAtKeyword(text, pos, "VALUES") || isAtKeyword(text, pos, "VALUE"))) {
+
+      pos = skipBlank(text, pos + (isAtKeyword(text, pos, "VALUES") ? 6 : 5));
+      if(pos >= text.size() || text[pos] != '(') {
+        return false;
+      }
+
+      rowStart = pos;
+      v_int32 depth = 0;
+      while(pos < text.size()) {
+        char r = text[pos];
+        if(isQuote(r)) {
+          pos = skipQuoted(text, pos);
+          continue;
+        }
+        if(r == '(') {
+          depth++;
+        } else if(r == ')') {
+          depth--;
+          if(depth == 0) {
+            pos++;
+            break;
+          }
+        }
+        pos++;
+      }
+
+      if(depth != 0) {
+        return false;
+      }
+      rowEnd = pos;
+
+      // already a multi-row insert
+      pos = skipBlank(text, pos);
+      if(pos < text.size() && text[pos] == ',') {
+        return false;
+      }
+      continue;
+
+    }
+
+    pos++;
+
+  }
+
+  // placeholders outside of the row (e.g. in ON DUPLICATE KEY UPDATE) can't be repeated per row
+  if(rowStart < 0 || placeholdersOutside > 0) {
+    return false;
+  }
+
+  start = rowStart;
+  end = rowEnd;
+  return true;
+
+}
+
+oatpp::String Parser::expandInsertValues(const oatpp::String& preparedText, v_buff_size start, v_buff_size end, v_uint32 rowCount) {
+
+  const std::string& text = *preparedText;
+  auto rowSize = end - start;
+
+  std::string result;
+  result.reserve(text.size() + (rowSize + 1) * (rowCount > 0 ? rowCount - 1 : 0));
+  result.append(text, 0, end);
+  for(v_uint32 i = 1; i < rowCount; i++) {
+    result.push_back(',');
+    result.append(text, start, rowSize);
+  }
+  result.append(text, end, std::string::npos);
+
+  return result;
+
+}
+
+namespace {
+
+// -- ..., # ... and /* ... */ starting at pos. Returns position after the comment or pos if there's none.
+size_t skipComment(const std::string& text, size_t pos) {
+  if(text[pos] == '#' || (text.compare(pos, 2, "--") == 0 && (pos + 2 == text.size() || std::isspace(static_cast<unsigned char>(text[pos + 2]))))) {
+    size_t end = text.find('\n', pos);
+    return end == std::string::npos ? text.size() : end + 1;
+  }
+  if(text.compare(pos, 2, "/*") == 0) {
+    size_t end = text.find("*/", pos + 2);
+    return end == std::string::npos ? text.size() : end + 2;
+  }
+  return pos;
+}
+
+// [schema.]table, each part plain or `quoted`. Returns the lower-cased table part, empty if there's no name at pos.
+std::string readTableName(const std::string& text, size_t& pos) {
+  std::string name;
+  while(pos < text.size()) {
+    if(text[pos] == '`') {
+      size_t end = skipQuoted(text, pos);
+      name.assign(text, pos + 1, end - pos >= 2 ? end - pos - 2 : 0);
+      pos = end;
+    } else if(isIdentifierChar(text[pos])) {
+      size_t start = pos;
+      while(pos < text.size() && isIdentifierChar(text[pos])) {
+        pos++;
+      }
+      name.assign(text, start, pos - start);
+    } else {
+      break;
+    }
+    if(pos < text.size() && text[pos] == '.') {
+      pos++;
+      continue;
+    }
+    break;
+  }
+  std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+  return name;
+}
+
+}
+
+// e.g. "SELECT * FROM a JOIN `db`.`B` ON ... WHERE id IN (SELECT id FROM c)" -> read, {"a", "b", "c"}
+bool Parser::findTables(const oatpp::String& text, std::vector<std::string>& tables) {
+
+  static const char* const DML[] = {"INSERT", "REPLACE", "UPDATE", "DELETE"};
+  static const char* const OTHER_WRITES[] = {"TRUNCATE", "ALTER", "DROP", "CREATE", "RENAME", "LOAD", "CALL"};
+  static const char* const TABLE_MODIFIERS[] = {"LOW_PRIORITY", "DELAYED", "HIGH_PRIORITY", "IGNORE", "QUICK", "INTO"};
+  static const char* const LIST_END[] = {"WHERE", "ON", "USING", "SET", "GROUP", "ORDER", "LIMIT", "HAVING",
+                                         "UNION", "VALUES", "VALUE", "SELECT", "WINDOW", "FOR", "LOCK"};
+
+  tables.clear();
+  if(!text) {
+    return false;
+  }
+
+  const std::string& s = *text;
+  size_t pos = 0;
+  bool isWrite = false;
+  bool expectTable = false;
+  bool inTableList = false;
+
+  // classifies the statement starting at pos by its leading keyword. `false` - a write with unknown tables
+  auto beginStatement = [&]() {
+    pos = skipBlank(s, pos);
+    while(pos < s.size() && skipComment(s, pos) != pos) {
+      pos = skipBlank(s, skipComment(s, pos));
+    }
+    expectTable = false;
+    inTableList = false;
+    for(auto keyword : DML) {
+      if(isAtKeyword(s, pos, keyword)) {
+        isWrite = true;
+        // INTO is optional - "INSERT t VALUES ..."
+        expectTable = keyword[0] != 'D';
+        inTableList = keyword[0] == 'U';
+        pos += std::strlen(keyword);
+        break;
+      }
+    }
+    for(auto keyword : OTHER_WRITES) {
+      if(isAtKeyword(s, pos, keyword)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  if(!beginStatement()) {
+    tables.clear();
+    return true;
+  }
+
+  while(pos < s.size()) {
+
+    char c = s[pos];
+
+    // multi-statement text - every statement is classified, e.g. "SELECT ...; DELETE FROM t"
+    if(c == ';') {
+      pos++;
+      if(!beginStatement()) {
+        tables.clear();
+        return true;
+      }
+      continue;
+    }
+
+    size_t commentEnd = skipComment(s, pos);
+    if(commentEnd != pos) {
+      pos = commentEnd;
+      continue;
+    }
+
+    if(expectTable) {
+      if(std::isspace(static_cast<unsigned char>(c))) {
+        pos++;
+        continue;
+      }
+      bool modifier = false;
+      for(auto keyword : TABLE_MODIFIERS) {
+        if(isAtKeyword(s, pos, keyword)) {
+          pos += std::strlen(keyword);
+          modifier = true;
+          break;
+        }
+      }
+      if(modifier) {
+        continue;
+      }
+      expectTable = false;
+      auto name = readTableName(s, pos);
+      if(!name.empty() && std::find(tables.begin(), tables.end(), name) == tables.end()) {
+        tables.push_back(name);
+      }
+      continue;
+    }
+
+    if(isQuote(c)) {
+      pos = skipQuoted(s, pos);
+      continue;
+    }
+
+    if(c == ',' && inTableList) {
+      expectTable = true;
+      pos++;
+      continue;
+    }
+
+    if(c == '(' || c == ')') {
+      inTableList = false;
+      pos++;
+      continue;
+    }
+
+    if(!isIdentifierChar(c)) {
+      pos++;
+      continue;
+    }
+
+    if(isAtKeyword(s, pos, "FROM") || isAtKeyword(s, pos, "UPDATE")) {
+      pos += isAtKeyword(s, pos, "FROM") ? 4 : 6;
+      expectTable = true;
+      inTableList = true;
+      continue;
+    }
+
+    if(isAtKeyword(s, pos, "JOIN") || isAtKeyword(s, pos, "INTO")) {
+      pos += 4;
+      expectTable = true;
+      continue;
+    }
+
+    for(auto keyword : LIST_END) {
+      if(isAtKeyword(s, pos, keyword)) {
+        inTableList = false;
+        break;
+      }
+    }
+
+    while(pos < s.size() && isIdentifierChar(s[pos])) {
+      pos++;
+    }
+
+  }
+
+  return isWrite;
+
+}
+
+// e.g. "SELECT * FROM t WHERE id = ?" -> true, "SELECT * FROM t WHERE id = ? FOR UPDATE" -> false
+bool Parser::isReadOnly(const oatpp::String& text) {
+
+  static const char* const NOT_READ_ONLY[] = {"INTO", "INSERT", "REPLACE", "UPDATE", "DELETE", "LOCK",
+                                              "LAST_INSERT_ID", "FOUND_ROWS", "ROW_COUNT",
+                                              "GET_LOCK", "RELEASE_LOCK", "RELEASE_ALL_LOCKS", "IS_FREE_LOCK", "IS_USED_LOCK",
+                                              "NEXTVAL", "LASTVAL", "SETVAL"};
+
+  if(!text) {
+    return false;
+  }
+
+  const std::string& s = *text;
+  size_t pos = skipBlank(s, 0);
+  while(pos < s.size() && skipComment(s, pos) != pos) {
+    pos = skipBlank(s, skipComment(s, pos));
+  }
+
+  if(!isAtKeyword(s, pos, "SELECT") && !isAtKeyword(s, pos, "WITH")) {
+    return false;
+  }
+
+  while(pos < s.size()) {
+
+    char c = s[pos];
+
+    size_t commentEnd = skipComment(s, pos);
+    if(commentEnd != pos) {
+      pos = commentEnd;
+      continue;
+    }
+
+    if(isQuote(c)) {
+      pos = skipQuoted(s, pos);
+      continue;
+    }
+
+    // user variables live in the session - @@system variables are fine
+    if(c == '@') {
+      if(pos + 1 < s.size() && s[pos + 1] == '@') {
+        pos += 2;
+        continue;
+      }
+      return false;
+    }
+
+    if(!isIdentifierChar(c)) {
+      pos++;
+      continue;
+    }
+
+    for(auto keyword : NOT_READ_ONLY) {
+      if(isAtKeyword(s, pos, keyword)) {
+        return false;
+      }
+    }
+
+    while(pos < s.size() && isIdentifierChar(s[pos])) {
+      pos++;
+    }
+
+  }
+
+  return true;
+
+}
+
+// e.g. "SET @last = :id" -> true, "CREATE TEMPORARY TABLE ..." -> true, "SELECT * FROM t" -> false
+bool Parser::changesSession(const oatpp::String& text) {
+
+  static const char* const SESSION_STATEMENTS[] = {"SET", "USE", "LOCK", "PREPARE"};
+  static const char* const SESSION_KEYWORDS[] = {"TEMPORARY", "GET_LOCK"};
+
+  if(!text) {
+    return false;
+  }
+
+  const std::string& s = *text;
+  size_t pos = 0;
+
+  // checks the leading keyword of the statement starting at pos
+  auto isSessionStatement = [&]() {
+    pos = skipBlank(s, pos);
+    while(pos < s.size() && skipComment(s, pos) != pos) {
+      pos = skipBlank(s, skipComment(s, pos));
+    }
+    for(auto keyword : SESSION_STATEMENTS) {
+      if(isAtKeyword(s, pos, keyword)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if(isSessionStatement()) {
+    return true;
+  }
+
+  while(pos < s.size()) {
+
+    char c = s[pos];
+
+    // multi-statement text - e.g. "INSERT ...; SET SESSION sql_mode = ''"
+    if(c == ';') {
+      pos++;
+      if(isSessionStatement()) {
+        return true;
+      }
+      continue;
+    }
+
+    size_t commentEnd = skipComment(s, pos);
+    if(commentEnd != pos) {
+      pos = commentEnd;
+      continue;
+    }
+
+    if(isQuote(c)) {
+      pos = skipQuoted(s, pos);
+      continue;
+    }
+
+    if(c == '@') {
+      if(pos + 1 < s.size() && s[pos + 1] == '@') {
+        pos += 2;
+        continue;
+      }
+      return true;
+    }
+
+    if(!isIdentifierChar(c)) {
+      pos++;
+      continue;
+    }
+
+    for(auto keyword : SESSION_KEYWORDS) {
+      if(isAtKeyword(s, pos, keyword)) {
+        return true;
+      }
+    }
+
+    while(pos < s.size() && isIdentifierChar(s[pos])) {
+      pos++;
+    }
+
+  }
+
+  return false;
+
+}
+
 }}}
@@ -25,11 +25,20 @@
 #ifndef oatpp_mariadb_ql_template_Parser_hpp
 #define oatpp_mariadb_ql_template_Parser_hpp
 
+#include "oatpp-mariadb/metrics/QueryMetrics.hpp"
+
 #include "oatpp/core/data/share/StringTemplate.hpp"
 #include "oatpp/core/data/share/MemoryLabel.hpp"
 #include "oatpp/core/parser/Caret.hpp"
 #include "oatpp/core/Types.hpp"
 
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 namespace oatpp { namespace mariadb { namespace ql_template {
 
 /**
@@ -43,6 +52,46 @@ public:
    */
   struct TemplateExtra {
 
+    /**
+     * Query parameter referenced by a template variable. <br>
+     * e.g. `:user.name.first` -> name = "user", propertyPath = {"name", "first"}.
+     */
+    struct Parameter {
+
+      /**
+       * DTO properties along `propertyPath` resolved for one DTO type.
+       */
+      struct PropertyChain {
+
+        /**
+         * Type of the parameter object the chain was resolved for.
+         */
+        const data::mapping::type::Type* objectType;
+
+        /**
+         * Properties to follow, one per path element. Empty if the path can't be followed through DTO properties only.
+         */
+        std::vector<data::mapping::type::BaseObject::Property*> properties;
+
+      };
+
+      /**
+       * Name of the parameter in the params map.
+       */
+      oatpp::String name;
+
+      /**
+       * Property path inside the parameter value.
+       */
+      std::vector<std::string> propertyPath;
+
+      /**
+       * Chain resolved for the DTO type seen last. Shared between threads - use `std::atomic_load/atomic_store`.
+       */
+      std::shared_ptr<const PropertyChain> propertyChain;
+
+    };
+
     /**
      * Template name.
      */
@@ -57,6 +106,70 @@ public:
      * Use prepared statement for this query.
      */
     bool prepare;
+
+    /**
+     * Parameters in the order of the template variables.
+     */
+    std::vector<Parameter> parameters;
+
+    /**
+     * If not `0`, results are read through a server-side read-only cursor, this many rows per fetch from the server.
+     */
+    v_uint32 cursorPrefetchRows = 0;
+
+    /**
+     * Results are kept in the executor's &id:oatpp::mariadb::ResultCache;.
+     */
+    bool resultCache = false;
+
+    /**
+     * Time to live of cached results. `0` - default TTL of the cache.
+     */
+    std::chrono::milliseconds resultCacheTtl{0};
+
+    /**
+     * The statement modifies data - see &l:Parser::findTables ();.
+     */
+    bool isWrite = false;
+
+    /**
+     * Lower-cased names of the tables the statement refers to - see &l:Parser::findTables ();.
+     */
+    std::vector<std::string> tables;
+
+    /**
+     * The statement only reads data - see &l:Parser::isReadOnly ();. Such statements may be routed to a replica
+     * by &id:oatpp::mariadb::RoutingExecutor;, which may also override the flag per template.
+     */
+    bool isReadOnly = false;
+
+    /**
+     * The statement may leave session state behind - see &l:Parser::changesSession ();.
+     */
+    bool changesSession = false;
+
+    /**
+     * Position of the `(...)` row of an `INSERT ... VALUES (...)` prepared template. <br>
+     * `-1` if the template can't be expanded to a multi-row insert. See &l:Parser::findInsertValues ();.
+     */
+    v_buff_size valuesStart = -1;
+
+    /**
+     * Position right after the closing parenthesis of the `(...)` row.
+     */
+    v_buff_size valuesEnd = -1;
+
+    /**
+     * Multi-row expansions of the prepared template by row count. Guarded by `expandedTemplatesMutex`.
+     */
+    std::unordered_map<v_uint32, oatpp::String> expandedTemplates;
+    std::mutex expandedTemplatesMutex;
+
+    /**
+     * Phase latency histograms of the template. `nullptr` if query metrics are not enabled -
+     * see &id:oatpp::mariadb::Executor::enableQueryMetrics;.
+     */
+    std::shared_ptr<metrics::TemplateMetrics> metrics;
   };
 
 private:
@@ -72,6 +185,79 @@ public:
    */
   static data::share::StringTemplate parseTemplate(const oatpp::String& text);
 
+  /**
+   * Split a template variable name into parameter name and property path.
+   * e.g. "user.name.first" -> name = "user", propertyPath = {"name", "first"}.
+   * @param variableName - template variable name.
+   * @return - &l:Parser::TemplateExtra::Parameter;.
+   */
+  static TemplateExtra::Parameter parseParameter(const oatpp::String& variableName);
+
+  /**
+   * Resolve DTO properties along the parameter's property path for the object type.
+   * @param objectType - type of the parameter value. Must be an `oatpp::Object`.
+   * @param propertyPath - property path.
+   * @return - &l:Parser::TemplateExtra::Parameter::PropertyChain;.
+   */
+  static std::shared_ptr<const TemplateExtra::Parameter::PropertyChain>
+  resolvePropertyChain(const data::mapping::type::Type* objectType, const std::vector<std::string>& propertyPath);
+
+  /**
+   * Find the single `(...)` row of an `INSERT/REPLACE ... VALUES (...)` prepared template. <br>
+   * The template is expandable only if every `?` placeholder is inside the row and the statement has exactly one row.
+   * @param preparedText - template text with `?` placeholders.
+   * @param start - out. Position of the opening parenthesis.
+   * @param end - out. Position right after the closing parenthesis.
+   * @return - `true` if the template can be expanded to a multi-row insert.
+   */
+  static bool findInsertValues(const oatpp::String& preparedText, v_buff_size& start, v_buff_size& end);
+
+  /**
+   * Repeat the `(...)` row of a prepared insert template.
+   * e.g. "INSERT INTO t VALUES (?, ?);" x 3 -> "INSERT INTO t VALUES (?, ?),(?, ?),(?, ?);"
+   * @param preparedText - template text with `?` placeholders.
+   * @param start - position of the opening parenthesis.
+   * @param end - position right after the closing parenthesis.
+   * @param rowCount - number of rows.
+   * @return - expanded query text.
+   */
+  static oatpp::String expandInsertValues(const oatpp::String& preparedText, v_buff_size start, v_buff_size end, v_uint32 rowCount);
+
+  /**
+   * Find the tables a statement refers to - names following `FROM`, `JOIN`, `INTO`, `UPDATE` and `INSERT/REPLACE`,
+   * including subqueries. Names are lower-cased, quotes and schema prefix are removed. <br>
+   * The scan is lexical - it may report extra names (e.g. `FROM` in `EXTRACT(YEAR FROM d)`), which is safe for
+   * cache invalidation. `INSERT`, `REPLACE`, `UPDATE` and `DELETE` are writes. DDL, `LOAD` and `CALL` are writes
+   * with unknown tables - `tables` is left empty. <br>
+   * Each statement of a multi-statement text is classified - it's a write if any of its statements is, and tables
+   * of all statements are reported.
+   * e.g. "UPDATE `shop`.`Orders` o JOIN users u ON ... SET ..." -> write, {"orders", "users"}.
+   * @param text - statement text.
+   * @param tables - out. Table names, no duplicates.
+   * @return - `true` if the statement modifies data.
+   */
+  static bool findTables(const oatpp::String& text, std::vector<std::string>& tables);
+
+  /**
+   * Check if a statement only reads data and doesn't depend on session state, so it can run on any replica. <br>
+   * `SELECT` and `WITH` statements qualify unless they lock rows (`FOR UPDATE`, `LOCK IN SHARE MODE`), write
+   * (`INTO`), use user variables or session/lock functions (`LAST_INSERT_ID()`, `FOUND_ROWS()`, `GET_LOCK()`, sequences).
+   * The scan is lexical - a column named like one of these keywords makes the statement not read-only, which is safe.
+   * @param text - statement text.
+   * @return - `true` if the statement is read-only.
+   */
+  static bool isReadOnly(const oatpp::String& text);
+
+  /**
+   * Check if a statement may leave session state behind for the next user of the connection - `SET` (session and
+   * user variables, `SET NAMES`, isolation level), `USE`, `LOCK TABLES`, `PREPARE`, temporary tables, `GET_LOCK()`
+   * and user variables anywhere in the statement. Each statement of a multi-statement text is checked.
+   * The scan is lexical and errs on the side of `true`.
+   * @param text - statement text.
+   * @return - `true` if the connection's session must be reset before it's reused.
+   */
+  static bool changesSession(const oatpp::String& text);
+
 };
 
 }}}
@@ -93,48 +93,33 @@ public:
   static void setupSerializer(oatpp::mariadb::mapping::Serializer& serializer) {
     serializer.setSerializerMethod(Flag<N>::CLASS_ID,
       [](const oatpp::mariadb::mapping::Serializer* _this,
-         MYSQL_STMT* stmt,
+         oatpp::mariadb::mapping::Serializer::BindContext& context,
          v_uint32 paramIndex,
          const oatpp::Void& polymorph) -> void {
-        if(paramIndex >= _this->getBindParams().size()) {
-          _this->getBindParams().resize(paramIndex + 1);
-        }
-        
-        auto& bind = _this->getBindParams()[paramIndex];
-        std::memset(&bind, 0, sizeof(MYSQL_BIND));
-        
+        (void) _this;
+        auto& bind = oatpp::mariadb::mapping::Serializer::initBind(context, paramIndex, MYSQL_TYPE_NULL, false);
+
         if(polymorph) {
           auto value = static_cast<Flag<N>*>(polymorph.get());
           if(value) {
             bind.buffer_type = MYSQL_TYPE_BIT;
-            bind.buffer = malloc(8);  // Always use 8 bytes for BIT(64)
-            if(!bind.buffer) {
-              throw std::runtime_error("Failed to allocate memory for Flag value");
-            }
-            
+            // Always use 8 bytes for BIT(64)
+            unsigned char* bytes = static_cast<unsigned char*>(context.allocate(8));
+
             // Get the value and handle endianness
             v_uint64 val = value->getValue((v_uint64)0);
-            unsigned char* bytes = static_cast<unsigned char*>(bind.buffer);
-            
+
             // MariaDB expects the bytes in little-endian order
             for(size_t i = 0; i < 8; i++) {
               bytes[i] = (val >> (i * 8)) & 0xFF;
             }
-            
+
+            bind.buffer = bytes;
             bind.buffer_length = 8;
             bind.is_null_value = 0;
             bind.length_value = 8;
-          } else {
-            bind.buffer_type = MYSQL_TYPE_NULL;
-            bind.is_null_value = 1;
           }
-        } else {
-          bind.buffer_type = MYSQL_TYPE_NULL;
-          bind.is_null_value = 1;
         }
-        
-        bind.is_null = &bind.is_null_value;
-        bind.length = &bind.length_value;
       });
   }
 };
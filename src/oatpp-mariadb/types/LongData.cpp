@@ -0,0 +1,88 @@
+#include "LongData.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace oatpp { namespace mariadb { namespace types {
+
+LongDataObject::LongDataObject(const std::shared_ptr<data::stream::InputStream>& stream,
+                               bool binary,
+                               v_buff_size chunkSize)
+  : m_stream(stream)
+  , m_binary(binary)
+  , m_chunkSize(chunkSize > 0 ? chunkSize : DEFAULT_CHUNK_SIZE)
+{}
+
+LongDataObject::LongDataObject(const oatpp::String& data,
+                               bool binary,
+                               v_buff_size chunkSize)
+  : m_data(data)
+  , m_binary(binary)
+  , m_chunkSize(chunkSize > 0 ? chunkSize : DEFAULT_CHUNK_SIZE)
+{}
+
+bool LongDataObject::isBinary() const {
+  return m_binary;
+}
+
+v_buff_size LongDataObject::getChunkSize() const {
+  return m_chunkSize;
+}
+
+v_int64 LongDataObject::send(MYSQL_STMT* stmt, unsigned int paramIndex) {
+
+  v_int64 total = 0;
+
+  auto sendChunk = [stmt, paramIndex, &total](const char* data, v_buff_size size) {
+    if (mysql_stmt_send_long_data(stmt, paramIndex, data, static_cast<unsigned long>(size))) {
+      throw std::runtime_error(std::string("[oatpp::mariadb::types::LongDataObject::send()]: Error. "
+                                           "Failed to send long data: ") + mysql_stmt_error(stmt));
+    }
+    total += size;
+  };
+
+  if (m_data) {
+    v_buff_size size = m_data->size();
+    for (v_buff_size pos = 0; pos < size; pos += m_chunkSize) {
+      sendChunk(m_data->data() + pos, std::min(m_chunkSize, size - pos));
+    }
+    return total;
+  }
+
+  if (!m_stream) {
+    return 0;
+  }
+
+  std::unique_ptr<char[]> buffer(new char[m_chunkSize]);
+  while (true) {
+    auto res = m_stream->readSimple(buffer.get(), m_chunkSize);
+    if (res > 0) {
+      sendChunk(buffer.get(), res);
+    } else if (res == 0) {
+      break;
+    } else if (res == oatpp::IOError::RETRY_READ || res == oatpp::IOError::RETRY_WRITE) {
+      // retrying right away would spin the thread - there's nothing to wait on here
+      throw std::runtime_error("[oatpp::mariadb::types::LongDataObject::send()]: Error. "
+                               "Non-blocking input streams are not supported.");
+    } else {
+      throw std::runtime_error("[oatpp::mariadb::types::LongDataObject::send()]: Error. "
+                               "Failed to read the input stream.");
+    }
+  }
+
+  return total;
+
+}
+
+namespace __class {
+
+  const oatpp::data::mapping::type::ClassId LongData::CLASS_ID("oatpp::mariadb::types::LongData");
+
+  oatpp::data::mapping::type::Type* LongData::getType() {
+    static oatpp::data::mapping::type::Type type(CLASS_ID);
+    return &type;
+  }
+
+}
+
+}}}
@@ -0,0 +1,99 @@
+#ifndef oatpp_mariadb_types_LongData_hpp
+#define oatpp_mariadb_types_LongData_hpp
+
+#include "oatpp/core/data/stream/Stream.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+namespace oatpp { namespace mariadb { namespace types {
+
+namespace __class {
+  class LongData;
+}
+
+/**
+ * Value of a `BLOB`/`TEXT` parameter sent to the server in chunks with `mysql_stmt_send_long_data`. <br>
+ * The data is read from an &id:oatpp::data::stream::InputStream; (or sliced from a string) one chunk at a time,
+ * so no full-size copy is made and the value isn't limited by `max_allowed_packet` of a single packet.
+ * The stream is consumed by the execution - one object can be bound once. <br>
+ * The value is sent with blocking calls: only blocking input streams are supported (a stream returning
+ * `RETRY_READ`/`RETRY_WRITE` fails the execution), and &id:oatpp::mariadb::Executor::executeAsync; rejects
+ * long data parameters.
+ */
+class LongDataObject {
+public:
+
+  /**
+   * Default chunk size - 64KB.
+   */
+  static constexpr v_buff_size DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+private:
+  std::shared_ptr<data::stream::InputStream> m_stream;
+  oatpp::String m_data;
+  bool m_binary;
+  v_buff_size m_chunkSize;
+public:
+
+  /**
+   * Constructor.
+   * @param stream - input stream to read the value from until it ends.
+   * @param binary - `true` - bind as `MYSQL_TYPE_LONG_BLOB`, `false` - as a string in the connection character set.
+   * @param chunkSize - bytes per `mysql_stmt_send_long_data` call.
+   */
+  LongDataObject(const std::shared_ptr<data::stream::InputStream>& stream,
+                 bool binary = true,
+                 v_buff_size chunkSize = DEFAULT_CHUNK_SIZE);
+
+  /**
+   * Constructor. The string is sent in chunks straight from its buffer.
+   * @param data - value.
+   * @param binary - `true` - bind as `MYSQL_TYPE_LONG_BLOB`, `false` - as a string in the connection character set.
+   * @param chunkSize - bytes per `mysql_stmt_send_long_data` call.
+   */
+  LongDataObject(const oatpp::String& data,
+                 bool binary = true,
+                 v_buff_size chunkSize = DEFAULT_CHUNK_SIZE);
+
+  /**
+   * Check if the value is bound as binary data.
+   * @return
+   */
+  bool isBinary() const;
+
+  /**
+   * Get chunk size.
+   * @return
+   */
+  v_buff_size getChunkSize() const;
+
+  /**
+   * Send the value to the server. Must be called after `mysql_stmt_bind_param` and before `mysql_stmt_execute`.
+   * Throws `std::runtime_error` on error, or if the stream asks to retry - non-blocking streams aren't supported.
+   * @param stmt - prepared statement.
+   * @param paramIndex - index of the parameter.
+   * @return - number of bytes sent.
+   */
+  v_int64 send(MYSQL_STMT* stmt, unsigned int paramIndex);
+
+};
+
+/**
+ * Long data parameter. Usage: `PARAM(oatpp::mariadb::types::LongData, document)`.
+ */
+typedef oatpp::data::mapping::type::ObjectWrapper<LongDataObject, __class::LongData> LongData;
+
+namespace __class {
+
+  class LongData {
+  public:
+    static const oatpp::data::mapping::type::ClassId CLASS_ID;
+    static oatpp::data::mapping::type::Type* getType();
+  };
+
+}
+
+}}}
+
+#endif // oatpp_mariadb_types_LongData_hpp
@@ -0,0 +1,209 @@
+#include "AsyncExecuteTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/async/Executor.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <atomic>
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::AsyncExecuteTest]";
+
+constexpr v_int32 ROW_COUNT = 20;
+constexpr v_int32 COROUTINE_COUNT = 100;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ItemDto : public oatpp::DTO {
+  DTO_INIT(ItemDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+class SelectCoroutine : public oatpp::async::Coroutine<SelectCoroutine> {
+private:
+  std::shared_ptr<oatpp::mariadb::Executor> m_executor;
+  oatpp::data::share::StringTemplate m_queryTemplate;
+  v_int32 m_id;
+  std::atomic<v_int32>* m_counter;
+public:
+
+  SelectCoroutine(const std::shared_ptr<oatpp::mariadb::Executor>& executor,
+                  const oatpp::data::share::StringTemplate& queryTemplate,
+                  v_int32 id,
+                  std::atomic<v_int32>* counter)
+    : m_executor(executor)
+    , m_queryTemplate(queryTemplate)
+    , m_id(id)
+    , m_counter(counter)
+  {}
+
+  Action act() override {
+    return m_executor->executeAsync(m_queryTemplate, {{"id", oatpp::Int32(m_id)}})
+      .callbackTo(&SelectCoroutine::onResult);
+  }
+
+  Action onResult(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    OATPP_ASSERT(result->isSuccess());
+    auto rows = result->fetch<oatpp::Vector<oatpp::Object<ItemDto>>>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0]->id == m_id);
+    OATPP_ASSERT(rows[0]->name == oatpp::String("item_" + oatpp::utils::conversion::int32ToStdStr(m_id)));
+    ++(*m_counter);
+    return finish();
+  }
+
+};
+
+class ErrorCoroutine : public oatpp::async::Coroutine<ErrorCoroutine> {
+private:
+  std::shared_ptr<oatpp::mariadb::Executor> m_executor;
+  oatpp::data::share::StringTemplate m_queryTemplate;
+  std::unordered_map<oatpp::String, oatpp::Void> m_params;
+  std::atomic<v_int32>* m_counter;
+public:
+
+  ErrorCoroutine(const std::shared_ptr<oatpp::mariadb::Executor>& executor,
+                 const oatpp::data::share::StringTemplate& queryTemplate,
+                 const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                 std::atomic<v_int32>* counter)
+    : m_executor(executor)
+    , m_queryTemplate(queryTemplate)
+    , m_params(params)
+    , m_counter(counter)
+  {}
+
+  Action act() override {
+    return m_executor->executeAsync(m_queryTemplate, m_params).callbackTo(&ErrorCoroutine::onResult);
+  }
+
+  Action onResult(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    (void) result;
+    OATPP_ASSERT(false && "Error expected");
+    return finish();
+  }
+
+  Action handleError(oatpp::async::Error* error) override {
+    OATPP_LOGD(TAG, "Expected error: %s", error->what());
+    ++(*m_counter);
+    return finish();
+  }
+
+};
+
+}
+
+void AsyncExecuteTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto pool = oatpp::mariadb::ConnectionPool::createShared(connectionProvider, 4, std::chrono::seconds(5));
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(pool);
+
+  {
+    auto connection = executor->getConnection();
+    auto setup = executor->executeMulti({
+      "DROP TABLE IF EXISTS test_async_execute",
+      "CREATE TABLE test_async_execute (id INT PRIMARY KEY, name VARCHAR(50))"
+    }, connection);
+    while (setup->nextResultSet()) {}
+
+    std::vector<std::unordered_map<oatpp::String, oatpp::Void>> rows;
+    for (v_int32 i = 0; i < ROW_COUNT; i++) {
+      rows.push_back({{"id", oatpp::Int32(i)}, {"name", oatpp::String("item_" + oatpp::utils::conversion::int32ToStdStr(i))}});
+    }
+    auto insert = executor->parseQueryTemplate("insert", "INSERT INTO test_async_execute (id, name) VALUES (:id, :name)", {}, true);
+    OATPP_ASSERT(executor->executeBatch(insert, rows, connection).affectedRows == ROW_COUNT);
+  }
+
+  auto select = executor->parseQueryTemplate("select", "SELECT id, name FROM test_async_execute WHERE id = :id", {}, true);
+  auto invalid = executor->parseQueryTemplate("invalid", "SELECT no_such_column FROM test_async_execute", {}, true);
+
+  // Test many concurrent queries on few processor threads
+  {
+    OATPP_LOGI(TAG, "Test concurrent coroutines");
+
+    std::atomic<v_int32> counter(0);
+    oatpp::async::Executor asyncExecutor(1, 1, 1);
+
+    for (v_int32 i = 0; i < COROUTINE_COUNT; i++) {
+      asyncExecutor.execute<SelectCoroutine>(executor, select, i % ROW_COUNT, &counter);
+    }
+
+    asyncExecutor.waitTasksFinished();
+    asyncExecutor.stop();
+    asyncExecutor.join();
+
+    OATPP_ASSERT(counter == COROUTINE_COUNT);
+  }
+
+  // Test prepare error is reported as coroutine error
+  {
+    OATPP_LOGI(TAG, "Test prepare error");
+
+    std::atomic<v_int32> counter(0);
+    oatpp::async::Executor asyncExecutor(1, 1, 1);
+    asyncExecutor.execute<ErrorCoroutine>(executor, invalid, std::unordered_map<oatpp::String, oatpp::Void>(), &counter);
+    asyncExecutor.waitTasksFinished();
+    asyncExecutor.stop();
+    asyncExecutor.join();
+
+    OATPP_ASSERT(counter == 1);
+  }
+
+  // Test long data is rejected instead of being sent with blocking calls
+  {
+    OATPP_LOGI(TAG, "Test long data parameter");
+
+    auto length = executor->parseQueryTemplate("length", "SELECT LENGTH(:data) AS id", {}, true);
+    oatpp::mariadb::types::LongData data(std::make_shared<oatpp::mariadb::types::LongDataObject>(oatpp::String("long data")));
+
+    std::atomic<v_int32> counter(0);
+    oatpp::async::Executor asyncExecutor(1, 1, 1);
+    asyncExecutor.execute<ErrorCoroutine>(executor, length, std::unordered_map<oatpp::String, oatpp::Void>({{"data", data}}), &counter);
+    asyncExecutor.waitTasksFinished();
+    asyncExecutor.stop();
+    asyncExecutor.join();
+
+    OATPP_ASSERT(counter == 1);
+
+    // the statement went back to the cache in a usable state
+    auto result = executor->execute(length, {{"data", data}});
+    OATPP_ASSERT(result->isSuccess());
+  }
+
+  // Test connections created by getAsync() work with the blocking API
+  {
+    OATPP_LOGI(TAG, "Test blocking query on pooled connection");
+    auto result = executor->execute(select, {{"id", oatpp::Int32(3)}});
+    OATPP_ASSERT(result->isSuccess());
+    auto rows = result->fetch<oatpp::Vector<oatpp::Object<ItemDto>>>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0]->id == 3);
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_async_execute");
+  pool->stop();
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
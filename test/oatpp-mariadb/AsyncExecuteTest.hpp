@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_AsyncExecuteTest_hpp
+#define oatpp_test_mariadb_AsyncExecuteTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class AsyncExecuteTest : public oatpp::test::UnitTest {
+public:
+  AsyncExecuteTest() : UnitTest("TEST[mariadb::AsyncExecuteTest]") {}
+  ~AsyncExecuteTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_AsyncExecuteTest_hpp
@@ -0,0 +1,120 @@
+#include "ColumnarTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::ColumnarTest]";
+
+constexpr v_int32 ROW_COUNT = 1000;
+constexpr v_int64 WINDOW_SIZE = 300;
+
+typedef oatpp::mariadb::mapping::ColumnarResult ColumnarResult;
+
+}
+
+void ColumnarTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto connection = executor->getConnection();
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_columnar", connection);
+  executor->executeRaw("CREATE TABLE test_columnar (id INT PRIMARY KEY, small TINYINT UNSIGNED, big BIGINT UNSIGNED, "
+                       "amount DOUBLE, label VARCHAR(32))", connection);
+  executor->executeRaw("INSERT INTO test_columnar SELECT seq, seq % 256, 18446744073709551615 - seq, "
+                       "IF(seq % 4 = 0, NULL, seq / 2), IF(seq % 10 = 0, NULL, CONCAT('label_', seq)) "
+                       "FROM seq_1_to_" + std::to_string(ROW_COUNT), connection);
+
+  auto query = executor->parseQueryTemplate("selectAll",
+    "SELECT id, small, big, amount, label FROM test_columnar ORDER BY id", {}, true);
+
+  // Whole result at once
+  {
+    auto result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(executor->execute(query, {}, nullptr, connection));
+    OATPP_ASSERT(result->isSuccess());
+    auto columns = result->fetchColumnar();
+
+    OATPP_ASSERT(columns.getRowCount() == ROW_COUNT);
+    OATPP_ASSERT(columns.getColumnCount() == 5);
+
+    const auto& id = columns.getColumn(0);
+    const auto& small = columns.getColumn(1);
+    const auto& big = columns.getColumn(2);
+    const auto* amount = columns.findColumn("amount");
+    const auto* label = columns.findColumn("label");
+    OATPP_ASSERT(amount && label);
+    OATPP_ASSERT(columns.findColumn("unknown") == nullptr);
+
+    OATPP_ASSERT(id.type == ColumnarResult::ColumnType::INT64);
+    OATPP_ASSERT(small.type == ColumnarResult::ColumnType::INT64 && small.isUnsigned);
+    OATPP_ASSERT(big.type == ColumnarResult::ColumnType::INT64 && big.isUnsigned);
+    OATPP_ASSERT(amount->type == ColumnarResult::ColumnType::DOUBLE);
+    OATPP_ASSERT(label->type == ColumnarResult::ColumnType::STRING);
+
+    v_int64 idSum = 0;
+    v_float64 amountSum = 0;
+    for (v_int64 i = 0; i < columns.getRowCount(); i++) {
+      idSum += id.int64Values[i];
+      amountSum += amount->doubleValues[i]; // NULL slots are 0
+    }
+    OATPP_ASSERT(idSum == (v_int64) ROW_COUNT * (ROW_COUNT + 1) / 2);
+
+    v_float64 expectedAmountSum = 0;
+    for (v_int32 i = 1; i <= ROW_COUNT; i++) {
+      if (i % 4 != 0) expectedAmountSum += i / 2.0;
+    }
+    OATPP_ASSERT(amountSum == expectedAmountSum);
+    OATPP_ASSERT(amount->nullCount == ROW_COUNT / 4);
+    OATPP_ASSERT(amount->isNull(3) && !amount->isNull(4));
+
+    OATPP_ASSERT(small.int64Values[254] == 255);
+    OATPP_ASSERT((v_uint64) big.int64Values[0] == 18446744073709551614ULL);
+
+    OATPP_ASSERT(label->nullCount == ROW_COUNT / 10);
+    OATPP_ASSERT(label->getString(0) == "label_1");
+    OATPP_ASSERT(label->getString(9) == nullptr);
+    OATPP_ASSERT(label->getStringSize(9) == 0);
+    OATPP_ASSERT(label->getString(ROW_COUNT - 1) == nullptr);
+    OATPP_ASSERT(label->getString(ROW_COUNT - 2) == "label_999");
+  }
+
+  // In windows
+  {
+    auto result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(executor->execute(query, {}, nullptr, connection));
+    v_int64 expectedId = 1;
+    while (result->hasMoreToFetch()) {
+      auto columns = result->fetchColumnar(WINDOW_SIZE);
+      OATPP_ASSERT(columns.getRowCount() <= WINDOW_SIZE);
+      const auto& id = columns.getColumn(0);
+      for (v_int64 i = 0; i < columns.getRowCount(); i++) {
+        OATPP_ASSERT(id.int64Values[i] == expectedId);
+        expectedId++;
+      }
+    }
+    OATPP_ASSERT(expectedId == ROW_COUNT + 1);
+    OATPP_ASSERT(result->fetchColumnar().getRowCount() == 0);
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_columnar", connection);
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
@@ -0,0 +1,16 @@
+#ifndef oatpp_test_mariadb_ColumnarTest_hpp
+#define oatpp_test_mariadb_ColumnarTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class ColumnarTest : public oatpp::test::UnitTest {
+public:
+  ColumnarTest() : UnitTest("TEST[mariadb::ColumnarTest]") {}
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_ColumnarTest_hpp
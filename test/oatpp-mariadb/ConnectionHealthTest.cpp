@@ -0,0 +1,116 @@
+#include "ConnectionHealthTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-mariadb/ConnectionPool.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::ConnectionHealthTest]";
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(selectOne, "SELECT 1 AS value;")
+
+  QUERY(kill,
+        "KILL CONNECTION :id;",
+        PARAM(oatpp::UInt64, id))
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+}
+
+void ConnectionHealthTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto pool = oatpp::mariadb::ConnectionPool::createShared(connectionProvider, 2, std::chrono::seconds(5));
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(pool);
+  auto client = TestClient(executor);
+
+  // Test healthy connection
+  {
+    OATPP_LOGI(TAG, "Test healthy connection");
+
+    auto connection = executor->getConnection();
+    auto mariadbConnection = std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object);
+    OATPP_ASSERT(mariadbConnection->getHealth() == oatpp::mariadb::Connection::Health::HEALTHY);
+
+    auto result = client.selectOne(connection);
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(mariadbConnection->isHealthy());
+
+    // non-connection errors do not break the connection
+    OATPP_ASSERT(!mariadbConnection->reportError(1064 /* ER_PARSE_ERROR */));
+    OATPP_ASSERT(mariadbConnection->isHealthy());
+  }
+
+  // Test connection killed by the server
+  {
+    OATPP_LOGI(TAG, "Test broken connection");
+
+    auto victim = executor->getConnection();
+    auto victimConnection = std::static_pointer_cast<oatpp::mariadb::Connection>(victim.object);
+    auto threadId = mysql_thread_id(victimConnection->getHandle());
+
+    {
+      auto killer = executor->getConnection();
+      auto result = client.kill(oatpp::UInt64((v_uint64) threadId), killer);
+      OATPP_ASSERT(result->isSuccess());
+    }
+
+    bool failed = false;
+    try {
+      auto result = client.selectOne(victim);
+      failed = !result->isSuccess();
+    } catch (const std::exception& e) {
+      OATPP_LOGD(TAG, "Expected error: %s", e.what());
+      failed = true;
+    }
+
+    OATPP_ASSERT(failed);
+    OATPP_ASSERT(!victimConnection->isHealthy());
+  }
+
+  // Test pool hands out a working connection after eviction
+  {
+    OATPP_LOGI(TAG, "Test pool after eviction");
+
+    for (v_int32 i = 0; i < 3; i++) {
+      auto connection = executor->getConnection();
+      auto mariadbConnection = std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object);
+      OATPP_ASSERT(mariadbConnection->isHealthy());
+      auto result = client.selectOne(connection);
+      OATPP_ASSERT(result->isSuccess());
+    }
+  }
+
+  pool->stop();
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
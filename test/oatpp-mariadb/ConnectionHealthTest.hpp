@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_ConnectionHealthTest_hpp
+#define oatpp_test_mariadb_ConnectionHealthTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class ConnectionHealthTest : public oatpp::test::UnitTest {
+public:
+  ConnectionHealthTest() : UnitTest("TEST[mariadb::ConnectionHealthTest]") {}
+  ~ConnectionHealthTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_ConnectionHealthTest_hpp
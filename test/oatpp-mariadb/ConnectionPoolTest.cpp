@@ -0,0 +1,167 @@
+#include "ConnectionPoolTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-mariadb/dto/Metrics.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::ConnectionPoolTest]";
+
+unsigned long getThreadId(const oatpp::provider::ResourceHandle<oatpp::mariadb::Connection>& connection) {
+  return mysql_thread_id(connection.object->getHandle());
+}
+
+}
+
+void ConnectionPoolTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+
+  // min idle connections are open before the first request
+  {
+    oatpp::mariadb::ConnectionPool::Config config;
+    config.maxConnections = 4;
+    config.minIdle = 3;
+    config.maintenanceInterval = std::chrono::milliseconds(20);
+    auto pool = oatpp::mariadb::ConnectionPool::createShared(connectionProvider, config);
+    OATPP_ASSERT(pool->getSize() == 3);
+    OATPP_ASSERT(pool->getIdleCount() == 3);
+
+    // taken connections are replaced in the background
+    {
+      auto a = pool->get();
+      auto b = pool->get();
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      OATPP_ASSERT(pool->getSize() == 4);
+      OATPP_ASSERT(pool->getIdleCount() == 2);
+    }
+    OATPP_ASSERT(pool->getIdleCount() == 4);
+
+    pool->stop();
+    OATPP_ASSERT(pool->getSize() == 0);
+    OATPP_ASSERT(!pool->get());
+  }
+
+  // connections are recycled after their lifetime
+  {
+    oatpp::mariadb::ConnectionPool::Config config;
+    config.maxConnections = 2;
+    config.minIdle = 1;
+    config.maxLifetime = std::chrono::milliseconds(100);
+    config.lifetimeJitter = 0.5;
+    config.maintenanceInterval = std::chrono::milliseconds(10);
+    auto pool = oatpp::mariadb::ConnectionPool::createShared(connectionProvider, config);
+
+    unsigned long threadId;
+    {
+      auto connection = pool->get();
+      threadId = getThreadId(connection);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    OATPP_ASSERT(pool->getSize() <= 2);
+    OATPP_ASSERT(getThreadId(pool->get()) != threadId);
+
+    pool->stop();
+  }
+
+  // idle connections above min idle are evicted, acquisition times out when the pool is exhausted
+  {
+    oatpp::mariadb::ConnectionPool::Config config;
+    config.maxConnections = 2;
+    config.minIdle = 0;
+    config.idleTimeout = std::chrono::milliseconds(50);
+    config.acquireTimeout = std::chrono::milliseconds(50);
+    config.maintenanceInterval = std::chrono::milliseconds(10);
+    auto pool = oatpp::mariadb::ConnectionPool::createShared(connectionProvider, config);
+    OATPP_ASSERT(pool->getSize() == 0);
+
+    // the most recently returned connection is reused
+    unsigned long threadId;
+    {
+      auto connection = pool->get();
+      OATPP_ASSERT(connection);
+      threadId = getThreadId(connection);
+    }
+    OATPP_ASSERT(getThreadId(pool->get()) == threadId);
+
+    {
+      auto a = pool->get();
+      auto b = pool->get();
+      OATPP_ASSERT(a && b);
+      OATPP_ASSERT(!pool->get());
+    }
+    OATPP_ASSERT(pool->getIdleCount() == 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    OATPP_ASSERT(pool->getSize() == 0);
+
+    // broken connections are not returned to the pool
+    {
+      auto connection = pool->get();
+      connection.object->setHealth(oatpp::mariadb::Connection::Health::BROKEN);
+    }
+    OATPP_ASSERT(pool->getSize() == 0);
+
+    // metrics of everything above
+    {
+      auto stats = pool->getStats();
+      OATPP_LOGD(TAG, "acquisitions=%lu creations=%lu acquire wait p99=%luus creation p99=%luus",
+                 (unsigned long) stats.acquisitions, (unsigned long) stats.creations,
+                 (unsigned long) stats.acquireWait.getPercentile(0.99), (unsigned long) stats.creationLatency.getPercentile(0.99));
+      OATPP_ASSERT(stats.maxConnections == 2);
+      OATPP_ASSERT(stats.size == 0 && stats.inUse == 0 && stats.idle == 0 && stats.waiting == 0);
+      OATPP_ASSERT(stats.acquisitions == 5);
+      OATPP_ASSERT(stats.acquireWait.count == 5);
+      OATPP_ASSERT(stats.timeouts == 1);
+      OATPP_ASSERT(stats.creations == 3);
+      OATPP_ASSERT(stats.creationLatency.count == 3);
+      OATPP_ASSERT(stats.creationFailures == 0);
+      OATPP_ASSERT(stats.evictions == 2);
+      OATPP_ASSERT(stats.discards == 1);
+
+      auto dto = oatpp::mariadb::dto::PoolStatsDto::fromStats(stats);
+      OATPP_ASSERT(dto->acquisitions == 5);
+      OATPP_ASSERT(dto->acquireWait->count == 5);
+
+      pool->resetStats();
+      OATPP_ASSERT(pool->getStats().acquisitions == 0);
+    }
+
+    // executor-level acquisition metrics
+    {
+      auto executor = std::make_shared<oatpp::mariadb::Executor>(pool);
+      {
+        auto connection = executor->getConnection();
+        OATPP_ASSERT(pool->getStats().inUse == 1);
+      }
+      auto stats = executor->getConnectionStats();
+      OATPP_ASSERT(stats.acquisitions == 1);
+      OATPP_ASSERT(stats.failures == 0);
+      OATPP_ASSERT(stats.acquireWait.count == 1);
+      OATPP_ASSERT(oatpp::mariadb::dto::ConnectionStatsDto::fromStats(stats)->acquisitions == 1);
+    }
+
+    pool->stop();
+  }
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_ConnectionPoolTest_hpp
+#define oatpp_test_mariadb_ConnectionPoolTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class ConnectionPoolTest : public oatpp::test::UnitTest {
+public:
+  ConnectionPoolTest() : UnitTest("TEST[mariadb::ConnectionPoolTest]") {}
+  ~ConnectionPoolTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_ConnectionPoolTest_hpp
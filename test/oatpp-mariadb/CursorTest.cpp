@@ -0,0 +1,144 @@
+#include "CursorTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::CursorTest]";
+
+constexpr v_int32 ROW_COUNT = 10000;
+constexpr v_int64 WINDOW_SIZE = 750;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class RowDto : public oatpp::DTO {
+  DTO_INIT(RowDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(selectFrom,
+        "SELECT id, name FROM test_cursor WHERE id >= :id ORDER BY id;",
+        PARAM(oatpp::Int32, id))
+
+  QUERY(selectAllWithCursor,
+        "SELECT id, name FROM test_cursor ORDER BY id;")
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+// Reads the result in windows and checks that ids are consecutive
+v_int32 readInWindows(const std::shared_ptr<oatpp::orm::QueryResult>& result, v_int32 firstId) {
+  v_int32 expectedId = firstId;
+  while (result->hasMoreToFetch()) {
+    auto rows = result->fetch<oatpp::Vector<oatpp::Object<RowDto>>>(WINDOW_SIZE);
+    OATPP_ASSERT(rows);
+    OATPP_ASSERT(rows->size() <= (size_t) WINDOW_SIZE);
+    for (auto& row : *rows) {
+      OATPP_ASSERT(row->id == expectedId);
+      expectedId++;
+    }
+  }
+  OATPP_ASSERT(result->isSuccess());
+  return expectedId - firstId;
+}
+
+}
+
+void CursorTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+
+  // per template - must be set before the client parses its queries
+  executor->setTemplateCursor("selectAllWithCursor", 128);
+  auto client = TestClient(executor);
+
+  auto connection = executor->getConnection();
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_cursor", connection);
+  executor->executeRaw("CREATE TABLE test_cursor (id INT PRIMARY KEY, name VARCHAR(50))", connection);
+  executor->executeRaw("INSERT INTO test_cursor SELECT seq, CONCAT('row_', seq) FROM seq_1_to_" +
+                       std::to_string(ROW_COUNT), connection);
+
+  // per call
+  {
+    auto query = executor->parseQueryTemplate("selectFromCursor",
+                                              "SELECT id, name FROM test_cursor WHERE id >= :id ORDER BY id;",
+                                              {}, true);
+    auto result = executor->executeWithCursor(query, {{"id", oatpp::Int32(101)}}, 500, nullptr, connection);
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(readInWindows(result, 101) == ROW_COUNT - 100);
+  }
+
+  // per template
+  {
+    auto result = client.selectAllWithCursor(connection);
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(readInWindows(result, 1) == ROW_COUNT);
+  }
+
+  // the connection can run other statements while a cursor is open
+  {
+    auto result = client.selectAllWithCursor(connection);
+    auto first = result->fetch<oatpp::Vector<oatpp::Object<RowDto>>>(10);
+    OATPP_ASSERT(first->size() == 10);
+
+    auto other = client.selectFrom(ROW_COUNT, connection);
+    auto otherRows = other->fetch<oatpp::Vector<oatpp::Object<RowDto>>>();
+    OATPP_ASSERT(otherRows->size() == 1);
+    OATPP_ASSERT(otherRows[0]->name == oatpp::String("row_" + std::to_string(ROW_COUNT)));
+
+    OATPP_ASSERT(readInWindows(result, 11) == ROW_COUNT - 10);
+  }
+
+  // the cached statement is executed without cursor again
+  {
+    auto result = client.selectFrom(ROW_COUNT - 4, connection);
+    auto rows = result->fetch<oatpp::Vector<oatpp::Object<RowDto>>>();
+    OATPP_ASSERT(rows->size() == 5);
+  }
+
+  // empty result
+  {
+    auto result = executor->executeWithCursor(
+      executor->parseQueryTemplate("selectNone", "SELECT id, name FROM test_cursor WHERE id < 0;", {}, true),
+      {}, 10, nullptr, connection);
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(!result->hasMoreToFetch());
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_cursor", connection);
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_CursorTest_hpp
+#define oatpp_test_mariadb_CursorTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class CursorTest : public oatpp::test::UnitTest {
+public:
+  CursorTest() : UnitTest("TEST[mariadb::CursorTest]") {}
+  ~CursorTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_CursorTest_hpp
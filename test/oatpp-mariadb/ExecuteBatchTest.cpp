@@ -0,0 +1,200 @@
+#include "ExecuteBatchTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::ExecuteBatchTest]";
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class BatchRowDto : public oatpp::DTO {
+  DTO_INIT(BatchRowDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Float64, score);
+};
+
+class CountDto : public oatpp::DTO {
+  DTO_INIT(CountDto, DTO);
+  DTO_FIELD(Int64, total);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(createTable,
+        "CREATE TABLE IF NOT EXISTS test_execute_batch ("
+        "  id INT PRIMARY KEY,"
+        "  name VARCHAR(50),"
+        "  score DOUBLE"
+        ");")
+
+  QUERY(dropTable, "DROP TABLE IF EXISTS test_execute_batch;")
+
+  QUERY(count, "SELECT COUNT(*) AS total FROM test_execute_batch;")
+
+  QUERY(selectAll, "SELECT * FROM test_execute_batch ORDER BY id;")
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+}
+
+void ExecuteBatchTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto client = TestClient(executor);
+
+  auto connection = executor->getConnection();
+
+  client.dropTable(connection);
+  client.createTable(connection);
+
+  // Test params rows split into several batches
+  {
+    OATPP_LOGI(TAG, "Test params list");
+
+    auto queryTemplate = executor->parseQueryTemplate(
+      "insertRow",
+      "INSERT INTO test_execute_batch (id, name, score) VALUES (:id, :name, :score);",
+      {}, true);
+
+    std::vector<std::unordered_map<oatpp::String, oatpp::Void>> rows;
+    for (v_int32 i = 1; i <= 25; i++) {
+      oatpp::String name = nullptr;
+      if (i % 5 != 0) {
+        name = "name_" + oatpp::utils::conversion::int32ToStdStr(i);
+      }
+      rows.push_back({{"id", oatpp::Int32(i)}, {"name", name}, {"score", oatpp::Float64(i * 0.5)}});
+    }
+
+    auto result = executor->executeBatch(queryTemplate, rows, connection, 10);
+    OATPP_ASSERT(result.affectedRows == 25);
+    OATPP_ASSERT(result.batchAffectedRows.size() == 3 || result.batchAffectedRows.size() == 25); // bulk or row-by-row fallback
+
+    auto count = client.count(connection)->fetch<oatpp::Vector<oatpp::Object<CountDto>>>();
+    OATPP_ASSERT(count[0]->total == 25);
+
+    auto stored = client.selectAll(connection)->fetch<oatpp::Vector<oatpp::Object<BatchRowDto>>>();
+    OATPP_ASSERT(stored->size() == 25);
+    OATPP_ASSERT(stored[0]->name == "name_1");
+    OATPP_ASSERT(stored[4]->name == nullptr);
+    OATPP_ASSERT(stored[24]->score == 12.5);
+  }
+
+  // Test vector of DTOs
+  {
+    OATPP_LOGI(TAG, "Test vector of DTOs");
+
+    auto queryTemplate = executor->parseQueryTemplate(
+      "updateRow",
+      "UPDATE test_execute_batch SET name = :row.name, score = :row.score WHERE id = :row.id;",
+      {}, true);
+
+    auto dtos = oatpp::Vector<oatpp::Object<BatchRowDto>>::createShared();
+    for (v_int32 i = 1; i <= 5; i++) {
+      auto dto = BatchRowDto::createShared();
+      dto->id = i;
+      dto->name = "updated_" + oatpp::utils::conversion::int32ToStdStr(i);
+      dto->score = 100.0;
+      dtos->push_back(dto);
+    }
+
+    auto result = executor->executeBatch(queryTemplate, "row", dtos, connection);
+    OATPP_ASSERT(result.affectedRows == 5);
+
+    auto stored = client.selectAll(connection)->fetch<oatpp::Vector<oatpp::Object<BatchRowDto>>>();
+    OATPP_ASSERT(stored[0]->name == "updated_1");
+    OATPP_ASSERT(stored[4]->score == 100.0);
+    OATPP_ASSERT(stored[5]->score == 3.0);
+  }
+
+  // Test statement is usable for single-row execution after a batch
+  {
+    OATPP_LOGI(TAG, "Test single-row execution after batch");
+
+    auto queryTemplate = executor->parseQueryTemplate(
+      "insertRow",
+      "INSERT INTO test_execute_batch (id, name, score) VALUES (:id, :name, :score);",
+      {}, true);
+
+    auto result = executor->execute(queryTemplate,
+                                    {{"id", oatpp::Int32(100)}, {"name", oatpp::String("single")}, {"score", oatpp::Float64(1.0)}},
+                                    nullptr, connection);
+    OATPP_ASSERT(result->isSuccess());
+
+    auto count = client.count(connection)->fetch<oatpp::Vector<oatpp::Object<CountDto>>>();
+    OATPP_ASSERT(count[0]->total == 26);
+  }
+
+  // Test multi-row VALUES expansion
+  {
+    OATPP_LOGI(TAG, "Test multi-row VALUES");
+
+    auto queryTemplate = executor->parseQueryTemplate(
+      "insertRow",
+      "INSERT INTO test_execute_batch (id, name, score) VALUES (:id, :name, :score);",
+      {}, true);
+
+    std::vector<std::unordered_map<oatpp::String, oatpp::Void>> rows;
+    for (v_int32 i = 200; i < 300; i++) {
+      rows.push_back({{"id", oatpp::Int32(i)}, {"name", oatpp::String("multi")}, {"score", oatpp::Float64(2.0)}});
+    }
+
+    // 100 rows in chunks of at most 64 rows, rounded down to powers of two -> 64 + 32 + 4
+    auto result = executor->executeBatch(queryTemplate, rows, connection, 64,
+                                         oatpp::mariadb::Executor::BatchMode::MULTI_ROW_VALUES);
+    OATPP_ASSERT(result.affectedRows == 100);
+    OATPP_ASSERT(result.batchAffectedRows.size() == 3);
+    OATPP_ASSERT(result.batchAffectedRows[0] == 64);
+
+    auto count = client.count(connection)->fetch<oatpp::Vector<oatpp::Object<CountDto>>>();
+    OATPP_ASSERT(count[0]->total == 126);
+
+    bool thrown = false;
+    try {
+      auto updateTemplate = executor->parseQueryTemplate(
+        "updateName",
+        "UPDATE test_execute_batch SET name = :name WHERE id = :id;",
+        {}, true);
+      executor->executeBatch(updateTemplate, rows, connection, 64, oatpp::mariadb::Executor::BatchMode::MULTI_ROW_VALUES);
+    } catch (const std::runtime_error& e) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+  client.dropTable(connection);
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
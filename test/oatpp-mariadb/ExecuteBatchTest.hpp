@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_ExecuteBatchTest_hpp
+#define oatpp_test_mariadb_ExecuteBatchTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class ExecuteBatchTest : public oatpp::test::UnitTest {
+public:
+  ExecuteBatchTest() : UnitTest("TEST[mariadb::ExecuteBatchTest]") {}
+  ~ExecuteBatchTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_ExecuteBatchTest_hpp
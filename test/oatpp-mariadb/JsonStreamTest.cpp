@@ -0,0 +1,122 @@
+#include "JsonStreamTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-mariadb/mapping/JsonHelper.hpp"
+#include "oatpp/core/data/stream/BufferStream.hpp"
+#include "oatpp/parser/json/mapping/ObjectMapper.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::JsonStreamTest]";
+
+constexpr v_int32 ROW_COUNT = 500;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class RowDto : public oatpp::DTO {
+  DTO_INIT(RowDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(Int64, total);
+  DTO_FIELD(UInt64, big);
+  DTO_FIELD(Float64, value);
+  DTO_FIELD(String, name);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::Vector<oatpp::Object<RowDto>> Rows;
+
+}
+
+void JsonStreamTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto connection = executor->getConnection();
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_json_stream", connection);
+  executor->executeRaw("CREATE TABLE test_json_stream (id INT PRIMARY KEY, total BIGINT, big BIGINT UNSIGNED, "
+                       "value DOUBLE, name VARCHAR(64))", connection);
+  executor->executeRaw("INSERT INTO test_json_stream SELECT seq, -CAST(seq AS SIGNED) * 1000000007, 18446744073709551615 - seq, "
+                       "seq / 4, IF(seq % 7 = 0, NULL, CONCAT('row \"', seq, '\"\\\\\\t')) "
+                       "FROM seq_1_to_" + std::to_string(ROW_COUNT), connection);
+
+  auto query = executor->parseQueryTemplate("selectAll",
+    "SELECT id, total, big, value, name FROM test_json_stream ORDER BY id", {}, true);
+
+  oatpp::parser::json::mapping::ObjectMapper objectMapper;
+  oatpp::mariadb::mapping::JsonHelper::setupIntegerSerializers(objectMapper);
+
+  // Exact output of one row
+  {
+    auto single = executor->parseQueryTemplate("selectOne",
+      "SELECT id, total, big, name FROM test_json_stream WHERE id = 1", {}, true);
+    auto result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(executor->execute(single, {}, nullptr, connection));
+    oatpp::data::stream::BufferOutputStream stream;
+    OATPP_ASSERT(result->writeJson(&stream) == 1);
+    OATPP_ASSERT(stream.toString() ==
+      "[{\"id\":1,\"total\":-1000000007,\"big\":18446744073709551614,\"name\":\"row \\\"1\\\"\\\\\\t\"}]");
+  }
+
+  // Same objects as fetch() + JSON serialization
+  {
+    auto expected = std::static_pointer_cast<oatpp::mariadb::QueryResult>(executor->execute(query, {}, nullptr, connection))
+      ->fetch<Rows>();
+
+    auto result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(executor->execute(query, {}, nullptr, connection));
+    oatpp::data::stream::BufferOutputStream stream;
+    OATPP_ASSERT(result->writeJson(&stream) == ROW_COUNT);
+    OATPP_ASSERT(!result->hasMoreToFetch());
+
+    auto rows = objectMapper.readFromString<Rows>(stream.toString());
+    OATPP_ASSERT(rows->size() == expected->size());
+    for (size_t i = 0; i < rows->size(); i++) {
+      OATPP_ASSERT(rows[i]->id == expected[i]->id);
+      OATPP_ASSERT(rows[i]->total == expected[i]->total);
+      OATPP_ASSERT(rows[i]->big == expected[i]->big);
+      OATPP_ASSERT(rows[i]->name == expected[i]->name);
+      OATPP_ASSERT(rows[i]->value && expected[i]->value);
+    }
+    OATPP_ASSERT(rows[6]->name == nullptr);
+  }
+
+  // In windows - each call writes its own array
+  {
+    auto result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(executor->execute(query, {}, nullptr, connection));
+    v_int64 total = 0;
+    while (result->hasMoreToFetch()) {
+      oatpp::data::stream::BufferOutputStream stream;
+      auto written = result->writeJson(&stream, 128);
+      OATPP_ASSERT(written <= 128);
+      OATPP_ASSERT(objectMapper.readFromString<Rows>(stream.toString())->size() == (size_t) written);
+      total += written;
+    }
+    OATPP_ASSERT(total == ROW_COUNT);
+
+    oatpp::data::stream::BufferOutputStream stream;
+    OATPP_ASSERT(result->writeJson(&stream) == 0);
+    OATPP_ASSERT(stream.toString() == "[]");
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_json_stream", connection);
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
@@ -0,0 +1,16 @@
+#ifndef oatpp_test_mariadb_JsonStreamTest_hpp
+#define oatpp_test_mariadb_JsonStreamTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class JsonStreamTest : public oatpp::test::UnitTest {
+public:
+  JsonStreamTest() : UnitTest("TEST[mariadb::JsonStreamTest]") {}
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_JsonStreamTest_hpp
@@ -0,0 +1,122 @@
+#include "MappingPlanTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::MappingPlanTest]";
+
+constexpr v_int32 ROW_COUNT = 100;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class RowDto : public oatpp::DTO {
+  DTO_INIT(RowDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Int64, total);
+  DTO_FIELD(Boolean, active);
+};
+
+class PartialRowDto : public oatpp::DTO {
+  DTO_INIT(PartialRowDto, DTO);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Int32, counter);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(selectRows,
+        "SELECT id, name, total, active FROM test_mapping_plan WHERE id >= :id ORDER BY id;",
+        PARAM(oatpp::Int32, id))
+
+  QUERY(selectReordered,
+        "SELECT active, total, name, id FROM test_mapping_plan ORDER BY id;")
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+void checkRows(const oatpp::Vector<oatpp::Object<RowDto>>& rows, v_int32 firstId) {
+  OATPP_ASSERT(rows->size() == (size_t) (ROW_COUNT - firstId + 1));
+  for (v_int32 i = 0; i < (v_int32) rows->size(); i++) {
+    v_int32 id = firstId + i;
+    OATPP_ASSERT(rows[i]->id == id);
+    OATPP_ASSERT(rows[i]->name == oatpp::String("row-" + std::to_string(id)));
+    if (id % 10 == 0) {
+      OATPP_ASSERT(rows[i]->total == nullptr);
+    } else {
+      OATPP_ASSERT(rows[i]->total == (v_int64) id * 1000000000LL);
+    }
+    OATPP_ASSERT(rows[i]->active == (id % 2 == 0));
+  }
+}
+
+}
+
+void MappingPlanTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto client = TestClient(executor);
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_mapping_plan");
+  executor->executeRaw("CREATE TABLE test_mapping_plan (id INT PRIMARY KEY, name VARCHAR(64), total BIGINT, active BOOLEAN)");
+  executor->executeRaw("INSERT INTO test_mapping_plan "
+                       "SELECT seq, CONCAT('row-', seq), IF(seq % 10 = 0, NULL, seq * 1000000000), seq % 2 = 0 "
+                       "FROM seq_1_to_100");
+
+  // Same template and DTO - the plan is reused across executions
+  for (v_int32 firstId = 1; firstId <= 3; firstId++) {
+    auto result = client.selectRows(firstId);
+    OATPP_ASSERT(result->isSuccess());
+    checkRows(result->fetch<oatpp::Vector<oatpp::Object<RowDto>>>(), firstId);
+  }
+
+  // Same template, another DTO - columns without a property are skipped,
+  // Int32 properties without a column are 0
+  {
+    auto result = client.selectRows(1);
+    auto rows = result->fetch<oatpp::Vector<oatpp::Object<PartialRowDto>>>();
+    OATPP_ASSERT(rows->size() == (size_t) ROW_COUNT);
+    OATPP_ASSERT(rows[0]->name == "row-1");
+    OATPP_ASSERT(rows[0]->counter == 0);
+  }
+
+  // Another column order maps by name
+  {
+    auto result = client.selectReordered();
+    checkRows(result->fetch<oatpp::Vector<oatpp::Object<RowDto>>>(), 1);
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_mapping_plan");
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
@@ -0,0 +1,16 @@
+#ifndef oatpp_test_mariadb_MappingPlanTest_hpp
+#define oatpp_test_mariadb_MappingPlanTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class MappingPlanTest : public oatpp::test::UnitTest {
+public:
+  MappingPlanTest() : UnitTest("TEST[mariadb::MappingPlanTest]") {}
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_MappingPlanTest_hpp
@@ -0,0 +1,142 @@
+#include "MultiResultSetTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::MultiResultSetTest]";
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ItemDto : public oatpp::DTO {
+  DTO_INIT(ItemDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Float64, price);
+  DTO_FIELD(Boolean, active);
+};
+
+class CountDto : public oatpp::DTO {
+  DTO_INIT(CountDto, DTO);
+  DTO_FIELD(Int64, total);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void MultiResultSetTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+
+  auto connection = executor->getConnection();
+
+  {
+    auto setup = executor->executeMulti({
+      "DROP TABLE IF EXISTS test_multi_result_set",
+      "CREATE TABLE test_multi_result_set (id INT PRIMARY KEY, name VARCHAR(50), price DOUBLE, active TINYINT(1))",
+      "INSERT INTO test_multi_result_set VALUES (1, 'apple', 1.5, 1), (2, 'pear', 2.25, 0), (3, NULL, NULL, NULL)"
+    }, connection);
+    OATPP_ASSERT(setup->isSuccess());
+    while (setup->nextResultSet()) {
+      OATPP_ASSERT(setup->isSuccess());
+    }
+    OATPP_ASSERT(setup->getAffectedRows() == 3);
+  }
+
+  // Test several lookups in one round trip
+  {
+    OATPP_LOGI(TAG, "Test several result sets");
+
+    auto result = executor->executeMulti({
+      "SELECT * FROM test_multi_result_set WHERE id = 1;",
+      "SELECT * FROM test_multi_result_set ORDER BY id;",
+      "SELECT COUNT(*) AS total FROM test_multi_result_set;",
+      "UPDATE test_multi_result_set SET price = 3.0 WHERE id = 2;"
+    }, connection);
+
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(result->getResultSetIndex() == 0);
+    OATPP_ASSERT(result->hasMoreResultSets());
+    OATPP_ASSERT(std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object)->isBusy());
+    auto one = result->fetch<oatpp::Vector<oatpp::Object<ItemDto>>>();
+    OATPP_ASSERT(one->size() == 1);
+    OATPP_ASSERT(one[0]->name == "apple");
+    OATPP_ASSERT(one[0]->price == 1.5);
+    OATPP_ASSERT(one[0]->active == true);
+
+    OATPP_ASSERT(result->nextResultSet());
+    OATPP_ASSERT(result->getResultSetIndex() == 1);
+    auto all = result->fetch<oatpp::Vector<oatpp::Object<ItemDto>>>();
+    OATPP_ASSERT(all->size() == 3);
+    OATPP_ASSERT(all[1]->active == false);
+    OATPP_ASSERT(all[2]->name == nullptr);
+    OATPP_ASSERT(all[2]->price == nullptr);
+
+    OATPP_ASSERT(result->nextResultSet());
+    auto count = result->fetch<oatpp::Vector<oatpp::Object<CountDto>>>();
+    OATPP_ASSERT(count[0]->total == 3);
+
+    OATPP_ASSERT(result->nextResultSet());
+    OATPP_ASSERT(!result->hasResultSet());
+    OATPP_ASSERT(result->getAffectedRows() == 1);
+    OATPP_ASSERT(!result->hasMoreResultSets());
+    OATPP_ASSERT(!std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object)->isBusy());
+    OATPP_ASSERT(!result->nextResultSet());
+  }
+
+  // Test unread result sets are drained and the connection stays usable
+  {
+    OATPP_LOGI(TAG, "Test drain");
+
+    {
+      auto result = executor->executeMulti({"SELECT 1", "SELECT 2", "SELECT 3"}, connection);
+      OATPP_ASSERT(result->isSuccess());
+    }
+
+    auto result = executor->executeMulti({"SELECT id, name FROM test_multi_result_set WHERE id = 2"}, connection);
+    auto rows = result->fetch<oatpp::Vector<oatpp::Fields<oatpp::Any>>>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0]["id"].retrieve<oatpp::Int32>() == 2);
+    OATPP_ASSERT(rows[0]["name"].retrieve<oatpp::String>() == "pear");
+  }
+
+  // Test error in the middle statement
+  {
+    OATPP_LOGI(TAG, "Test failing statement");
+
+    auto result = executor->executeMulti({
+      "SELECT 1 AS total",
+      "SELECT * FROM test_multi_result_set_missing",
+      "SELECT 3 AS total"
+    }, connection);
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(result->nextResultSet());
+    OATPP_ASSERT(!result->isSuccess());
+    OATPP_ASSERT(result->getErrorMessage());
+    OATPP_ASSERT(!result->nextResultSet());
+  }
+
+  executor->executeMulti({"DROP TABLE IF EXISTS test_multi_result_set"}, connection);
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
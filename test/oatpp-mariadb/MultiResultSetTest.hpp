@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_MultiResultSetTest_hpp
+#define oatpp_test_mariadb_MultiResultSetTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class MultiResultSetTest : public oatpp::test::UnitTest {
+public:
+  MultiResultSetTest() : UnitTest("TEST[mariadb::MultiResultSetTest]") {}
+  ~MultiResultSetTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_MultiResultSetTest_hpp
@@ -130,6 +130,32 @@ void QueryResultTest::onRun() {
     OATPP_ASSERT(result3 == nullptr);
   }
 
+  // Per-template phase histograms
+  {
+    OATPP_LOGI(TAG, "Test query metrics");
+
+    auto metricsExecutor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+    auto queryMetrics = metricsExecutor->enableQueryMetrics();
+    auto metricsClient = TestClient(metricsExecutor);
+
+    for (v_int32 i = 0; i < 3; i++) {
+      auto rows = metricsClient.selectAll()->fetch<oatpp::Vector<oatpp::Object<TestDto>>>();
+      OATPP_ASSERT(rows->size() == 2);
+    }
+
+    typedef oatpp::mariadb::metrics::TemplateMetrics TemplateMetrics;
+    auto snapshot = queryMetrics->getTemplate("selectAll")->getSnapshot();
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::ACQUIRE).count == 3);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::PREPARE).count == 3);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::BIND).count == 3);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::EXECUTE).count == 3);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::STORE).count == 3);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::MAPPING).count == 3);
+    OATPP_LOGD(TAG, "selectAll execute p50=%lu us", (unsigned long) snapshot.get(TemplateMetrics::Phase::EXECUTE).getPercentile(0.5));
+
+    OATPP_ASSERT(executor->getQueryMetrics() == nullptr);
+  }
+
   // Clean up
   client.dropTable();
 
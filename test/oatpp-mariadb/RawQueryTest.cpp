@@ -0,0 +1,130 @@
+#include "RawQueryTest.hpp"
+#include "utils/EnvLoader.hpp"
+#include "utils/RoundTrips.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::RawQueryTest]";
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ItemDto : public oatpp::DTO {
+  DTO_INIT(ItemDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void RawQueryTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+
+  auto connection = executor->getConnection();
+  auto mysqlConnection = std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object);
+  MYSQL* mysql = mysqlConnection->getHandle();
+
+  // DDL and DML - executed exactly once
+  {
+    executor->executeRaw("DROP TABLE IF EXISTS test_raw_query", connection);
+    executor->executeRaw("CREATE TABLE test_raw_query (id INT PRIMARY KEY, name VARCHAR(50))", connection);
+    auto insert = std::static_pointer_cast<oatpp::mariadb::TextQueryResult>(
+      executor->executeRaw("INSERT INTO test_raw_query VALUES (1, 'one'), (2, 'two')", connection)
+    );
+    OATPP_ASSERT(insert->isSuccess());
+    OATPP_ASSERT(insert->getAffectedRows() == 2);
+  }
+
+  // Rows are mapped to DTOs
+  {
+    auto result = executor->executeRaw("SELECT id, name FROM test_raw_query ORDER BY id", connection);
+    OATPP_ASSERT(result->isSuccess());
+    auto rows = result->fetch<oatpp::Vector<oatpp::Object<ItemDto>>>();
+    OATPP_ASSERT(rows->size() == 2);
+    OATPP_ASSERT(rows[0]->id == 1);
+    OATPP_ASSERT(rows[0]->name == "one");
+    OATPP_ASSERT(rows[1]->id == 2);
+    OATPP_ASSERT(rows[1]->name == "two");
+  }
+
+  // Errors are thrown, the connection stays usable
+  {
+    bool thrown = false;
+    try {
+      executor->executeRaw("SELECT * FROM test_raw_query_missing", connection);
+    } catch (const std::runtime_error& e) {
+      OATPP_LOGD(TAG, "Expected error: %s", e.what());
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+    OATPP_ASSERT(mysqlConnection->isHealthy());
+  }
+
+  // Every statement of a script is checked, nothing is left pending on the connection
+  {
+    bool thrown = false;
+    try {
+      executor->executeRaw("SELECT 1; SELECT * FROM test_raw_query_missing; SELECT 3", connection);
+    } catch (const std::runtime_error& e) {
+      OATPP_LOGD(TAG, "Expected error: %s", e.what());
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+    OATPP_ASSERT(!mysqlConnection->isBusy());
+
+    auto script = executor->executeRaw("SELECT 1 AS id; SELECT 2 AS id", connection);
+    OATPP_ASSERT(!mysqlConnection->isBusy());
+    OATPP_ASSERT(script->fetch<oatpp::Vector<oatpp::Object<ItemDto>>>()[0]->id == 2);
+
+    // a prepared statement right after the script doesn't run into pending results
+    auto countTemplate = executor->parseQueryTemplate("countRaw", "SELECT COUNT(*) AS id FROM test_raw_query", {}, true);
+    auto count = executor->execute(countTemplate, {}, nullptr, connection);
+    OATPP_ASSERT(count->isSuccess());
+  }
+
+  // One round trip per statement - begin/commit and savepoints aren't prepared
+  {
+    auto start = utils::countRoundTrips(mysql);
+    executor->begin(connection);
+    executor->setSavepoint(connection, "sp1");
+    executor->executeRaw("INSERT INTO test_raw_query VALUES (3, 'three')", connection);
+    executor->rollbackToSavepoint(connection, "sp1");
+    executor->releaseSavepoint(connection, "sp1");
+    auto commit = executor->commit(connection);
+    OATPP_ASSERT(commit->isSuccess());
+    auto roundTrips = utils::countRoundTrips(mysql) - start - 1;
+    OATPP_LOGI(TAG, "Round trips for 6 statements: %lld", roundTrips);
+    OATPP_ASSERT(roundTrips == 6);
+
+    auto count = executor->executeRaw("SELECT COUNT(*) AS id FROM test_raw_query", connection);
+    OATPP_ASSERT(count->fetch<oatpp::Vector<oatpp::Object<ItemDto>>>()[0]->id == 2);
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_raw_query", connection);
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
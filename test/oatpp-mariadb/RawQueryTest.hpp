@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_RawQueryTest_hpp
+#define oatpp_test_mariadb_RawQueryTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class RawQueryTest : public oatpp::test::UnitTest {
+public:
+  RawQueryTest() : UnitTest("TEST[mariadb::RawQueryTest]") {}
+  ~RawQueryTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_RawQueryTest_hpp
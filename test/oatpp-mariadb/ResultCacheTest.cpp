@@ -0,0 +1,207 @@
+#include "ResultCacheTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::ResultCacheTest]";
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class CountryDto : public oatpp::DTO {
+  DTO_INIT(CountryDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, code);
+  DTO_FIELD(String, name);
+};
+
+class NameDto : public oatpp::DTO {
+  DTO_INIT(NameDto, DTO);
+  DTO_FIELD(String, name);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(selectCountry,
+        "SELECT id, code, name FROM test_result_cache WHERE code = :code;",
+        PARAM(oatpp::String, code))
+
+  QUERY(selectAllShortLived,
+        "SELECT id, code, name FROM test_result_cache ORDER BY id;")
+
+  QUERY(renameCountry,
+        "UPDATE test_result_cache SET name = :name WHERE code = :code;",
+        PARAM(oatpp::String, code),
+        PARAM(oatpp::String, name))
+
+  QUERY(insertOther,
+        "INSERT INTO test_result_cache_other (id) VALUES (:id);",
+        PARAM(oatpp::Int32, id))
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+typedef oatpp::Vector<oatpp::Object<CountryDto>> Countries;
+
+bool isFromCache(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+  return std::static_pointer_cast<oatpp::mariadb::QueryResult>(result)->isFromCache();
+}
+
+}
+
+void ResultCacheTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+
+  // must be set before the client parses its queries
+  auto cache = executor->enableResultCache();
+  executor->setTemplateResultCache("selectCountry");
+  executor->setTemplateResultCache("selectAllShortLived", std::chrono::milliseconds(50));
+  auto client = TestClient(executor);
+
+  auto connection = executor->getConnection();
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_result_cache", connection);
+  executor->executeRaw("DROP TABLE IF EXISTS test_result_cache_other", connection);
+  executor->executeRaw("CREATE TABLE test_result_cache (id INT PRIMARY KEY, code CHAR(2), name VARCHAR(64))", connection);
+  executor->executeRaw("CREATE TABLE test_result_cache_other (id INT PRIMARY KEY)", connection);
+  executor->executeRaw("INSERT INTO test_result_cache VALUES (1, 'DE', 'Germany'), (2, 'FR', 'France'), (3, 'NL', NULL)", connection);
+
+  // DDL through the executor dropped everything - start counting from here
+  OATPP_ASSERT(cache->getStats().size == 0);
+
+  // miss - executed and recorded once fetched to the end
+  {
+    auto result = client.selectCountry("DE", connection);
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(!isFromCache(result));
+    auto rows = result->fetch<Countries>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0]->name == "Germany");
+    OATPP_ASSERT(cache->getStats().insertions == 1);
+  }
+
+  // hit - no connection needed, rows can be mapped to another type
+  {
+    auto result = client.selectCountry("DE");
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(isFromCache(result));
+    auto rows = result->fetch<Countries>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0]->id == 1);
+    OATPP_ASSERT(rows[0]->code == "DE");
+    OATPP_ASSERT(rows[0]->name == "Germany");
+
+    auto names = client.selectCountry("DE")->fetch<oatpp::Vector<oatpp::Object<NameDto>>>();
+    OATPP_ASSERT(names->size() == 1);
+    OATPP_ASSERT(names[0]->name == "Germany");
+    OATPP_ASSERT(cache->getStats().hits == 2);
+  }
+
+  // NULL values and other parameters are separate entries
+  {
+    auto rows = client.selectCountry("NL", connection)->fetch<Countries>();
+    OATPP_ASSERT(rows[0]->name == nullptr);
+    auto result = client.selectCountry("NL", connection);
+    OATPP_ASSERT(isFromCache(result));
+    OATPP_ASSERT(result->fetch<Countries>()[0]->name == nullptr);
+    OATPP_ASSERT(cache->getStats().size == 2);
+  }
+
+  // a write to another table keeps the entries
+  {
+    client.insertOther(1, connection);
+    OATPP_ASSERT(isFromCache(client.selectCountry("DE", connection)));
+  }
+
+  // a write to the table drops them
+  {
+    auto update = client.renameCountry("DE", "Deutschland", connection);
+    OATPP_ASSERT(update->isSuccess());
+    OATPP_ASSERT(cache->getStats().size == 0);
+
+    auto result = client.selectCountry("DE", connection);
+    OATPP_ASSERT(!isFromCache(result));
+    OATPP_ASSERT(result->fetch<Countries>()[0]->name == "Deutschland");
+    OATPP_ASSERT(isFromCache(client.selectCountry("DE", connection)));
+  }
+
+  // results read only partially are not cached
+  {
+    auto result = client.selectAllShortLived(connection);
+    auto first = result->fetch<Countries>(1);
+    OATPP_ASSERT(first->size() == 1);
+    result.reset();
+    OATPP_ASSERT(!isFromCache(client.selectAllShortLived(connection)));
+  }
+
+  // entries expire after their TTL
+  {
+    OATPP_ASSERT(client.selectAllShortLived(connection)->fetch<Countries>()->size() == 3);
+    OATPP_ASSERT(isFromCache(client.selectAllShortLived(connection)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    OATPP_ASSERT(!isFromCache(client.selectAllShortLived(connection)));
+    OATPP_ASSERT(cache->getStats().expirations >= 1);
+  }
+
+  // reads inside a transaction bypass the cache, writes are invalidated again on commit
+  {
+    OATPP_ASSERT(isFromCache(client.selectCountry("DE", connection)));
+
+    executor->begin(connection);
+    OATPP_ASSERT(!isFromCache(client.selectCountry("DE", connection)));
+    client.renameCountry("DE", "Allemagne", connection);
+
+    // another connection still sees the committed row and caches it
+    auto other = executor->getConnection();
+    OATPP_ASSERT(client.selectCountry("DE", other)->fetch<Countries>()[0]->name == "Deutschland");
+    OATPP_ASSERT(isFromCache(client.selectCountry("DE", other)));
+
+    executor->commit(connection);
+    auto result = client.selectCountry("DE", other);
+    OATPP_ASSERT(!isFromCache(result));
+    OATPP_ASSERT(result->fetch<Countries>()[0]->name == "Allemagne");
+  }
+
+  auto stats = cache->getStats();
+  OATPP_LOGD(TAG, "hits=%llu, misses=%llu, insertions=%llu, invalidations=%llu, bytes=%lld",
+             (unsigned long long) stats.hits, (unsigned long long) stats.misses,
+             (unsigned long long) stats.insertions, (unsigned long long) stats.invalidations,
+             (long long) stats.bytes);
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_result_cache", connection);
+  executor->executeRaw("DROP TABLE IF EXISTS test_result_cache_other", connection);
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_ResultCacheTest_hpp
+#define oatpp_test_mariadb_ResultCacheTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class ResultCacheTest : public oatpp::test::UnitTest {
+public:
+  ResultCacheTest() : UnitTest("TEST[mariadb::ResultCacheTest]") {}
+  ~ResultCacheTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_ResultCacheTest_hpp
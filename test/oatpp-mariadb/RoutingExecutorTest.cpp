@@ -0,0 +1,221 @@
+#include "RoutingExecutorTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-mariadb/TransactionGuard.hpp"
+#include "oatpp/core/async/Executor.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <atomic>
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::RoutingExecutorTest]";
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ItemDto : public oatpp::DTO {
+  DTO_INIT(ItemDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(selectItem,
+        "SELECT id, name FROM test_routing WHERE id = :id;",
+        PARAM(oatpp::Int32, id))
+
+  QUERY(selectItemForUpdate,
+        "SELECT id, name FROM test_routing WHERE id = :id FOR UPDATE;",
+        PARAM(oatpp::Int32, id))
+
+  QUERY(selectItemFresh,
+        "SELECT id, name FROM test_routing WHERE id = :id;",
+        PARAM(oatpp::Int32, id))
+
+  QUERY(insertItem,
+        "INSERT INTO test_routing (id, name) VALUES (:id, :name);",
+        PARAM(oatpp::Int32, id),
+        PARAM(oatpp::String, name))
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+typedef oatpp::Vector<oatpp::Object<ItemDto>> Items;
+
+class SelectCoroutine : public oatpp::async::Coroutine<SelectCoroutine> {
+private:
+  std::shared_ptr<oatpp::mariadb::Executor> m_executor;
+  oatpp::data::share::StringTemplate m_queryTemplate;
+  std::atomic<v_int32>* m_counter;
+public:
+
+  SelectCoroutine(const std::shared_ptr<oatpp::mariadb::Executor>& executor,
+                  const oatpp::data::share::StringTemplate& queryTemplate,
+                  std::atomic<v_int32>* counter)
+    : m_executor(executor)
+    , m_queryTemplate(queryTemplate)
+    , m_counter(counter)
+  {}
+
+  Action act() override {
+    return m_executor->executeAsync(m_queryTemplate, {{"id", oatpp::Int32(1)}}).callbackTo(&SelectCoroutine::onResult);
+  }
+
+  Action onResult(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    OATPP_ASSERT(result->isSuccess());
+    OATPP_ASSERT(result->fetch<Items>()->size() == 1);
+    ++(*m_counter);
+    return finish();
+  }
+
+};
+
+}
+
+void RoutingExecutorTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  // replicas are separate providers of the same server - routing is checked by the counters
+  auto primary = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  std::vector<std::shared_ptr<oatpp::provider::Provider<oatpp::mariadb::Connection>>> replicas = {
+    std::make_shared<oatpp::mariadb::ConnectionProvider>(options),
+    std::make_shared<oatpp::mariadb::ConnectionProvider>(options)
+  };
+
+  {
+    auto executor = std::make_shared<oatpp::mariadb::RoutingExecutor>(primary, replicas);
+    executor->setTemplateRoute("selectItemFresh", oatpp::mariadb::RoutingExecutor::Route::PRIMARY);
+    auto client = TestClient(executor);
+
+    executor->executeRaw("DROP TABLE IF EXISTS test_routing");
+    executor->executeRaw("CREATE TABLE test_routing (id INT PRIMARY KEY, name VARCHAR(64))");
+    OATPP_ASSERT(executor->getReplicaStats()[0].acquisitions == 0);
+    OATPP_ASSERT(executor->getReplicaStats()[1].acquisitions == 0);
+
+    // writes go to the primary
+    OATPP_ASSERT(client.insertItem(1, "one")->isSuccess());
+    OATPP_ASSERT(executor->getPrimaryStats().acquisitions == 3);
+    OATPP_ASSERT(executor->getPrimaryStats().reads == 0);
+
+    // reads go to the replicas in turn
+    for (v_int32 i = 0; i < 4; i++) {
+      auto rows = client.selectItem(1)->fetch<Items>();
+      OATPP_ASSERT(rows->size() == 1);
+      OATPP_ASSERT(rows[0]->name == "one");
+    }
+    OATPP_ASSERT(executor->getReplicaStats()[0].reads == 2);
+    OATPP_ASSERT(executor->getReplicaStats()[1].reads == 2);
+    OATPP_ASSERT(executor->getReplicaStats()[0].inFlight == 0);
+    OATPP_ASSERT(executor->getReplicaStats()[1].inFlight == 0);
+
+    // locking reads and templates routed explicitly stay on the primary
+    client.selectItemForUpdate(1)->fetch<Items>();
+    client.selectItemFresh(1)->fetch<Items>();
+    OATPP_ASSERT(executor->getPrimaryStats().acquisitions == 5);
+    OATPP_ASSERT(executor->getReplicaStats()[0].reads + executor->getReplicaStats()[1].reads == 4);
+
+    // everything inside a transaction runs on its primary connection
+    {
+      oatpp::mariadb::TransactionGuard guard(executor, 1);
+      OATPP_ASSERT(executor->getPrimaryStats().inFlight == 1);
+      OATPP_ASSERT(client.insertItem(2, "two", guard.getConnection())->isSuccess());
+      auto rows = client.selectItem(2, guard.getConnection())->fetch<Items>();
+      OATPP_ASSERT(rows->size() == 1);
+      OATPP_ASSERT(guard.execute([](const oatpp::provider::ResourceHandle<oatpp::orm::Connection>&) { return true; }));
+    }
+    OATPP_ASSERT(executor->getPrimaryStats().acquisitions == 6);
+    OATPP_ASSERT(executor->getReplicaStats()[0].reads + executor->getReplicaStats()[1].reads == 4);
+
+    executor->executeRaw("DROP TABLE IF EXISTS test_routing");
+  }
+
+  // least in flight - a replica held by an unread result is skipped
+  {
+    auto executor = std::make_shared<oatpp::mariadb::RoutingExecutor>(
+      primary, replicas, oatpp::mariadb::RoutingExecutor::Balancing::LEAST_IN_FLIGHT
+    );
+    auto client = TestClient(executor);
+
+    executor->executeRaw("DROP TABLE IF EXISTS test_routing");
+    executor->executeRaw("CREATE TABLE test_routing (id INT PRIMARY KEY, name VARCHAR(64))");
+    client.insertItem(1, "one");
+
+    auto held = client.selectItem(1);
+    auto stats = executor->getReplicaStats();
+    OATPP_ASSERT(stats[0].inFlight + stats[1].inFlight == 1);
+    const v_uint64 heldReplica = stats[0].inFlight == 1 ? 0 : 1;
+
+    for (v_int32 i = 0; i < 3; i++) {
+      client.selectItem(1)->fetch<Items>();
+    }
+    stats = executor->getReplicaStats();
+    OATPP_ASSERT(stats[heldReplica].reads == 1);
+    OATPP_ASSERT(stats[1 - heldReplica].reads == 3);
+
+    held.reset();
+    stats = executor->getReplicaStats();
+    OATPP_ASSERT(stats[0].inFlight == 0);
+    OATPP_ASSERT(stats[1].inFlight == 0);
+
+    executor->executeRaw("DROP TABLE IF EXISTS test_routing");
+  }
+
+  // async reads fail over to the remaining replicas, then to the primary
+  {
+    auto badOptions = options;
+    badOptions.password = "wrong_password";
+    std::vector<std::shared_ptr<oatpp::provider::Provider<oatpp::mariadb::Connection>>> badReplicas = {
+      std::make_shared<oatpp::mariadb::ConnectionProvider>(badOptions),
+      std::make_shared<oatpp::mariadb::ConnectionProvider>(badOptions)
+    };
+    auto executor = std::make_shared<oatpp::mariadb::RoutingExecutor>(primary, badReplicas);
+
+    executor->executeRaw("DROP TABLE IF EXISTS test_routing");
+    executor->executeRaw("CREATE TABLE test_routing (id INT PRIMARY KEY, name VARCHAR(64))");
+    TestClient(executor).insertItem(1, "one");
+
+    auto select = executor->parseQueryTemplate("selectItemAsync", "SELECT id, name FROM test_routing WHERE id = :id", {}, true);
+    std::atomic<v_int32> counter(0);
+    oatpp::async::Executor asyncExecutor(1, 1, 1);
+    asyncExecutor.execute<SelectCoroutine>(executor, select, &counter);
+    asyncExecutor.waitTasksFinished();
+    asyncExecutor.stop();
+    asyncExecutor.join();
+
+    OATPP_ASSERT(counter == 1);
+    OATPP_ASSERT(executor->getReplicaStats()[0].failures == 1);
+    OATPP_ASSERT(executor->getReplicaStats()[1].failures == 1);
+    OATPP_ASSERT(executor->getPrimaryStats().reads == 1);
+
+    executor->executeRaw("DROP TABLE IF EXISTS test_routing");
+  }
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_RoutingExecutorTest_hpp
+#define oatpp_test_mariadb_RoutingExecutorTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class RoutingExecutorTest : public oatpp::test::UnitTest {
+public:
+  RoutingExecutorTest() : UnitTest("TEST[mariadb::RoutingExecutorTest]") {}
+  ~RoutingExecutorTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_RoutingExecutorTest_hpp
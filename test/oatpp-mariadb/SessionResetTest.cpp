@@ -0,0 +1,155 @@
+#include "SessionResetTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-mariadb/ql_template/Parser.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::SessionResetTest]";
+
+typedef oatpp::provider::ResourceHandle<oatpp::mariadb::Connection> ConnectionHandle;
+
+unsigned long getThreadId(const ConnectionHandle& connection) {
+  return mysql_thread_id(connection.object->getHandle());
+}
+
+// queried directly on the handle so the check itself doesn't mark the session dirty
+bool queryValue(const ConnectionHandle& connection, const char* query, std::string& value) {
+  MYSQL* mysql = connection.object->getHandle();
+  if (mysql_query(mysql, query) != 0) {
+    return false;
+  }
+  MYSQL_RES* res = mysql_store_result(mysql);
+  if (!res) {
+    return false;
+  }
+  MYSQL_ROW row = mysql_fetch_row(res);
+  value = (row && row[0]) ? row[0] : "NULL";
+  mysql_free_result(res);
+  return true;
+}
+
+}
+
+void SessionResetTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+
+  oatpp::mariadb::ConnectionPool::Config config;
+  config.maxConnections = 1;
+  auto pool = oatpp::mariadb::ConnectionPool::createShared(connectionProvider, config);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(pool);
+
+  unsigned long threadId;
+  std::string value;
+
+  // clean session - no reset, cached statements are kept
+  {
+    auto connection = pool->get();
+    threadId = getThreadId(connection);
+    executor->executeRaw("SELECT 1", connection);
+    auto& statementCache = connection.object->getStatementCache();
+    MYSQL* mysql = connection.object->getHandle();
+    statementCache.release(mysql, "SELECT 1", statementCache.acquire(mysql, "SELECT 1"));
+    OATPP_ASSERT(!connection.object->isSessionDirty());
+  }
+  {
+    auto connection = pool->get();
+    OATPP_ASSERT(getThreadId(connection) == threadId);
+    OATPP_ASSERT(connection.object->getStatementCache().getStats().size == 1);
+  }
+
+  // user variables
+  {
+    auto connection = pool->get();
+    executor->executeRaw("SET @session_reset_test = 42", connection);
+    OATPP_ASSERT(connection.object->isSessionDirty());
+  }
+  {
+    auto connection = pool->get();
+    OATPP_ASSERT(getThreadId(connection) == threadId);
+    OATPP_ASSERT(!connection.object->isSessionDirty());
+    OATPP_ASSERT(connection.object->getStatementCache().getStats().size == 0);
+    OATPP_ASSERT(queryValue(connection, "SELECT @session_reset_test", value));
+    OATPP_ASSERT(value == "NULL");
+  }
+
+  // temporary tables
+  {
+    auto connection = pool->get();
+    executor->executeRaw("CREATE TEMPORARY TABLE test_session_reset (id INT)", connection);
+    OATPP_ASSERT(connection.object->isSessionDirty());
+  }
+  {
+    auto connection = pool->get();
+    OATPP_ASSERT(getThreadId(connection) == threadId);
+    OATPP_ASSERT(!queryValue(connection, "SELECT COUNT(*) FROM test_session_reset", value));
+  }
+
+  // isolation level left behind by migrateSchema()
+  {
+    auto connection = pool->get();
+    executor->executeRaw("SET SESSION TRANSACTION ISOLATION LEVEL SERIALIZABLE", connection);
+  }
+  {
+    auto connection = pool->get();
+    OATPP_ASSERT(getThreadId(connection) == threadId);
+    OATPP_ASSERT(queryValue(connection, "SELECT @@SESSION.tx_isolation = @@GLOBAL.tx_isolation", value));
+    OATPP_ASSERT(value == "1");
+  }
+
+  // transaction left open
+  {
+    auto connection = pool->get();
+    executor->begin(connection);
+    OATPP_ASSERT(connection.object->isInTransaction());
+    OATPP_ASSERT(!connection.object->isSessionDirty());
+  }
+  {
+    auto connection = pool->get();
+    OATPP_ASSERT(getThreadId(connection) == threadId);
+    OATPP_ASSERT(!connection.object->isInTransaction());
+  }
+
+  // session changes are detected lexically
+  {
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("SET NAMES utf8mb4"));
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("/* c */ use test"));
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("LOCK TABLES t WRITE"));
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("SELECT a INTO @a FROM t"));
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("SELECT GET_LOCK('x', 0)"));
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("DROP TEMPORARY TABLE t"));
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("SELECT 1; USE test"));
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("DELETE FROM t; SET SESSION sql_mode=''"));
+    OATPP_ASSERT(oatpp::mariadb::ql_template::Parser::changesSession("CREATE TABLE t (a INT); /* c */ use other_db"));
+    OATPP_ASSERT(!oatpp::mariadb::ql_template::Parser::changesSession("SELECT @@version"));
+    OATPP_ASSERT(!oatpp::mariadb::ql_template::Parser::changesSession("SELECT '@a', `SET` FROM t"));
+    OATPP_ASSERT(!oatpp::mariadb::ql_template::Parser::changesSession("UPDATE t SET a = 1"));
+    OATPP_ASSERT(!oatpp::mariadb::ql_template::Parser::changesSession("START TRANSACTION"));
+    OATPP_ASSERT(!oatpp::mariadb::ql_template::Parser::changesSession("SELECT ';SET'; UPDATE t SET a = 1"));
+  }
+
+  pool->stop();
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
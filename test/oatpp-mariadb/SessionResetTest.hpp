@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_SessionResetTest_hpp
+#define oatpp_test_mariadb_SessionResetTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class SessionResetTest : public oatpp::test::UnitTest {
+public:
+  SessionResetTest() : UnitTest("TEST[mariadb::SessionResetTest]") {}
+  ~SessionResetTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_SessionResetTest_hpp
@@ -0,0 +1,176 @@
+#include "StatementCacheTest.hpp"
+#include "utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::StatementCacheTest]";
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class TestDto : public oatpp::DTO {
+  DTO_INIT(TestDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(createTable,
+        "CREATE TABLE IF NOT EXISTS test_statement_cache ("
+        "  id INT PRIMARY KEY,"
+        "  name VARCHAR(50)"
+        ");")
+
+  QUERY(dropTable, "DROP TABLE IF EXISTS test_statement_cache;")
+
+  QUERY(insertValue,
+        "INSERT INTO test_statement_cache (id, name) VALUES (:id, :name);",
+        PARAM(oatpp::Int32, id),
+        PARAM(oatpp::String, name))
+
+  QUERY(selectById,
+        "SELECT * FROM test_statement_cache WHERE id = :id;",
+        PARAM(oatpp::Int32, id))
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+}
+
+void StatementCacheTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+  options.statementCacheSize = 2;
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto client = TestClient(executor);
+
+  auto connection = executor->getConnection();
+  auto mariadbConnection = std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object);
+  auto& cache = mariadbConnection->getStatementCache();
+
+  client.dropTable(connection);
+  client.createTable(connection);
+
+  // Test statement reuse
+  {
+    OATPP_LOGI(TAG, "Test statement reuse");
+
+    auto before = cache.getStats();
+
+    for (v_int32 i = 1; i <= 5; i++) {
+      auto result = client.insertValue(i, "name_" + oatpp::utils::conversion::int32ToStdStr(i), connection);
+      OATPP_ASSERT(result->isSuccess());
+    }
+
+    auto after = cache.getStats();
+    OATPP_ASSERT(after.misses - before.misses == 1);
+    OATPP_ASSERT(after.hits - before.hits == 4);
+
+    for (v_int32 i = 1; i <= 5; i++) {
+      auto result = client.selectById(i, connection);
+      OATPP_ASSERT(result->isSuccess());
+      auto rows = result->fetch<oatpp::Vector<oatpp::Object<TestDto>>>();
+      OATPP_ASSERT(rows->size() == 1);
+      OATPP_ASSERT(rows[0]->id == i);
+    }
+
+    after = cache.getStats();
+    OATPP_ASSERT(after.hits - before.hits == 8);
+    // cleanly executed statements are reused without a COM_STMT_RESET round trip
+    OATPP_ASSERT(after.resets == before.resets);
+  }
+
+  // Test statement reset after a failed execute
+  {
+    OATPP_LOGI(TAG, "Test reset after failure");
+
+    auto before = cache.getStats();
+    auto failed = client.insertValue(1, "duplicate", connection);
+    OATPP_ASSERT(!failed->isSuccess());
+    failed.reset();
+
+    auto result = client.insertValue(6, "name_6", connection);
+    OATPP_ASSERT(result->isSuccess());
+
+    auto after = cache.getStats();
+    OATPP_ASSERT(after.resets - before.resets == 1);
+  }
+
+  // Test statement checked out by a live result is not shared
+  {
+    OATPP_LOGI(TAG, "Test concurrent results of the same template");
+
+    auto before = cache.getStats();
+    auto result1 = client.selectById(1, connection);
+    auto result2 = client.selectById(2, connection);
+
+    auto rows1 = result1->fetch<oatpp::Vector<oatpp::Object<TestDto>>>();
+    auto rows2 = result2->fetch<oatpp::Vector<oatpp::Object<TestDto>>>();
+    OATPP_ASSERT(rows1->size() == 1 && rows1[0]->id == 1);
+    OATPP_ASSERT(rows2->size() == 1 && rows2[0]->id == 2);
+
+    auto after = cache.getStats();
+    OATPP_ASSERT(after.hits - before.hits == 1);
+    OATPP_ASSERT(after.misses - before.misses == 1);
+  }
+
+  // Test LRU eviction
+  {
+    OATPP_LOGI(TAG, "Test eviction");
+
+    auto before = cache.getStats();
+    client.createTable(connection);
+    client.dropTable(connection);
+    client.createTable(connection);
+
+    auto after = cache.getStats();
+    OATPP_ASSERT(after.size <= 2);
+    OATPP_ASSERT(after.evictions > before.evictions);
+  }
+
+  // Test invalidation on handle change
+  {
+    OATPP_LOGI(TAG, "Test invalidation");
+
+    auto before = cache.getStats();
+    OATPP_ASSERT(before.size > 0);
+    cache.clear();
+    auto after = cache.getStats();
+    OATPP_ASSERT(after.size == 0);
+    OATPP_ASSERT(after.invalidations == before.invalidations + 1);
+  }
+
+  client.dropTable(connection);
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}
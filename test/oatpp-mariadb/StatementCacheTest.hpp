@@ -0,0 +1,17 @@
+#ifndef oatpp_test_mariadb_StatementCacheTest_hpp
+#define oatpp_test_mariadb_StatementCacheTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb {
+
+class StatementCacheTest : public oatpp::test::UnitTest {
+public:
+  StatementCacheTest() : UnitTest("TEST[mariadb::StatementCacheTest]") {}
+  ~StatementCacheTest() override = default;
+  void onRun() override;
+};
+
+}}}
+
+#endif // oatpp_test_mariadb_StatementCacheTest_hpp
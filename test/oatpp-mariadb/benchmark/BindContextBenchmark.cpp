@@ -0,0 +1,152 @@
+#include "BindContextBenchmark.hpp"
+#include "../utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-mariadb/mapping/Serializer.hpp"
+#include "oatpp-test/Checker.hpp"
+#include "oatpp/core/utils/ConversionUtils.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::benchmark::BindContextBenchmark]";
+
+constexpr v_int32 SERIALIZE_ITERATIONS = 1000000;
+constexpr v_int32 THREAD_COUNT = 8;
+constexpr v_int32 QUERIES_PER_THREAD = 500;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class ValuesDto : public oatpp::DTO {
+  DTO_INIT(ValuesDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Float64, score);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(selectValues,
+        "SELECT :id AS id, :name AS name, :score AS score;",
+        PARAM(oatpp::Int32, id),
+        PARAM(oatpp::String, name),
+        PARAM(oatpp::Float64, score))
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+oatpp::String makeName(v_int32 thread, v_int32 index) {
+  return "thread_" + oatpp::utils::conversion::int32ToStdStr(thread) + "_" + oatpp::utils::conversion::int32ToStdStr(index);
+}
+
+}
+
+void BindContextBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "Benchmark started");
+
+  // Serialization only - no server involved
+  {
+    oatpp::mariadb::mapping::Serializer serializer;
+    oatpp::Int32 id = 42;
+    oatpp::String name = "some name of a typical length";
+    oatpp::Float64 score = 0.5;
+    oatpp::Boolean flag = true;
+    oatpp::Int64 nullValue;
+
+    v_uint32 heapBlocks = 0;
+    {
+      oatpp::test::PerformanceChecker checker("Serialize 5 parameters into a BindContext");
+      for (v_int32 i = 0; i < SERIALIZE_ITERATIONS; i++) {
+        oatpp::mariadb::mapping::Serializer::BindContext context(5);
+        serializer.serialize(context, 0, id);
+        serializer.serialize(context, 1, name);
+        serializer.serialize(context, 2, score);
+        serializer.serialize(context, 3, flag);
+        serializer.serialize(context, 4, nullValue);
+        heapBlocks += context.getHeapBlockCount();
+      }
+    }
+
+    OATPP_LOGI(TAG, "Heap blocks allocated by %d contexts: %u", SERIALIZE_ITERATIONS, heapBlocks);
+    OATPP_ASSERT(heapBlocks == 0);
+
+    // strings are bound in place, not copied
+    oatpp::mariadb::mapping::Serializer::BindContext context(5);
+    serializer.serialize(context, 1, name);
+    serializer.serialize(context, 4, nullValue);
+    OATPP_ASSERT(context.getBind(1).buffer == name->data());
+    OATPP_ASSERT(*context.getBind(4).is_null);
+    OATPP_ASSERT(*context.getBind(0).is_null); // not serialized - NULL
+  }
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto client = std::make_shared<TestClient>(executor);
+
+  std::atomic<v_int32> mismatches(0);
+
+  {
+    oatpp::test::PerformanceChecker checker("Concurrent parameterized queries through one executor");
+
+    std::vector<std::thread> threads;
+    for (v_int32 t = 0; t < THREAD_COUNT; t++) {
+      threads.emplace_back([t, client, &mismatches] {
+        auto connection = client->getConnection();
+        for (v_int32 i = 0; i < QUERIES_PER_THREAD; i++) {
+          auto name = makeName(t, i);
+          auto result = client->selectValues(t * QUERIES_PER_THREAD + i, name, (v_float64) i / 4, connection);
+          if (!result->isSuccess()) {
+            ++mismatches;
+            continue;
+          }
+          auto rows = result->fetch<oatpp::Vector<oatpp::Object<ValuesDto>>>();
+          if (rows->size() != 1 ||
+              rows[0]->id != t * QUERIES_PER_THREAD + i ||
+              rows[0]->name != name ||
+              rows[0]->score != (v_float64) i / 4)
+          {
+            ++mismatches;
+          }
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  OATPP_LOGI(TAG, "Queries: %d, mismatched results: %d", THREAD_COUNT * QUERIES_PER_THREAD, mismatches.load());
+  OATPP_ASSERT(mismatches == 0);
+
+  OATPP_LOGI(TAG, "Benchmark finished");
+
+}
+
+}}}}
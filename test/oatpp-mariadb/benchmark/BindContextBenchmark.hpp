@@ -0,0 +1,22 @@
+#ifndef oatpp_test_mariadb_benchmark_BindContextBenchmark_hpp
+#define oatpp_test_mariadb_benchmark_BindContextBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+/**
+ * Parameter binding with per-call bind contexts. <br>
+ * Measures serialization of typical parameter sets into a &id:oatpp::mariadb::mapping::Serializer::BindContext;
+ * and executes parameterized queries from many threads through one executor, checking that every thread
+ * reads back exactly its own parameters.
+ */
+class BindContextBenchmark : public oatpp::test::UnitTest {
+public:
+  BindContextBenchmark() : UnitTest("TEST[mariadb::benchmark::BindContextBenchmark]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_benchmark_BindContextBenchmark_hpp
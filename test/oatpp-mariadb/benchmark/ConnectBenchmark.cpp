@@ -0,0 +1,121 @@
+#include "ConnectBenchmark.hpp"
+#include "../utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-test/Checker.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::benchmark::ConnectBenchmark]";
+
+constexpr v_int32 ITERATIONS = 200;
+
+std::string queryValue(MYSQL* mysql, const char* query) {
+  std::string value;
+  if (mysql_query(mysql, query) == 0) {
+    MYSQL_RES* res = mysql_store_result(mysql);
+    if (res) {
+      MYSQL_ROW row = mysql_fetch_row(res);
+      if (row && row[0]) {
+        value = row[0];
+      }
+      mysql_free_result(res);
+    }
+  }
+  return value;
+}
+
+// average microseconds per connect, connections are closed right away
+v_int64 measureConnect(const char* name, const std::function<void()>& connect) {
+  auto start = std::chrono::steady_clock::now();
+  {
+    oatpp::test::PerformanceChecker checker(name);
+    for (v_int32 i = 0; i < ITERATIONS; i++) {
+      connect();
+    }
+  }
+  auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+  v_int64 average = elapsed.count() / ITERATIONS;
+  OATPP_LOGI(TAG, "%s: %lld us per connect", name, (long long) average);
+  return average;
+}
+
+}
+
+void ConnectBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "Benchmark started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+  options.connectTimeout = std::chrono::seconds(5);
+
+  // character set and init commands are applied during connect
+  {
+    auto initOptions = options;
+    initOptions.initCommands = {"SET time_zone = '+00:00'", "SET @connect_benchmark = 1"};
+    auto connection = oatpp::mariadb::ConnectionProvider(initOptions).get();
+    MYSQL* mysql = connection.object->getHandle();
+    OATPP_ASSERT(queryValue(mysql, "SELECT @@session.time_zone") == "+00:00");
+    OATPP_ASSERT(queryValue(mysql, "SELECT @connect_benchmark") == "1");
+    OATPP_ASSERT(queryValue(mysql, "SELECT @@character_set_client").compare(0, 4, "utf8") == 0);
+  }
+
+  auto tcpProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  measureConnect("TCP connect, character set in handshake", [&] {
+    OATPP_ASSERT(tcpProvider->get());
+  });
+
+  // what ConnectionProvider::get() did before - SET NAMES round trip after connect
+  auto defaultCharsetOptions = options;
+  defaultCharsetOptions.charset = nullptr;
+  auto legacyProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(defaultCharsetOptions);
+  measureConnect("TCP connect, character set after connect", [&] {
+    auto connection = legacyProvider->get();
+    OATPP_ASSERT(mysql_set_character_set(connection.object->getHandle(), "utf8") == 0);
+  });
+
+  auto compressedOptions = options;
+  compressedOptions.compress = true;
+  auto compressedProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(compressedOptions);
+  measureConnect("TCP connect, compressed protocol", [&] {
+    OATPP_ASSERT(compressedProvider->get());
+  });
+
+  auto socketOptions = options;
+  socketOptions.unixSocket = env.get("MARIADB_SOCKET", "/run/mysqld/mysqld.sock");
+  auto socketProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(socketOptions);
+  bool socketAvailable = true;
+  try {
+    socketProvider->get();
+  } catch (const std::exception& e) {
+    OATPP_LOGW(TAG, "Unix socket '%s' is not available, skipping: %s", socketOptions.unixSocket->c_str(), e.what());
+    socketAvailable = false;
+  }
+
+  if (socketAvailable) {
+    measureConnect("Unix socket connect, character set in handshake", [&] {
+      OATPP_ASSERT(socketProvider->get());
+    });
+  }
+
+  OATPP_LOGI(TAG, "Benchmark finished");
+
+}
+
+}}}}
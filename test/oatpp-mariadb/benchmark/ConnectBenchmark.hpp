@@ -0,0 +1,21 @@
+#ifndef oatpp_test_mariadb_benchmark_ConnectBenchmark_hpp
+#define oatpp_test_mariadb_benchmark_ConnectBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+/**
+ * Measures connect latency of &id:oatpp::mariadb::ConnectionProvider; over TCP and over the unix socket,
+ * and the cost of setting the character set after connect instead of during the handshake.
+ * The socket path is taken from `MARIADB_SOCKET`; the socket runs are skipped if it can't be connected.
+ */
+class ConnectBenchmark : public oatpp::test::UnitTest {
+public:
+  ConnectBenchmark() : UnitTest("TEST[mariadb::benchmark::ConnectBenchmark]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_benchmark_ConnectBenchmark_hpp
@@ -0,0 +1,118 @@
+#include "RoundTripBenchmark.hpp"
+#include "../utils/EnvLoader.hpp"
+#include "../utils/RoundTrips.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-mariadb/QueryResult.hpp"
+#include "oatpp-test/Checker.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::benchmark::RoundTripBenchmark]";
+
+constexpr v_int32 ITERATIONS = 1000;
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(selectValue,
+        "SELECT :value AS value;",
+        PARAM(oatpp::Int32, value))
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+// What QueryResult did before every statement execute
+void legacyTransactionProbe(MYSQL* mysql) {
+  if (mysql_query(mysql, "SELECT IF(@@in_transaction, 'true', 'false') as in_transaction") == 0) {
+    MYSQL_RES* res = mysql_store_result(mysql);
+    if (res) {
+      mysql_free_result(res);
+    }
+  }
+}
+
+}
+
+void RoundTripBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "Benchmark started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto client = TestClient(executor);
+
+  auto connection = executor->getConnection();
+  MYSQL* mysql = std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object)->getHandle();
+
+  // warm up the statement cache so both runs measure execute only
+  client.selectValue(0, connection);
+
+  v_int64 legacyRoundTrips;
+  {
+    oatpp::test::PerformanceChecker checker("Legacy: @@in_transaction probe + execute");
+    auto start = utils::countRoundTrips(mysql);
+    for (v_int32 i = 0; i < ITERATIONS; i++) {
+      legacyTransactionProbe(mysql);
+      auto result = client.selectValue(i, connection);
+      OATPP_ASSERT(result->isSuccess());
+    }
+    legacyRoundTrips = utils::countRoundTrips(mysql) - start - 1;
+  }
+
+  v_int64 currentRoundTrips;
+  {
+    oatpp::test::PerformanceChecker checker("Current: server status flags + execute");
+    auto start = utils::countRoundTrips(mysql);
+    for (v_int32 i = 0; i < ITERATIONS; i++) {
+      auto result = client.selectValue(i, connection);
+      OATPP_ASSERT(result->isSuccess());
+    }
+    currentRoundTrips = utils::countRoundTrips(mysql) - start - 1;
+  }
+
+  OATPP_LOGI(TAG, "Round trips per query: legacy=%.2f, current=%.2f",
+             (double) legacyRoundTrips / ITERATIONS, (double) currentRoundTrips / ITERATIONS);
+  OATPP_ASSERT(currentRoundTrips < legacyRoundTrips);
+  OATPP_ASSERT(currentRoundTrips <= ITERATIONS);
+
+  // Transaction state is still tracked correctly
+  {
+    auto result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(client.selectValue(1, connection));
+    OATPP_ASSERT(!result->isInTransaction());
+
+    executor->begin(connection);
+    result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(client.selectValue(1, connection));
+    OATPP_ASSERT(result->isInTransaction());
+
+    executor->commit(connection);
+    result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(client.selectValue(1, connection));
+    OATPP_ASSERT(!result->isInTransaction());
+  }
+
+  OATPP_LOGI(TAG, "Benchmark finished");
+
+}
+
+}}}}
@@ -0,0 +1,21 @@
+#ifndef oatpp_test_mariadb_benchmark_RoundTripBenchmark_hpp
+#define oatpp_test_mariadb_benchmark_RoundTripBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+/**
+ * Counts server round trips per executed query - see &id:oatpp::test::mariadb::utils::countRoundTrips;.
+ * Compares the legacy `@@in_transaction` probe before every statement with
+ * transaction state taken from the server status flags.
+ */
+class RoundTripBenchmark : public oatpp::test::UnitTest {
+public:
+  RoundTripBenchmark() : UnitTest("TEST[mariadb::benchmark::RoundTripBenchmark]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_benchmark_RoundTripBenchmark_hpp
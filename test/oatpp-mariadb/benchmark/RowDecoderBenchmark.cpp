@@ -0,0 +1,120 @@
+#include "RowDecoderBenchmark.hpp"
+#include "../utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-test/Checker.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <chrono>
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::benchmark::RowDecoderBenchmark]";
+
+constexpr v_int32 ROW_COUNT = 200000;
+constexpr v_int32 ROUNDS = 3;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class RowDto : public oatpp::DTO {
+  DTO_INIT(RowDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(Int64, total);
+  DTO_FIELD(Float64, value);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Boolean, active);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+typedef oatpp::Vector<oatpp::Object<RowDto>> Rows;
+
+// Maps the stored result with `read` and returns rows per second
+template<typename F>
+v_float64 measure(const char* name, F read) {
+  oatpp::test::PerformanceChecker checker(name);
+  auto start = std::chrono::steady_clock::now();
+  Rows rows = read();
+  auto elapsed = std::chrono::duration<v_float64>(std::chrono::steady_clock::now() - start).count();
+  OATPP_ASSERT(rows->size() == (size_t) ROW_COUNT);
+  return rows->size() / elapsed;
+}
+
+}
+
+void RowDecoderBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "Benchmark started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto connection = executor->getConnection();
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_row_decoder", connection);
+  executor->executeRaw("CREATE TABLE test_row_decoder (id INT PRIMARY KEY, total BIGINT, value DOUBLE, "
+                       "name VARCHAR(64), active BOOLEAN)", connection);
+  executor->executeRaw("INSERT INTO test_row_decoder SELECT seq, seq * 1000000007, seq / 7, "
+                       "CONCAT('name_of_row_', seq), IF(seq % 5 = 0, NULL, seq % 2) FROM seq_1_to_" +
+                       std::to_string(ROW_COUNT), connection);
+
+  auto query = executor->parseQueryTemplate("selectAll",
+    "SELECT id, total, value, name, active FROM test_row_decoder ORDER BY id", {}, true);
+
+  auto execute = [&] {
+    auto result = std::static_pointer_cast<oatpp::mariadb::QueryResult>(executor->execute(query, {}, nullptr, connection));
+    OATPP_ASSERT(result->isSuccess());
+    return result;
+  };
+
+  v_float64 genericRate = 0;
+  v_float64 typedRate = 0;
+
+  for (v_int32 round = 0; round < ROUNDS; round++) {
+
+    {
+      auto result = execute();
+      genericRate += measure("Generic readRowsAsObject", [&] { return result->fetch<Rows>(); });
+    }
+
+    {
+      auto result = execute();
+      typedRate += measure("Typed readRowsAs<RowDto>", [&] { return result->fetchAs<RowDto>(); });
+    }
+
+  }
+
+  OATPP_LOGI(TAG, "Rows/sec: generic=%.0f, typed=%.0f (x%.2f)",
+             genericRate / ROUNDS, typedRate / ROUNDS, typedRate / genericRate);
+
+  // Both paths produce the same objects
+  {
+    auto generic = execute()->fetch<Rows>();
+    auto typed = execute()->fetchAs<RowDto>();
+    OATPP_ASSERT(generic->size() == typed->size());
+    for (size_t i = 0; i < generic->size(); i++) {
+      OATPP_ASSERT(generic[i]->id == typed[i]->id);
+      OATPP_ASSERT(generic[i]->total == typed[i]->total);
+      OATPP_ASSERT(generic[i]->value == typed[i]->value);
+      OATPP_ASSERT(generic[i]->name == typed[i]->name);
+      OATPP_ASSERT(generic[i]->active == typed[i]->active);
+    }
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_row_decoder", connection);
+
+  OATPP_LOGI(TAG, "Benchmark finished");
+
+}
+
+}}}}
@@ -0,0 +1,20 @@
+#ifndef oatpp_test_mariadb_benchmark_RowDecoderBenchmark_hpp
+#define oatpp_test_mariadb_benchmark_RowDecoderBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+/**
+ * Rows/sec of mapping a stored 200K-row result to DTOs with the generic `fetch<oatpp::Vector<oatpp::Object<Dto>>>()`
+ * vs. the typed &id:oatpp::mariadb::QueryResult::fetchAs;. Only mapping is timed - the result is stored before.
+ */
+class RowDecoderBenchmark : public oatpp::test::UnitTest {
+public:
+  RowDecoderBenchmark() : UnitTest("TEST[mariadb::benchmark::RowDecoderBenchmark]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_benchmark_RowDecoderBenchmark_hpp
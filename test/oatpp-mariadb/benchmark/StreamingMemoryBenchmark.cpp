@@ -0,0 +1,123 @@
+#include "StreamingMemoryBenchmark.hpp"
+#include "../utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-test/Checker.hpp"
+#include "oatpp/core/Types.hpp"
+
+#include <sys/resource.h>
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::benchmark::StreamingMemoryBenchmark]";
+
+constexpr v_int32 ROW_COUNT = 1000000;
+constexpr v_int64 WINDOW_SIZE = 1000;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class RowDto : public oatpp::DTO {
+  DTO_INIT(RowDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+  DTO_FIELD(Float64, value);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+// Peak resident set size of the process in KB (Linux), never decreases
+v_int64 getPeakRss() {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+v_int64 readAll(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+  OATPP_ASSERT(result->isSuccess());
+  v_int64 count = 0;
+  while (result->hasMoreToFetch()) {
+    auto rows = result->fetch<oatpp::Vector<oatpp::Object<RowDto>>>(WINDOW_SIZE);
+    count += rows->size();
+  }
+  return count;
+}
+
+}
+
+void StreamingMemoryBenchmark::onRun() {
+
+  OATPP_LOGI(TAG, "Benchmark started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto connection = executor->getConnection();
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_streaming_memory", connection);
+  executor->executeRaw("CREATE TABLE test_streaming_memory (id INT PRIMARY KEY, name VARCHAR(64), value DOUBLE)", connection);
+  executor->executeRaw("INSERT INTO test_streaming_memory SELECT seq, CONCAT('name_of_row_', seq), seq / 3 FROM seq_1_to_" +
+                       std::to_string(ROW_COUNT), connection);
+
+  auto query = executor->parseQueryTemplate("selectAll", "SELECT id, name, value FROM test_streaming_memory", {}, true);
+
+  // Peak RSS only grows - measure the streamed read first so the buffered one can't hide it
+  v_int64 baseline = getPeakRss();
+
+  v_int64 streamedPeak;
+  {
+    oatpp::test::PerformanceChecker checker("Streamed read of 1M rows");
+    auto result = executor->executeStreaming(query, {}, nullptr, connection);
+    OATPP_ASSERT(std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object)->isBusy());
+    OATPP_ASSERT(readAll(result) == ROW_COUNT);
+    OATPP_ASSERT(!std::static_pointer_cast<oatpp::mariadb::Connection>(connection.object)->isBusy());
+    streamedPeak = getPeakRss();
+  }
+
+  v_int64 bufferedPeak;
+  {
+    oatpp::test::PerformanceChecker checker("Buffered read of 1M rows");
+    auto result = executor->execute(query, {}, nullptr, connection);
+    OATPP_ASSERT(readAll(result) == ROW_COUNT);
+    bufferedPeak = getPeakRss();
+  }
+
+  OATPP_LOGI(TAG, "Peak RSS growth: streamed=%lld KB, buffered=%lld KB",
+             streamedPeak - baseline, bufferedPeak - baseline);
+  OATPP_ASSERT(streamedPeak - baseline < bufferedPeak - baseline);
+
+  // A discarded stream is drained and the connection is usable again
+  {
+    {
+      auto result = executor->executeStreaming(query, {}, nullptr, connection);
+      auto rows = result->fetch<oatpp::Vector<oatpp::Object<RowDto>>>(10);
+      OATPP_ASSERT(rows->size() == 10);
+
+      bool thrown = false;
+      try {
+        executor->executeRaw("SELECT 1", connection);
+      } catch (const std::runtime_error&) {
+        thrown = true;
+      }
+      OATPP_ASSERT(thrown);
+    }
+    auto result = executor->executeRaw("SELECT COUNT(*) AS id FROM test_streaming_memory", connection);
+    OATPP_ASSERT(result->fetch<oatpp::Vector<oatpp::Object<RowDto>>>()[0]->id == ROW_COUNT);
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_streaming_memory", connection);
+
+  OATPP_LOGI(TAG, "Benchmark finished");
+
+}
+
+}}}}
@@ -0,0 +1,20 @@
+#ifndef oatpp_test_mariadb_benchmark_StreamingMemoryBenchmark_hpp
+#define oatpp_test_mariadb_benchmark_StreamingMemoryBenchmark_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace benchmark {
+
+/**
+ * Peak RSS of reading a 1M-row table buffered (`mysql_stmt_store_result`) vs. unbuffered
+ * (&id:oatpp::mariadb::Executor::executeStreaming;). Rows are fetched in windows and dropped right away.
+ */
+class StreamingMemoryBenchmark : public oatpp::test::UnitTest {
+public:
+  StreamingMemoryBenchmark() : UnitTest("TEST[mariadb::benchmark::StreamingMemoryBenchmark]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_benchmark_StreamingMemoryBenchmark_hpp
@@ -0,0 +1,92 @@
+#include "HistogramTest.hpp"
+
+#include "oatpp-mariadb/dto/Metrics.hpp"
+#include "oatpp-mariadb/metrics/Histogram.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace mariadb { namespace metrics {
+
+namespace {
+
+typedef oatpp::mariadb::metrics::Histogram Histogram;
+const char* const TAG = "TEST[mariadb::metrics::HistogramTest]";
+
+}
+
+void HistogramTest::onRun() {
+
+  // every value falls into a bucket whose bounds hold it, buckets are ordered
+  {
+    for (v_uint64 value = 0; value < 100000; value++) {
+      v_int32 index = Histogram::getBucketIndex(value);
+      OATPP_ASSERT(index >= 0 && index < Histogram::BUCKET_COUNT);
+      OATPP_ASSERT(value <= Histogram::getBucketUpperBound(index));
+      OATPP_ASSERT(index == 0 || value > Histogram::getBucketUpperBound(index - 1));
+    }
+    OATPP_ASSERT(Histogram::getBucketIndex(7) == 7);
+    OATPP_ASSERT(Histogram::getBucketIndex(100) == 36);
+    OATPP_ASSERT(Histogram::getBucketUpperBound(36) == 103);
+    OATPP_ASSERT(Histogram::getBucketIndex(~v_uint64(0)) == Histogram::BUCKET_COUNT - 1);
+  }
+
+  // percentiles within the bucket precision
+  {
+    Histogram histogram;
+    OATPP_ASSERT(histogram.getSnapshot().getPercentile(0.99) == 0);
+    for (v_uint64 value = 1; value <= 1000; value++) {
+      histogram.record(value);
+    }
+    auto snapshot = histogram.getSnapshot();
+    OATPP_LOGD(TAG, "mean=%f p50=%lu p99=%lu", snapshot.getMean(),
+               (unsigned long) snapshot.getPercentile(0.5), (unsigned long) snapshot.getPercentile(0.99));
+    OATPP_ASSERT(snapshot.count == 1000);
+    OATPP_ASSERT(snapshot.max == 1000);
+    OATPP_ASSERT(snapshot.getMean() == 500.5);
+    OATPP_ASSERT(snapshot.getPercentile(0.5) >= 500 && snapshot.getPercentile(0.5) <= 500 * 9 / 8);
+    OATPP_ASSERT(snapshot.getPercentile(0.99) >= 990 && snapshot.getPercentile(0.99) <= 1000);
+    OATPP_ASSERT(snapshot.getPercentile(1.0) == 1000);
+
+    histogram.reset();
+    OATPP_ASSERT(histogram.getSnapshot().count == 0);
+
+    auto merged = snapshot;
+    merged.merge(snapshot);
+    OATPP_ASSERT(merged.count == 2000);
+    OATPP_ASSERT(merged.getPercentile(0.5) == snapshot.getPercentile(0.5));
+  }
+
+  // concurrent recording loses nothing
+  {
+    Histogram histogram;
+    std::vector<std::thread> threads;
+    for (v_int32 t = 0; t < 8; t++) {
+      threads.emplace_back([&histogram, t] {
+        for (v_uint64 i = 0; i < 10000; i++) {
+          histogram.record(i * (t + 1));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    auto snapshot = histogram.getSnapshot();
+    OATPP_ASSERT(snapshot.count == 80000);
+    OATPP_ASSERT(snapshot.max == 9999 * 8);
+  }
+
+  // DTO
+  {
+    Histogram histogram;
+    histogram.record(10);
+    histogram.record(20);
+    auto dto = oatpp::mariadb::dto::HistogramDto::fromSnapshot(histogram.getSnapshot());
+    OATPP_ASSERT(dto->count == 2);
+    OATPP_ASSERT(dto->mean == 15.0);
+    OATPP_ASSERT(dto->max == 20);
+  }
+
+}
+
+}}}}
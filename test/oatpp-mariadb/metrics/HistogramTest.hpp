@@ -0,0 +1,16 @@
+#ifndef oatpp_test_mariadb_metrics_HistogramTest_hpp
+#define oatpp_test_mariadb_metrics_HistogramTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace metrics {
+
+class HistogramTest : public UnitTest {
+public:
+  HistogramTest() : UnitTest("TEST[mariadb::metrics::HistogramTest]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_metrics_HistogramTest_hpp
@@ -0,0 +1,93 @@
+#include "QueryMetricsTest.hpp"
+
+#include "oatpp-mariadb/dto/Metrics.hpp"
+#include "oatpp-mariadb/metrics/QueryMetrics.hpp"
+
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace test { namespace mariadb { namespace metrics {
+
+namespace {
+
+typedef oatpp::mariadb::metrics::QueryMetrics QueryMetrics;
+typedef oatpp::mariadb::metrics::TemplateMetrics TemplateMetrics;
+const char* const TAG = "TEST[mariadb::metrics::QueryMetricsTest]";
+
+}
+
+void QueryMetricsTest::onRun() {
+
+  // shard count is rounded up to a power of two and capped
+  {
+    QueryMetrics::Config config;
+    config.shardCount = 3;
+    OATPP_ASSERT(QueryMetrics(config).getShardCount() == 4);
+    config.shardCount = 1000;
+    OATPP_ASSERT(QueryMetrics(config).getShardCount() == QueryMetrics::MAX_SHARDS);
+    OATPP_ASSERT(QueryMetrics().getShardCount() >= 1);
+  }
+
+  // one object per template name, phases recorded separately
+  {
+    QueryMetrics queryMetrics;
+    auto selectUser = queryMetrics.getTemplate("selectUser");
+    OATPP_ASSERT(queryMetrics.getTemplate("selectUser") == selectUser);
+    OATPP_ASSERT(queryMetrics.getTemplate("insertUser") != selectUser);
+
+    selectUser->record(TemplateMetrics::Phase::EXECUTE, std::chrono::microseconds(100));
+    selectUser->record(TemplateMetrics::Phase::EXECUTE, std::chrono::microseconds(300));
+    selectUser->record(TemplateMetrics::Phase::MAPPING, std::chrono::microseconds(20));
+
+    auto snapshot = selectUser->getSnapshot();
+    OATPP_ASSERT(snapshot.templateName == "selectUser");
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::EXECUTE).count == 2);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::EXECUTE).max == 300);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::EXECUTE).getMean() == 200.0);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::MAPPING).count == 1);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::ACQUIRE).count == 0);
+
+    auto snapshots = queryMetrics.getSnapshot();
+    OATPP_ASSERT(snapshots.size() == 2);
+
+    auto dto = oatpp::mariadb::dto::TemplateMetricsDto::fromSnapshot(snapshot);
+    OATPP_ASSERT(dto->templateName == "selectUser");
+    OATPP_ASSERT(dto->phases->size() == TemplateMetrics::PHASE_COUNT);
+    OATPP_ASSERT(dto->phases[TemplateMetrics::getPhaseName(TemplateMetrics::Phase::EXECUTE)]->count == 2);
+
+    queryMetrics.reset();
+    OATPP_ASSERT(selectUser->getSnapshot().get(TemplateMetrics::Phase::EXECUTE).count == 0);
+  }
+
+  // threads record into their own shards, nothing is lost
+  {
+    QueryMetrics::Config config;
+    config.shardCount = 4;
+    QueryMetrics queryMetrics(config);
+    auto metrics = queryMetrics.getTemplate("selectUser");
+
+    std::vector<std::thread> threads;
+    for (v_int32 t = 0; t < 8; t++) {
+      threads.emplace_back([metrics, t] {
+        for (v_int64 i = 0; i < 10000; i++) {
+          metrics->record(TemplateMetrics::Phase::EXECUTE, std::chrono::microseconds(i * (t + 1)));
+          metrics->record(TemplateMetrics::Phase::BIND, std::chrono::microseconds(1));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    auto snapshot = metrics->getSnapshot();
+    OATPP_LOGD(TAG, "execute p50=%lu p99=%lu", (unsigned long) snapshot.get(TemplateMetrics::Phase::EXECUTE).getPercentile(0.5),
+               (unsigned long) snapshot.get(TemplateMetrics::Phase::EXECUTE).getPercentile(0.99));
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::EXECUTE).count == 80000);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::EXECUTE).max == 9999 * 8);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::BIND).count == 80000);
+    OATPP_ASSERT(snapshot.get(TemplateMetrics::Phase::BIND).sum == 80000);
+  }
+
+}
+
+}}}}
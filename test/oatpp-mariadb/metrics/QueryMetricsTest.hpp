@@ -0,0 +1,16 @@
+#ifndef oatpp_test_mariadb_metrics_QueryMetricsTest_hpp
+#define oatpp_test_mariadb_metrics_QueryMetricsTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace metrics {
+
+class QueryMetricsTest : public UnitTest {
+public:
+  QueryMetricsTest() : UnitTest("TEST[mariadb::metrics::QueryMetricsTest]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_metrics_QueryMetricsTest_hpp
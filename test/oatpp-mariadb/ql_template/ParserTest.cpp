@@ -77,6 +77,96 @@ void ParserTest::onRun() {
     OATPP_ASSERT(vars[1].name == "name");
   }
 
+  {
+    // CASE 4: find the row of a single-row insert and expand it
+    oatpp::String text = "INSERT INTO t (a, b) VALUES (?, CONCAT(?, ')'));";
+    v_buff_size start, end;
+
+    OATPP_LOGD(TAG, "--- case4 INSERT ... VALUES ---");
+    OATPP_LOGD(TAG, "sql='%s'", text->c_str());
+
+    OATPP_ASSERT(Parser::findInsertValues(text, start, end));
+    OATPP_ASSERT(start == 28);
+    OATPP_ASSERT(end == 47);
+
+    auto expanded = Parser::expandInsertValues(text, start, end, 3);
+    OATPP_LOGD(TAG, "expanded='%s'", expanded->c_str());
+    OATPP_ASSERT(expanded == "INSERT INTO t (a, b) VALUES (?, CONCAT(?, ')')),(?, CONCAT(?, ')')),(?, CONCAT(?, ')'));");
+
+    OATPP_ASSERT(!Parser::findInsertValues("SELECT * FROM t WHERE a = ?;", start, end));
+    OATPP_ASSERT(!Parser::findInsertValues("INSERT INTO t (a) VALUES (?), (?);", start, end));
+    OATPP_ASSERT(!Parser::findInsertValues("INSERT INTO t (a) VALUES (?) ON DUPLICATE KEY UPDATE a = ?;", start, end));
+    OATPP_ASSERT(!Parser::findInsertValues("INSERT INTO t (a) SELECT a FROM s WHERE b = ?;", start, end));
+    OATPP_ASSERT(Parser::findInsertValues("insert into t (a) values (?) on duplicate key update a = values(a);", start, end));
+  }
+
+  {
+    // CASE 5: split variable names into parameter name and property path
+    OATPP_LOGD(TAG, "--- case5 parameters ---");
+
+    auto simple = Parser::parseParameter("id");
+    OATPP_ASSERT(simple.name == "id");
+    OATPP_ASSERT(simple.propertyPath.empty());
+
+    auto nested = Parser::parseParameter("user.name.first");
+    OATPP_ASSERT(nested.name == "user");
+    OATPP_ASSERT(nested.propertyPath.size() == 2);
+    OATPP_ASSERT(nested.propertyPath[0] == "name");
+    OATPP_ASSERT(nested.propertyPath[1] == "first");
+    OATPP_ASSERT(nested.propertyChain == nullptr);
+  }
+
+  {
+    // CASE 6: tables read and written by a statement
+    OATPP_LOGD(TAG, "--- case6 tables ---");
+
+    std::vector<std::string> tables;
+
+    OATPP_ASSERT(!Parser::findTables("SELECT * FROM a JOIN `db`.`B` ON a.x = B.y WHERE id IN (SELECT id FROM c);", tables));
+    OATPP_ASSERT((tables == std::vector<std::string>{"a", "b", "c"}));
+
+    OATPP_ASSERT(!Parser::findTables("SELECT x.a FROM x, y z, w WHERE q = 'FROM k';", tables));
+    OATPP_ASSERT((tables == std::vector<std::string>{"x", "y", "w"}));
+
+    OATPP_ASSERT(Parser::findTables("INSERT t VALUES (?);", tables));
+    OATPP_ASSERT((tables == std::vector<std::string>{"t"}));
+
+    OATPP_ASSERT(Parser::findTables("INSERT IGNORE INTO `s`.`T2` (x) SELECT x FROM src;", tables));
+    OATPP_ASSERT((tables == std::vector<std::string>{"t2", "src"}));
+
+    OATPP_ASSERT(Parser::findTables("UPDATE LOW_PRIORITY t1 x, t2 SET x.a = ?;", tables));
+    OATPP_ASSERT((tables == std::vector<std::string>{"t1", "t2"}));
+
+    OATPP_ASSERT(Parser::findTables("/* purge */ DELETE FROM t3 WHERE a = ?;", tables));
+    OATPP_ASSERT((tables == std::vector<std::string>{"t3"}));
+
+    OATPP_ASSERT(Parser::findTables("DROP TABLE x;", tables));
+    OATPP_ASSERT(tables.empty());
+
+    OATPP_ASSERT(!Parser::findTables("SELECT 1;", tables));
+    OATPP_ASSERT(tables.empty());
+
+    OATPP_ASSERT(Parser::findTables("SELECT * FROM a WHERE b = ';'; /* then */ DELETE FROM t", tables));
+    OATPP_ASSERT((tables == std::vector<std::string>{"a", "t"}));
+
+    OATPP_ASSERT(Parser::findTables("SELECT * FROM a; TRUNCATE t", tables));
+    OATPP_ASSERT(tables.empty());
+  }
+
+  {
+    // CASE 7: read-only statements
+    OATPP_LOGD(TAG, "--- case7 read-only ---");
+
+    OATPP_ASSERT(Parser::isReadOnly("SELECT * FROM a WHERE name = 'INSERT INTO' AND id = ?;"));
+    OATPP_ASSERT(Parser::isReadOnly("  -- list\nWITH c AS (SELECT id FROM a) SELECT @@version, id FROM c;"));
+    OATPP_ASSERT(!Parser::isReadOnly("SELECT * FROM a WHERE id = ? FOR UPDATE;"));
+    OATPP_ASSERT(!Parser::isReadOnly("SELECT * FROM a LOCK IN SHARE MODE;"));
+    OATPP_ASSERT(!Parser::isReadOnly("SELECT id INTO @id FROM a;"));
+    OATPP_ASSERT(!Parser::isReadOnly("SELECT LAST_INSERT_ID();"));
+    OATPP_ASSERT(!Parser::isReadOnly("INSERT INTO a SELECT * FROM b;"));
+    OATPP_ASSERT(!Parser::isReadOnly("SET @x = 1;"));
+  }
+
 }
 
 }}}}
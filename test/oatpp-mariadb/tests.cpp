@@ -7,6 +7,8 @@
 #include "oatpp/core/base/Environment.hpp"
 
 #include "oatpp-mariadb/ql_template/ParserTest.hpp"
+#include "oatpp-mariadb/metrics/HistogramTest.hpp"
+#include "oatpp-mariadb/metrics/QueryMetricsTest.hpp"
 #include "oatpp-mariadb/types/NumericTest.hpp"
 #include "oatpp-mariadb/types/Int64Test.hpp"
 #include "oatpp-mariadb/types/Float64Test.hpp"
@@ -27,6 +29,20 @@
 #include "oatpp-mariadb/types/AnyTypeTest.hpp"
 #include "oatpp-mariadb/migration/SchemaVersionTest.hpp"
 #include "oatpp-mariadb/QueryResultTest.hpp"
+#include "oatpp-mariadb/StatementCacheTest.hpp"
+#include "oatpp-mariadb/ConnectionHealthTest.hpp"
+#include "oatpp-mariadb/ConnectionPoolTest.hpp"
+#include "oatpp-mariadb/SessionResetTest.hpp"
+#include "oatpp-mariadb/ExecuteBatchTest.hpp"
+#include "oatpp-mariadb/MultiResultSetTest.hpp"
+#include "oatpp-mariadb/AsyncExecuteTest.hpp"
+#include "oatpp-mariadb/RawQueryTest.hpp"
+#include "oatpp-mariadb/CursorTest.hpp"
+#include "oatpp-mariadb/MappingPlanTest.hpp"
+#include "oatpp-mariadb/ColumnarTest.hpp"
+#include "oatpp-mariadb/JsonStreamTest.hpp"
+#include "oatpp-mariadb/ResultCacheTest.hpp"
+#include "oatpp-mariadb/RoutingExecutorTest.hpp"
 #include "oatpp-mariadb/transaction/TransactionTest.hpp"
 #include "oatpp-mariadb/crud/CrudTest.hpp"
 #include "oatpp-mariadb/crud/ProductCrudTest.hpp"
@@ -36,6 +52,13 @@
 #include "oatpp-mariadb/types/MariaDBTypeWrapperTest.hpp"
 #include "oatpp-mariadb/types/StatusTest.hpp"
 #include "oatpp-mariadb/types/FlagTest.hpp"
+#include "oatpp-mariadb/types/LongDataTest.hpp"
+#include "oatpp-mariadb/types/LargeValueTest.hpp"
+#include "oatpp-mariadb/benchmark/RoundTripBenchmark.hpp"
+#include "oatpp-mariadb/benchmark/BindContextBenchmark.hpp"
+#include "oatpp-mariadb/benchmark/StreamingMemoryBenchmark.hpp"
+#include "oatpp-mariadb/benchmark/RowDecoderBenchmark.hpp"
+#include "oatpp-mariadb/benchmark/ConnectBenchmark.hpp"
 
 /*
 #include "oatpp-mariadb/tests/BulkTest.hpp"
@@ -49,6 +72,8 @@ namespace {
 void runTests() {
   
   //OATPP_RUN_TEST(oatpp::test::mariadb::ql_template::ParserTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::metrics::HistogramTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::metrics::QueryMetricsTest);
   //OATPP_RUN_TEST(oatpp::test::mariadb::types::NumericTest);
   //OATPP_RUN_TEST(oatpp::test::mariadb::types::Int64Test);
   //OATPP_RUN_TEST(oatpp::test::mariadb::types::Float64Test);
@@ -69,6 +94,20 @@ void runTests() {
   //OATPP_RUN_TEST(oatpp::test::mariadb::types::AnyTypeTest);
   //OATPP_RUN_TEST(oatpp::test::mariadb::migration::SchemaVersionTest);
   //OATPP_RUN_TEST(oatpp::test::mariadb::QueryResultTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::StatementCacheTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::ConnectionHealthTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::ConnectionPoolTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::SessionResetTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::ExecuteBatchTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::MultiResultSetTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::AsyncExecuteTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::RawQueryTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::CursorTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::MappingPlanTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::ColumnarTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::JsonStreamTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::ResultCacheTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::RoutingExecutorTest);
   //OATPP_RUN_TEST(oatpp::test::mariadb::transaction::TransactionTest);
   //OATPP_RUN_TEST(oatpp::test::mariadb::crud::CrudTest);
   //OATPP_RUN_TEST(oatpp::test::mariadb::crud::ProductCrudTest);
@@ -78,6 +117,13 @@ void runTests() {
   //OATPP_RUN_TEST(oatpp::test::mariadb::types::TypeWrapperTest);
   //OATPP_RUN_TEST(oatpp::test::mariadb::types::StatusTest);
   OATPP_RUN_TEST(oatpp::test::mariadb::types::FlagTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::types::LongDataTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::types::LargeValueTest);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::benchmark::RoundTripBenchmark);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::benchmark::BindContextBenchmark);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::benchmark::StreamingMemoryBenchmark);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::benchmark::RowDecoderBenchmark);
+  //OATPP_RUN_TEST(oatpp::test::mariadb::benchmark::ConnectBenchmark);
   /*
   OATPP_RUN_TEST(oatpp::test::mariadb::BulkTest);
   OATPP_RUN_TEST(oatpp::test::mariadb::ParamsTest);
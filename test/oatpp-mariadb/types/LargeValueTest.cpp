@@ -0,0 +1,129 @@
+#include "LargeValueTest.hpp"
+#include "../utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace types {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::types::LargeValueTest]";
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class DocumentDto : public oatpp::DTO {
+  DTO_INIT(DocumentDto, DTO);
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, title);
+  DTO_FIELD(String, body);
+  DTO_FIELD(String, data);
+};
+
+class BodyDto : public oatpp::DTO {
+  DTO_INIT(BodyDto, DTO);
+  DTO_FIELD(String, body);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(insertDocument,
+        "INSERT INTO test_large_value (id, title, body, data) VALUES (:id, :title, :body, :data);",
+        PARAM(oatpp::Int32, id),
+        PARAM(oatpp::String, title),
+        PARAM(oatpp::String, body),
+        PARAM(oatpp::String, data))
+
+  QUERY(selectAll,
+        "SELECT id, title, body, data FROM test_large_value ORDER BY id;")
+
+  QUERY(insertReturning,
+        "INSERT INTO test_large_value (id, title, body, data) VALUES (:id, :title, :body, :data) RETURNING body;",
+        PARAM(oatpp::Int32, id),
+        PARAM(oatpp::String, title),
+        PARAM(oatpp::String, body),
+        PARAM(oatpp::String, data))
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+oatpp::String makeValue(v_buff_size size, char first) {
+  std::string value(size, ' ');
+  for (v_buff_size i = 0; i < size; i++) {
+    value[i] = static_cast<char>(first + i % 26);
+  }
+  return value;
+}
+
+}
+
+void LargeValueTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto client = TestClient(executor);
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_large_value");
+  executor->executeRaw("CREATE TABLE test_large_value (id INT PRIMARY KEY, title VARCHAR(1000), body LONGTEXT, data LONGBLOB)");
+
+  // Values around and far above the initial column buffer size, a short one after the long ones
+  const v_buff_size sizes[] = {0, 10, 256, 257, 70000, 1024 * 1024, 5};
+  const v_int32 count = sizeof(sizes) / sizeof(sizes[0]);
+
+  for (v_int32 i = 0; i < count; i++) {
+    auto size = sizes[i];
+    auto result = client.insertDocument(i, makeValue(size % 1000, 'a'), makeValue(size, 'A'), makeValue(size, 'a'));
+    OATPP_ASSERT(result->isSuccess());
+  }
+
+  {
+    auto result = client.selectAll();
+    OATPP_ASSERT(result->isSuccess());
+    auto documents = result->fetch<oatpp::Vector<oatpp::Object<DocumentDto>>>();
+    OATPP_ASSERT(documents->size() == count);
+    for (v_int32 i = 0; i < count; i++) {
+      auto size = sizes[i];
+      OATPP_ASSERT(documents[i]->id == i);
+      OATPP_ASSERT(documents[i]->title == makeValue(size % 1000, 'a'));
+      OATPP_ASSERT(documents[i]->body == makeValue(size, 'A'));
+      OATPP_ASSERT(documents[i]->data == makeValue(size, 'a'));
+    }
+  }
+
+  // RETURNING binds its own buffers
+  {
+    auto result = client.insertReturning(count, "returning", makeValue(70000, 'A'), nullptr);
+    OATPP_ASSERT(result->isSuccess());
+    auto rows = result->fetch<oatpp::Vector<oatpp::Object<BodyDto>>>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0]->body == makeValue(70000, 'A'));
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_large_value");
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}}
@@ -0,0 +1,16 @@
+#ifndef oatpp_test_mariadb_types_LargeValueTest_hpp
+#define oatpp_test_mariadb_types_LargeValueTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace types {
+
+class LargeValueTest : public oatpp::test::UnitTest {
+public:
+  LargeValueTest() : UnitTest("TEST[mariadb::types::LargeValueTest]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_types_LargeValueTest_hpp
@@ -0,0 +1,137 @@
+#include "LongDataTest.hpp"
+#include "../utils/EnvLoader.hpp"
+
+#include "oatpp-mariadb/orm.hpp"
+#include "oatpp-mariadb/types/LongData.hpp"
+#include "oatpp/core/data/stream/BufferStream.hpp"
+#include "oatpp/core/Types.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace types {
+
+namespace {
+
+const char* const TAG = "TEST[mariadb::types::LongDataTest]";
+
+constexpr v_buff_size DATA_SIZE = 12 * 1024 * 1024;
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class InfoDto : public oatpp::DTO {
+  DTO_INIT(InfoDto, DTO);
+  DTO_FIELD(Int64, dataLength);
+  DTO_FIELD(Int64, textLength);
+  DTO_FIELD(String, dataTail);
+  DTO_FIELD(String, textHead);
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class TestClient : public oatpp::orm::DbClient {
+public:
+  TestClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+  }
+
+  QUERY(insertDocument,
+        "INSERT INTO test_long_data (id, data, text) VALUES (:id, :data, :text);",
+        PARAM(oatpp::Int32, id),
+        PARAM(oatpp::mariadb::types::LongData, data),
+        PARAM(oatpp::mariadb::types::LongData, text))
+
+  QUERY(selectInfo,
+        "SELECT LENGTH(data) AS dataLength, CHAR_LENGTH(text) AS textLength, "
+        "RIGHT(data, 8) AS dataTail, LEFT(text, 8) AS textHead FROM test_long_data WHERE id = :id;",
+        PARAM(oatpp::Int32, id))
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+oatpp::String makeData(v_buff_size size, char first) {
+  std::string data(size, ' ');
+  for (v_buff_size i = 0; i < size; i++) {
+    data[i] = static_cast<char>(first + i % 26);
+  }
+  return data;
+}
+
+}
+
+void LongDataTest::onRun() {
+
+  OATPP_LOGI(TAG, "Test started");
+
+  auto env = oatpp::test::mariadb::utils::EnvLoader();
+
+  auto options = oatpp::mariadb::ConnectionOptions();
+  options.host = env.get("MARIADB_HOST", "127.0.0.1");
+  options.port = env.getInt("MARIADB_PORT", 3306);
+  options.username = env.get("MARIADB_USER", "root");
+  options.password = env.get("MARIADB_PASSWORD", "root");
+  options.database = env.get("MARIADB_DATABASE", "test");
+
+  auto connectionProvider = std::make_shared<oatpp::mariadb::ConnectionProvider>(options);
+  auto executor = std::make_shared<oatpp::mariadb::Executor>(connectionProvider);
+  auto client = TestClient(executor);
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_long_data");
+  executor->executeRaw("CREATE TABLE test_long_data (id INT PRIMARY KEY, data LONGBLOB, text LONGTEXT)");
+
+  auto data = makeData(DATA_SIZE, 'a');
+  auto text = makeData(DATA_SIZE / 2, 'A');
+
+  // from input streams, in 64KB chunks
+  {
+    auto dataStream = std::make_shared<oatpp::data::stream::BufferInputStream>(data);
+    auto textStream = std::make_shared<oatpp::data::stream::BufferInputStream>(text);
+    auto result = client.insertDocument(1,
+      oatpp::mariadb::types::LongData(std::make_shared<oatpp::mariadb::types::LongDataObject>(dataStream)),
+      oatpp::mariadb::types::LongData(std::make_shared<oatpp::mariadb::types::LongDataObject>(textStream, false)));
+    OATPP_ASSERT(result->isSuccess());
+  }
+
+  // from strings, sent from their own buffers
+  {
+    auto result = client.insertDocument(2,
+      oatpp::mariadb::types::LongData(std::make_shared<oatpp::mariadb::types::LongDataObject>(data, true, 1024 * 1024)),
+      oatpp::mariadb::types::LongData(std::make_shared<oatpp::mariadb::types::LongDataObject>(text, false)));
+    OATPP_ASSERT(result->isSuccess());
+  }
+
+  // null and empty values
+  {
+    auto result = client.insertDocument(3,
+      nullptr,
+      oatpp::mariadb::types::LongData(std::make_shared<oatpp::mariadb::types::LongDataObject>(oatpp::String(""), false)));
+    OATPP_ASSERT(result->isSuccess());
+  }
+
+  for (v_int32 id = 1; id <= 2; id++) {
+    auto result = client.selectInfo(id);
+    OATPP_ASSERT(result->isSuccess());
+    auto info = result->fetch<oatpp::Vector<oatpp::Object<InfoDto>>>();
+    OATPP_ASSERT(info->size() == 1);
+    OATPP_ASSERT(info[0]->dataLength == DATA_SIZE);
+    OATPP_ASSERT(info[0]->textLength == DATA_SIZE / 2);
+    OATPP_ASSERT(info[0]->dataTail == oatpp::String(data->substr(DATA_SIZE - 8)));
+    OATPP_ASSERT(info[0]->textHead == oatpp::String(text->substr(0, 8)));
+  }
+
+  {
+    auto result = client.selectInfo(3);
+    auto info = result->fetch<oatpp::Vector<oatpp::Object<InfoDto>>>();
+    OATPP_ASSERT(info->size() == 1);
+    OATPP_ASSERT(info[0]->dataLength == nullptr);
+    OATPP_ASSERT(info[0]->textLength == 0);
+  }
+
+  executor->executeRaw("DROP TABLE IF EXISTS test_long_data");
+
+  OATPP_LOGI(TAG, "Test finished");
+
+}
+
+}}}}
@@ -0,0 +1,16 @@
+#ifndef oatpp_test_mariadb_types_LongDataTest_hpp
+#define oatpp_test_mariadb_types_LongDataTest_hpp
+
+#include "oatpp-test/UnitTest.hpp"
+
+namespace oatpp { namespace test { namespace mariadb { namespace types {
+
+class LongDataTest : public oatpp::test::UnitTest {
+public:
+  LongDataTest() : UnitTest("TEST[mariadb::types::LongDataTest]") {}
+  void onRun() override;
+};
+
+}}}}
+
+#endif // oatpp_test_mariadb_types_LongDataTest_hpp
@@ -0,0 +1,39 @@
+#ifndef oatpp_test_mariadb_utils_RoundTrips_hpp
+#define oatpp_test_mariadb_utils_RoundTrips_hpp
+
+#include "oatpp/core/Types.hpp"
+
+#include <mysql/mysql.h>
+#include <string>
+
+namespace oatpp { namespace test { namespace mariadb { namespace utils {
+
+/**
+ * Count commands sent on this session which wait for a server response. <br>
+ * `Questions` covers text queries and `COM_STMT_EXECUTE` but not `COM_STMT_PREPARE` and `COM_STMT_RESET`,
+ * so their `Com_stmt_*` counters are added. `COM_STMT_CLOSE` gets no response and is not counted.
+ * The `SHOW STATUS` query made here is counted as well - subtract 1 from the difference of two calls.
+ * @param mysql
+ * @return - `-1` on error.
+ */
+inline v_int64 countRoundTrips(MYSQL* mysql) {
+  if (mysql_query(mysql, "SHOW SESSION STATUS WHERE Variable_name IN ('Questions', 'Com_stmt_prepare', 'Com_stmt_reset')") != 0) {
+    return -1;
+  }
+  MYSQL_RES* res = mysql_store_result(mysql);
+  if (!res) {
+    return -1;
+  }
+  v_int64 result = 0;
+  while (MYSQL_ROW row = mysql_fetch_row(res)) {
+    if (row[1]) {
+      result += std::stoll(row[1]);
+    }
+  }
+  mysql_free_result(res);
+  return result;
+}
+
+}}}}
+
+#endif // oatpp_test_mariadb_utils_RoundTrips_hpp